@@ -0,0 +1,477 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterBenchmarkGameMode.h"
+#include "MCPShooterEnemy.h"
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
+#include "MCPShooterBulletSystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+AMCPShooterBenchmarkGameMode::AMCPShooterBenchmarkGameMode()
+    : ProjectilesPerEnemy(2)
+    , SpawnBoxCenter(2500.0f, 0.0f, 0.0f)
+    , SpawnBoxExtent(1500.0f, 2000.0f, 600.0f)
+    , WarmupSeconds(3.0f)
+    , StageDurationSeconds(20.0f)
+    , MaxEnemySpawnsPerFrame(50)
+    , MaxProjectileSpawnsPerFrame(200)
+    , StageIndex(INDEX_NONE)
+    , StageElapsedSeconds(0.0)
+    , LastFrameTime(0.0)
+    , bFinished(false)
+    , ActiveEnemySum(0)
+    , ActiveProjectileSum(0)
+{
+    // 既定の段階（敵100/500/2,000体、弾丸はその2倍）
+    for (const int32 EnemyCount : { 100, 500, 2000 })
+    {
+        FMCPShooterBenchmarkStage& Stage = Stages.AddDefaulted_GetRef();
+        Stage.EnemyCount = EnemyCount;
+        Stage.ProjectileCount = EnemyCount * ProjectilesPerEnemy;
+    }
+}
+
+void AMCPShooterBenchmarkGameMode::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ApplyCommandLineOverrides();
+
+    // 通常のタイマーによるスポーンは使わず、段階ごとに決まった数を維持する
+    GetWorldTimerManager().ClearAllTimersForObject(this);
+
+    SpawnStream.Initialize(RandomSeed);
+
+    UE_LOG(LogTemp, Log, TEXT("シューティングベンチマークを開始します: %d段階、各%.1f秒、シード %d"),
+           Stages.Num(), StageDurationSeconds, RandomSeed);
+
+    BeginStage(0);
+}
+
+void AMCPShooterBenchmarkGameMode::ApplyCommandLineOverrides()
+{
+    // URLオプションを優先し、なければコマンドラインから読む
+    auto GetSetting = [this](const TCHAR* Key, FString& OutValue)
+    {
+        if (UGameplayStatics::HasOption(OptionsString, Key))
+        {
+            OutValue = UGameplayStatics::ParseOption(OptionsString, Key);
+            return true;
+        }
+        return FParse::Value(FCommandLine::Get(), *FString::Printf(TEXT("%s="), Key), OutValue, false);
+    };
+
+    FString LevelsString;
+    if (GetSetting(TEXT("MCPBenchmarkLevels"), LevelsString))
+    {
+        TArray<FString> Levels;
+        LevelsString.ParseIntoArray(Levels, TEXT(","));
+
+        TArray<FMCPShooterBenchmarkStage> NewStages;
+        for (const FString& Level : Levels)
+        {
+            const int32 EnemyCount = FCString::Atoi(*Level);
+            if (EnemyCount > 0)
+            {
+                FMCPShooterBenchmarkStage& Stage = NewStages.AddDefaulted_GetRef();
+                Stage.EnemyCount = EnemyCount;
+                Stage.ProjectileCount = EnemyCount * ProjectilesPerEnemy;
+            }
+        }
+
+        if (NewStages.Num() > 0)
+        {
+            Stages = MoveTemp(NewStages);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ベンチマークの段階の指定が不正です: %s"), *LevelsString);
+        }
+    }
+
+    FString Value;
+    if (GetSetting(TEXT("MCPBenchmarkDuration"), Value))
+    {
+        StageDurationSeconds = FCString::Atof(*Value);
+    }
+    if (GetSetting(TEXT("MCPBenchmarkSeed"), Value))
+    {
+        RandomSeed = FCString::Atoi(*Value);
+    }
+    GetSetting(TEXT("MCPBenchmarkOutput"), OutputPath);
+}
+
+void AMCPShooterBenchmarkGameMode::GameOver()
+{
+    // 負荷を一定に保つため、プレイヤーが倒されても計測を続ける
+    UE_LOG(LogTemp, Verbose, TEXT("ベンチマーク中のためゲームオーバーを無視しました"));
+}
+
+void AMCPShooterBenchmarkGameMode::BeginStage(int32 NewStageIndex)
+{
+    StageIndex = NewStageIndex;
+    StageElapsedSeconds = 0.0;
+    LastFrameTime = FPlatformTime::Seconds();
+    ActiveEnemySum = 0;
+    ActiveProjectileSum = 0;
+
+    const FMCPShooterBenchmarkStage& Stage = Stages[StageIndex];
+    const int32 ExpectedFrames = FMath::CeilToInt(StageDurationSeconds * 120.0f);
+    FrameTimesMs.Reset(ExpectedFrames);
+    GameThreadTimesMs.Reset(ExpectedFrames);
+    SpawnTimesMs.Reset(Stage.EnemyCount);
+
+    UE_LOG(LogTemp, Log, TEXT("ベンチマーク段階 %d: 敵 %d体、弾丸 %d発"), StageIndex, Stage.EnemyCount, Stage.ProjectileCount);
+}
+
+void AMCPShooterBenchmarkGameMode::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (bFinished || !Stages.IsValidIndex(StageIndex))
+    {
+        return;
+    }
+
+    // フレーム時間は固定タイムステップ（-benchmark）でも実時間で計測する
+    const double Now = FPlatformTime::Seconds();
+    const float FrameMs = static_cast<float>((Now - LastFrameTime) * 1000.0);
+    LastFrameTime = Now;
+
+    RampEnemies();
+    RampProjectiles();
+
+    // 経過時間はゲーム時間で数え、-benchmark では段階の長さがフレーム数で一定になるようにする
+    StageElapsedSeconds += DeltaTime;
+    if (StageElapsedSeconds < WarmupSeconds)
+    {
+        return;
+    }
+
+    FrameTimesMs.Add(FrameMs);
+    GameThreadTimesMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+    const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    ActiveEnemySum += EnemyManager ? EnemyManager->GetEnemyCount() : 0;
+    ActiveProjectileSum += GetActiveProjectileCount();
+
+    if (StageElapsedSeconds < WarmupSeconds + StageDurationSeconds)
+    {
+        return;
+    }
+
+    FinishStage();
+
+    if (Stages.IsValidIndex(StageIndex + 1))
+    {
+        BeginStage(StageIndex + 1);
+        return;
+    }
+
+    StageIndex = INDEX_NONE;
+    bFinished = true;
+    WriteResults();
+
+    // 自動テストの実行中は、テストが結果を確認できるように終了しない
+    if (FApp::IsUnattended() && !GIsAutomationTesting)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+FVector AMCPShooterBenchmarkGameMode::GetRandomSpawnLocation(const FVector& PlayerLocation)
+{
+    const FVector Offset(
+        SpawnStream.FRandRange(-SpawnBoxExtent.X, SpawnBoxExtent.X),
+        SpawnStream.FRandRange(-SpawnBoxExtent.Y, SpawnBoxExtent.Y),
+        SpawnStream.FRandRange(-SpawnBoxExtent.Z, SpawnBoxExtent.Z));
+    return PlayerLocation + SpawnBoxCenter + Offset;
+}
+
+void AMCPShooterBenchmarkGameMode::RampEnemies()
+{
+    const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    if (!EnemyManager)
+    {
+        return;
+    }
+
+    // プレイヤーがいない場合も原点を基準に負荷をかける
+    const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+    const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+    const int32 Missing = Stages[StageIndex].EnemyCount - EnemyManager->GetEnemyCount();
+    const int32 SpawnCount = FMath::Min(Missing, MaxEnemySpawnsPerFrame);
+    for (int32 Index = 0; Index < SpawnCount; ++Index)
+    {
+        const FVector SpawnLocation = GetRandomSpawnLocation(PlayerLocation);
+
+        const double SpawnStart = FPlatformTime::Seconds();
+        const AMCPShooterEnemy* Enemy = SpawnEnemy(SpawnLocation);
+        SpawnTimesMs.Add(static_cast<float>((FPlatformTime::Seconds() - SpawnStart) * 1000.0));
+
+        if (!Enemy)
+        {
+            // 敵クラスが未設定などで生成できない場合は、このフレームの残りを諦める
+            break;
+        }
+    }
+}
+
+void AMCPShooterBenchmarkGameMode::RampProjectiles()
+{
+    UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::IsEnabled(this) ? UMCPShooterBulletSystem::Get(this) : nullptr;
+    if ((!ProjectilePool && !BulletSystem) || !PooledProjectileClass)
+    {
+        return;
+    }
+
+    const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+    const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+
+    // 敵の射撃で足りない分を、スポーン範囲からプレイヤーに向けて発射する
+    const int32 Missing = Stages[StageIndex].ProjectileCount - GetActiveProjectileCount();
+    const int32 FireCount = FMath::Min(Missing, MaxProjectileSpawnsPerFrame);
+    const FRotator FireRotation(0.0f, 180.0f, 0.0f);
+    for (int32 Index = 0; Index < FireCount; ++Index)
+    {
+        const FTransform FireTransform(FireRotation, GetRandomSpawnLocation(PlayerLocation));
+        if (BulletSystem)
+        {
+            BulletSystem->FireBullet(PooledProjectileClass, FireTransform, this, true);
+        }
+        else if (!ProjectilePool->AcquireProjectile(PooledProjectileClass, FireTransform, this, nullptr, true))
+        {
+            break;
+        }
+    }
+}
+
+int32 AMCPShooterBenchmarkGameMode::GetActiveProjectileCount() const
+{
+    // プールの弾丸と弾丸システムの弾丸の合計（切り替え中は両方が飛んでいることがある）
+    const UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    const UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::Get(this);
+    return (ProjectilePool ? ProjectilePool->GetActiveCount() : 0) + (BulletSystem ? BulletSystem->GetBulletCount() : 0);
+}
+
+float AMCPShooterBenchmarkGameMode::GetPercentile(const TArray<float>& SortedValues, float Percentile)
+{
+    if (SortedValues.Num() == 0)
+    {
+        return 0.0f;
+    }
+
+    const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+    return SortedValues[Index];
+}
+
+void AMCPShooterBenchmarkGameMode::FinishStage()
+{
+    FStageResult& Result = Results.AddDefaulted_GetRef();
+    Result.Stage = Stages[StageIndex];
+    Result.Frames = FrameTimesMs.Num();
+
+    if (Result.Frames > 0)
+    {
+        FrameTimesMs.Sort();
+        Result.FrameMsP50 = GetPercentile(FrameTimesMs, 0.50f);
+        Result.FrameMsP90 = GetPercentile(FrameTimesMs, 0.90f);
+        Result.FrameMsP99 = GetPercentile(FrameTimesMs, 0.99f);
+        Result.FrameMsMax = FrameTimesMs.Last();
+
+        float GameThreadTotal = 0.0f;
+        for (const float GameThreadMs : GameThreadTimesMs)
+        {
+            GameThreadTotal += GameThreadMs;
+        }
+        GameThreadTimesMs.Sort();
+        Result.GameThreadMsAvg = GameThreadTotal / GameThreadTimesMs.Num();
+        Result.GameThreadMsP99 = GetPercentile(GameThreadTimesMs, 0.99f);
+
+        Result.ActiveEnemiesAvg = static_cast<int32>(ActiveEnemySum / Result.Frames);
+        Result.ActiveProjectilesAvg = static_cast<int32>(ActiveProjectileSum / Result.Frames);
+    }
+
+    Result.EnemySpawns = SpawnTimesMs.Num();
+    if (Result.EnemySpawns > 0)
+    {
+        float SpawnTotal = 0.0f;
+        for (const float SpawnMs : SpawnTimesMs)
+        {
+            SpawnTotal += SpawnMs;
+            Result.SpawnMsMax = FMath::Max(Result.SpawnMsMax, SpawnMs);
+        }
+        Result.SpawnMsAvg = SpawnTotal / Result.EnemySpawns;
+    }
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    Result.UsedPhysicalMB = MemoryStats.UsedPhysical / (1024 * 1024);
+    Result.PeakUsedPhysicalMB = MemoryStats.PeakUsedPhysical / (1024 * 1024);
+    
+    // 敵1体あたりのメモリ（アクターとコンポーネント）は計測の区間外で数える
+    if (const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this))
+    {
+        uint64 EnemyBytes = 0;
+        for (AMCPShooterEnemy* Enemy : EnemyManager->GetEnemies())
+        {
+            EnemyBytes += UMCPShooterEnemyManager::CountEnemyBytes(Enemy);
+        }
+        Result.EnemyBytesAvg = EnemyManager->GetEnemyCount() > 0 ? EnemyBytes / EnemyManager->GetEnemyCount() : 0;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ベンチマーク段階 %d の結果: フレーム p50 %.2fms / p99 %.2fms、ゲームスレッド %.2fms、スポーン平均 %.3fms、メモリ %lluMB、敵1体 %lluバイト"),
+           StageIndex, Result.FrameMsP50, Result.FrameMsP99, Result.GameThreadMsAvg, Result.SpawnMsAvg, Result.UsedPhysicalMB, Result.EnemyBytesAvg);
+}
+
+void AMCPShooterBenchmarkGameMode::WriteResults()
+{
+    FString Csv = TEXT("stage,enemies,projectiles,frames,frame_ms_p50,frame_ms_p90,frame_ms_p99,frame_ms_max,")
+                  TEXT("game_thread_ms_avg,game_thread_ms_p99,enemy_spawns,spawn_ms_avg,spawn_ms_max,")
+                  TEXT("active_enemies_avg,active_projectiles_avg,used_physical_mb,peak_used_physical_mb,enemy_bytes_avg\n");
+
+    for (int32 Index = 0; Index < Results.Num(); ++Index)
+    {
+        const FStageResult& Result = Results[Index];
+        Csv += FString::Printf(TEXT("%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%.4f,%.4f,%d,%d,%llu,%llu,%llu\n"),
+            Index, Result.Stage.EnemyCount, Result.Stage.ProjectileCount, Result.Frames,
+            Result.FrameMsP50, Result.FrameMsP90, Result.FrameMsP99, Result.FrameMsMax,
+            Result.GameThreadMsAvg, Result.GameThreadMsP99, Result.EnemySpawns, Result.SpawnMsAvg, Result.SpawnMsMax,
+            Result.ActiveEnemiesAvg, Result.ActiveProjectilesAvg, Result.UsedPhysicalMB, Result.PeakUsedPhysicalMB, Result.EnemyBytesAvg);
+    }
+
+    const FString CsvPath = !OutputPath.IsEmpty()
+        ? OutputPath
+        : FPaths::ProfilingDir() / TEXT("MCPBenchmark") / FString::Printf(TEXT("ShooterBenchmark-%s.csv"), *FDateTime::Now().ToString());
+
+    if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+    {
+        ResultsPath = CsvPath;
+        UE_LOG(LogTemp, Log, TEXT("ベンチマークの結果を書き出しました: %s"), *CsvPath);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("ベンチマークの結果を書き出せませんでした: %s"), *CsvPath);
+    }
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** 自動テストで計測する段階の敵の数 */
+    constexpr int32 AutomationBenchmarkLevel = 100;
+
+    /** 自動テストの計測時間（秒、ウォームアップを除く） */
+    constexpr float AutomationBenchmarkDurationSeconds = 3.0f;
+
+    /** 自動テストがベンチマークの終了を待つ時間の上限（秒） */
+    constexpr float AutomationBenchmarkTimeoutSeconds = 90.0f;
+
+    /** 敵100体の段階の予算（run_shooter_benchmark.py の DEFAULT_BUDGETS と同じ値） */
+    const TPair<const TCHAR*, float> AutomationBenchmarkBudgets[] =
+    {
+        { TEXT("frame_ms_p99"), 16.7f },
+        { TEXT("game_thread_ms_avg"), 8.0f },
+        { TEXT("spawn_ms_avg"), 0.5f },
+        { TEXT("enemy_bytes_avg"), 8192.0f },
+    };
+
+    /** 書き出されたCSVを読み、敵100体の段階が予算内に収まっているかを確認する */
+    void CheckBenchmarkResults(FAutomationTestBase* Test, const FString& CsvPath)
+    {
+        TArray<FString> Lines;
+        if (!Test->TestTrue(TEXT("ベンチマークの結果のCSVが書き出された"), !CsvPath.IsEmpty() && FFileHelper::LoadFileToStringArray(Lines, *CsvPath)))
+        {
+            return;
+        }
+        if (!Test->TestTrue(TEXT("CSVに段階の結果が含まれている"), Lines.Num() >= 2))
+        {
+            return;
+        }
+
+        TArray<FString> Columns;
+        Lines[0].ParseIntoArray(Columns, TEXT(","));
+
+        TArray<FString> Values;
+        Lines[1].ParseIntoArray(Values, TEXT(","));
+        if (!Test->TestEqual(TEXT("CSVの列の数"), Values.Num(), Columns.Num()))
+        {
+            return;
+        }
+
+        auto GetValue = [&Columns, &Values](const TCHAR* Column)
+        {
+            const int32 Index = Columns.IndexOfByKey(FString(Column));
+            return Index != INDEX_NONE ? FCString::Atof(*Values[Index]) : -1.0f;
+        };
+
+        Test->TestEqual(TEXT("計測した段階の敵の数"), static_cast<int32>(GetValue(TEXT("enemies"))), AutomationBenchmarkLevel);
+        Test->TestTrue(TEXT("計測したフレームがある"), GetValue(TEXT("frames")) > 0.0f);
+
+        for (const TPair<const TCHAR*, float>& Budget : AutomationBenchmarkBudgets)
+        {
+            const float Value = GetValue(Budget.Key);
+            Test->TestTrue(FString::Printf(TEXT("%s = %.3f が予算 %.3f 以内"), Budget.Key, Value, Budget.Value),
+                           Value >= 0.0f && Value <= Budget.Value);
+        }
+    }
+}
+
+/** ベンチマークの終了を待ち、結果を確認する */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FMCPWaitForShooterBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FMCPWaitForShooterBenchmarkCommand::Update()
+{
+    const UWorld* World = AutomationCommon::GetAnyGameWorld();
+    const AMCPShooterBenchmarkGameMode* GameMode = World ? World->GetAuthGameMode<AMCPShooterBenchmarkGameMode>() : nullptr;
+    if (GameMode && GameMode->IsBenchmarkFinished())
+    {
+        CheckBenchmarkResults(Test, GameMode->GetResultsPath());
+        return true;
+    }
+
+    if (GetCurrentRunTime() > AutomationBenchmarkTimeoutSeconds)
+    {
+        Test->AddError(GameMode
+            ? FString::Printf(TEXT("ベンチマークが %.0f 秒以内に終了しませんでした"), AutomationBenchmarkTimeoutSeconds)
+            : FString(TEXT("ベンチマークのゲームモードで起動していません")));
+        return true;
+    }
+    return false;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPShooterBenchmarkBudgetTest, "MCP.Shooter.Benchmark.Level100WithinBudget",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FMCPShooterBenchmarkBudgetTest::RunTest(const FString& Parameters)
+{
+    // -MCPBenchmarkMap= で別のマップを指定できる（既定は run_shooter_benchmark.py と同じ）
+    FString MapName = TEXT("/Game/Maps/ShooterMap");
+    FParse::Value(FCommandLine::Get(), TEXT("MCPBenchmarkMap="), MapName);
+
+    const FString URL = FString::Printf(TEXT("%s?game=/Script/SpaceShooterGame.MCPShooterBenchmarkGameMode?MCPBenchmarkLevels=%d?MCPBenchmarkDuration=%.1f"),
+                                        *MapName, AutomationBenchmarkLevel, AutomationBenchmarkDurationSeconds);
+    if (!AutomationOpenMap(URL, true))
+    {
+        AddError(FString::Printf(TEXT("マップを開けませんでした: %s"), *URL));
+        return false;
+    }
+
+    ADD_LATENT_AUTOMATION_COMMAND(FMCPWaitForShooterBenchmarkCommand(this));
+    return true;
+}
+
+#endif
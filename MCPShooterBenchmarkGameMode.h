@@ -0,0 +1,195 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPShooterGameMode.h"
+#include "MCPShooterBenchmarkGameMode.generated.h"
+
+/**
+ * ベンチマークの負荷段階
+ *
+ * 敵と飛行中の弾丸の数をこの値まで増やし、計測時間の間維持します。
+ */
+USTRUCT(BlueprintType)
+struct FMCPShooterBenchmarkStage
+{
+	GENERATED_BODY()
+
+	/** 維持する敵の数 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Benchmark")
+	int32 EnemyCount = 100;
+
+	/** 維持する飛行中の弾丸の数（敵の射撃分を含む） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Benchmark")
+	int32 ProjectileCount = 200;
+};
+
+/**
+ * シューティングゲームのベンチマークゲームモード
+ *
+ * 通常のタイマーによる敵のスポーンの代わりに、固定シードの乱数で決まる位置へ
+ * 敵と弾丸を段階ごとの数まで増やし、一定時間維持して計測します。
+ * 各段階のフレーム時間のパーセンタイル、ゲームスレッドの時間、スポーンにかかった時間、
+ * メモリ使用量をCSVに書き出します。
+ *
+ * 起動例:
+ *   UnrealEditor Project.uproject /Game/Maps/ShooterMap?game=/Script/SpaceShooterGame.MCPShooterBenchmarkGameMode
+ *     -game -unattended -benchmark -fps=60 -MCPBenchmarkLevels=100,500,2000 -MCPBenchmarkDuration=20
+ *
+ * コマンドラインオプション:
+ *   -MCPBenchmarkLevels=   敵の数の段階（カンマ区切り、弾丸の数は敵の数 x ProjectilesPerEnemy）
+ *   -MCPBenchmarkDuration= 各段階の計測時間（秒）
+ *   -MCPBenchmarkSeed=     スポーン位置の乱数シード（-MCPShooterSeed= と同じ）
+ *   -MCPBenchmarkOutput=   CSVの出力先
+ * 同じ名前のURLオプション（?MCPBenchmarkLevels=100 など）も使え、コマンドラインより優先されます。
+ * -unattended で起動した場合は、全段階の計測後に終了します（自動テストの実行中を除く）。
+ *
+ * 自動テスト MCP.Shooter.Benchmark.Level100WithinBudget は敵100体の段階を短時間だけ計測し、
+ * CSVが書き出されて予算内に収まることを確認します。全段階の計測は run_shooter_benchmark.py で行います。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API AMCPShooterBenchmarkGameMode : public AMCPShooterGameMode
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	AMCPShooterBenchmarkGameMode();
+
+	/** 現在の段階のインデックス（終了後はINDEX_NONE） */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Benchmark")
+	int32 GetCurrentStageIndex() const { return StageIndex; }
+
+	/** ベンチマークが終了したかどうか */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Benchmark")
+	bool IsBenchmarkFinished() const { return bFinished; }
+
+	/** 結果のCSVを書き出したパス（書き出す前・失敗した場合は空） */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Benchmark")
+	const FString& GetResultsPath() const { return ResultsPath; }
+
+protected:
+	/** AActorの実装 */
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
+
+	/** 計測中は敵と衝突してもゲームオーバーにしない */
+	virtual void GameOver() override;
+
+	/** URLオプションとコマンドラインの設定を読み込む */
+	void ApplyCommandLineOverrides();
+
+	/** 段階を開始する */
+	void BeginStage(int32 NewStageIndex);
+
+	/** 現在の段階の計測結果をCSVの行として記録する */
+	void FinishStage();
+
+	/** 全段階の結果をCSVに書き出す */
+	void WriteResults();
+
+	/** 敵を段階の数まで増やす（1フレームの上限あり） */
+	void RampEnemies();
+
+	/** 飛行中の弾丸を段階の数まで増やす（1フレームの上限あり） */
+	void RampProjectiles();
+
+	/** 飛行中の弾丸の数（プールと弾丸システムの合計） */
+	int32 GetActiveProjectileCount() const;
+
+	/** 計測する段階 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	TArray<FMCPShooterBenchmarkStage> Stages;
+
+	/** コマンドラインで段階を指定した場合の、敵1体あたりの弾丸の数 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	int32 ProjectilesPerEnemy;
+
+	/** スポーン範囲の中心（プレイヤーからの相対位置） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	FVector SpawnBoxCenter;
+
+	/** スポーン範囲の大きさ（中心からの距離） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	FVector SpawnBoxExtent;
+
+	/** 段階の開始から計測を始めるまでの時間（秒） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	float WarmupSeconds;
+
+	/** 各段階の計測時間（秒） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	float StageDurationSeconds;
+
+	/** 1フレームにスポーンする敵の上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	int32 MaxEnemySpawnsPerFrame;
+
+	/** 1フレームに発射する弾丸の上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	int32 MaxProjectileSpawnsPerFrame;
+
+	/** CSVの出力先（空の場合はProfilingディレクトリ） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Benchmark")
+	FString OutputPath;
+
+private:
+	/** 1段階分の計測結果 */
+	struct FStageResult
+	{
+		FMCPShooterBenchmarkStage Stage;
+		int32 Frames = 0;
+		float FrameMsP50 = 0.0f;
+		float FrameMsP90 = 0.0f;
+		float FrameMsP99 = 0.0f;
+		float FrameMsMax = 0.0f;
+		float GameThreadMsAvg = 0.0f;
+		float GameThreadMsP99 = 0.0f;
+		int32 EnemySpawns = 0;
+		float SpawnMsAvg = 0.0f;
+		float SpawnMsMax = 0.0f;
+		int32 ActiveEnemiesAvg = 0;
+		int32 ActiveProjectilesAvg = 0;
+		uint64 UsedPhysicalMB = 0;
+		uint64 PeakUsedPhysicalMB = 0;
+		uint64 EnemyBytesAvg = 0;
+	};
+
+	/** スポーン範囲内の位置を乱数で決める */
+	FVector GetRandomSpawnLocation(const FVector& PlayerLocation);
+
+	/** 並べ替え済みの配列からパーセンタイルを取り出す */
+	static float GetPercentile(const TArray<float>& SortedValues, float Percentile);
+
+	/** 現在の段階のインデックス */
+	int32 StageIndex;
+
+	/** 現在の段階の経過時間（秒） */
+	double StageElapsedSeconds;
+
+	/** 前回のTickの時刻（フレーム時間の計測用） */
+	double LastFrameTime;
+
+	/** ベンチマークが終了したかどうか */
+	bool bFinished;
+
+	/** 結果のCSVを書き出したパス */
+	FString ResultsPath;
+
+	/** 計測中のフレーム時間（ミリ秒） */
+	TArray<float> FrameTimesMs;
+
+	/** 計測中のゲームスレッドの時間（ミリ秒） */
+	TArray<float> GameThreadTimesMs;
+
+	/** 計測中の敵のスポーン時間（ミリ秒） */
+	TArray<float> SpawnTimesMs;
+
+	/** 計測中の敵と弾丸の数の合計（平均の計算用） */
+	int64 ActiveEnemySum;
+	int64 ActiveProjectileSum;
+
+	/** 完了した段階の結果 */
+	TArray<FStageResult> Results;
+};
@@ -0,0 +1,445 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterBulletSystem.h"
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterHitResolver.h"
+#include "MCPShooterProjectile.h"
+#include "MCPShooterProjectileVisualCache.h"
+#include "MCPShooterGameState.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Bullet Update"), STAT_MCPShooterBulletUpdate, STATGROUP_MCP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shooter Bullets"), STAT_MCPShooterBullets, STATGROUP_MCP);
+
+namespace
+{
+    /** 弾丸システムを使うかどうか */
+    TAutoConsoleVariable<bool> CVarUseBulletSystem(
+        TEXT("MCP.Shooter.BulletSystem"),
+        false,
+        TEXT("trueの場合、弾丸をアクターではなく弾丸システムの構造体として発射します"));
+
+    /** 使われていないインスタンスの位置（大きさ0で描画されない） */
+    const FTransform HiddenInstanceTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+}
+
+UMCPShooterBulletSystem::UMCPShooterBulletSystem()
+    : BulletRadius(0.0f)
+    , BulletMeshScale(0.2f, 0.2f, 1.0f)
+    , MaxBullets(20000)
+    , RenderActor(nullptr)
+    , PlayerBulletInstances(nullptr)
+    , EnemyBulletInstances(nullptr)
+    , PlayerVisibleCount(0)
+    , EnemyVisibleCount(0)
+    , StepAccumulator(0.0)
+    , MaxCatchUpSeconds(0.25f)
+{
+}
+
+UMCPShooterBulletSystem* UMCPShooterBulletSystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UMCPShooterBulletSystem>() : nullptr;
+}
+
+bool UMCPShooterBulletSystem::IsEnabled(const UObject* WorldContextObject)
+{
+    if (CVarUseBulletSystem.GetValueOnGameThread())
+    {
+        return true;
+    }
+
+    // ネットワークゲームでは弾丸を発射イベントとして送るため、常に弾丸システムを使う
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World && World->GetNetMode() != NM_Standalone;
+}
+
+bool UMCPShooterBulletSystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // ゲームとPIEのワールドでのみ使用する
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMCPShooterBulletSystem::Deinitialize()
+{
+    Bullets.Empty();
+    ClassDefaults.Empty();
+    PlayerInstanceTransforms.Empty();
+    EnemyInstanceTransforms.Empty();
+
+    if (UMCPShooterProjectileVisualCache* VisualCache = UMCPShooterProjectileVisualCache::Get(this))
+    {
+        VisualCache->OnVisualsChanged().Remove(VisualsChangedHandle);
+    }
+    VisualsChangedHandle.Reset();
+
+    if (IsValid(RenderActor))
+    {
+        RenderActor->Destroy();
+    }
+    RenderActor = nullptr;
+    PlayerBulletInstances = nullptr;
+    EnemyBulletInstances = nullptr;
+    PlayerVisibleCount = 0;
+    EnemyVisibleCount = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UMCPShooterBulletSystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMCPShooterBulletSystem, STATGROUP_Tickables);
+}
+
+const UMCPShooterBulletSystem::FBulletClassDefaults& UMCPShooterBulletSystem::GetClassDefaults(UClass* ProjectileClass)
+{
+    if (const FBulletClassDefaults* Found = ClassDefaults.Find(ProjectileClass))
+    {
+        return *Found;
+    }
+
+    FBulletClassDefaults& Defaults = ClassDefaults.Add(ProjectileClass);
+    if (const AMCPShooterProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AMCPShooterProjectile>())
+    {
+        Defaults.Damage = ProjectileCDO->GetDamage();
+        Defaults.Lifetime = ProjectileCDO->GetLifetime();
+        if (const UProjectileMovementComponent* Movement = ProjectileCDO->GetProjectileMovement())
+        {
+            Defaults.Speed = Movement->InitialSpeed;
+        }
+    }
+    return Defaults;
+}
+
+FMCPShooterBullet* UMCPShooterBulletSystem::AddBullet(UClass* ProjectileClass, const FVector& Location, const FQuat& Rotation, bool bEnemyBullet)
+{
+    if (!ProjectileClass)
+    {
+        return nullptr;
+    }
+
+    if (Bullets.Num() >= MaxBullets)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("弾丸システムの上限に達したため発射できませんでした: %d"), MaxBullets);
+        return nullptr;
+    }
+
+    const FBulletClassDefaults& Defaults = GetClassDefaults(ProjectileClass);
+
+    FMCPShooterBullet& Bullet = Bullets.AddDefaulted_GetRef();
+    Bullet.Location = Location;
+    Bullet.Rotation = Rotation;
+    Bullet.Velocity = Rotation.GetForwardVector() * Defaults.Speed;
+    Bullet.Damage = Defaults.Damage;
+    Bullet.RemainingLifetime = Defaults.Lifetime;
+    Bullet.bEnemyBullet = bEnemyBullet;
+    Bullet.bCosmetic = false;
+    Bullet.ProjectileClass = ProjectileClass;
+    return &Bullet;
+}
+
+void UMCPShooterBulletSystem::FireBullet(TSubclassOf<AMCPShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* NewOwner, bool bEnemyBullet)
+{
+    FMCPShooterBullet* Bullet = AddBullet(ProjectileClass, SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), bEnemyBullet);
+    if (!Bullet)
+    {
+        return;
+    }
+    Bullet->Owner = NewOwner;
+
+    // サーバーでは発射イベントとしてクライアントへ送る（弾丸のアクターは複製しない）
+    const ENetMode NetMode = GetWorld()->GetNetMode();
+    if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+    {
+        if (AMCPShooterGameState* ShooterGameState = AMCPShooterGameState::Get(this))
+        {
+            FMCPShooterProjectileSpawnEvent SpawnEvent;
+            SpawnEvent.Origin = Bullet->Location;
+            SpawnEvent.Direction = Bullet->Rotation.GetForwardVector();
+            SpawnEvent.ProjectileClass = ProjectileClass;
+            SpawnEvent.FireTime = static_cast<float>(ShooterGameState->GetServerWorldTimeSeconds());
+            SpawnEvent.bEnemyBullet = bEnemyBullet;
+            ShooterGameState->QueueProjectileSpawn(SpawnEvent);
+        }
+    }
+}
+
+void UMCPShooterBulletSystem::SpawnReplicatedBullet(const FMCPShooterProjectileSpawnEvent& SpawnEvent, float CatchUpSeconds)
+{
+    FMCPShooterBullet* Bullet = AddBullet(SpawnEvent.ProjectileClass, SpawnEvent.Origin, SpawnEvent.Direction.ToOrientationQuat(), SpawnEvent.bEnemyBullet);
+    if (!Bullet)
+    {
+        return;
+    }
+
+    // 判定はサーバーで行うため、クライアントの弾丸は当たっても消えるだけにする
+    Bullet->bCosmetic = true;
+
+    // 届くまでにかかった時間だけ進めて、サーバーの弾丸の位置に合わせる
+    const float CatchUp = FMath::Clamp(CatchUpSeconds, 0.0f, MaxCatchUpSeconds);
+    Bullet->Location += Bullet->Velocity * CatchUp;
+    Bullet->RemainingLifetime -= CatchUp;
+}
+
+void UMCPShooterBulletSystem::ClearBullets()
+{
+    Bullets.Reset();
+    UpdateInstances();
+}
+
+void UMCPShooterBulletSystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterBulletUpdate);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterBulletSystem::Tick);
+
+    // 固定ステップの場合は、消化したステップの分だけ進める
+    float StepDeltaTime = DeltaTime;
+    const float StepSeconds = UMCPShooterEnemyManager::GetFixedStepSeconds();
+    if (StepSeconds > 0.0f)
+    {
+        StepAccumulator += DeltaTime;
+        const double Steps = FMath::FloorToDouble(StepAccumulator / StepSeconds);
+        StepAccumulator -= Steps * StepSeconds;
+        StepDeltaTime = static_cast<float>(Steps * StepSeconds);
+    }
+    else
+    {
+        StepAccumulator = 0.0;
+    }
+
+    ResolveTraces();
+    if (StepDeltaTime > 0.0f)
+    {
+        IntegrateBullets(StepDeltaTime);
+    }
+
+    // 専用サーバーでは描画しない
+    if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+    {
+        UpdateInstances();
+    }
+
+    SET_DWORD_STAT(STAT_MCPShooterBullets, Bullets.Num());
+}
+
+void UMCPShooterBulletSystem::ResolveTraces()
+{
+    UWorld* World = GetWorld();
+
+    // 末尾と入れ替えて削除するため、末尾から処理する
+    for (int32 Index = Bullets.Num() - 1; Index >= 0; --Index)
+    {
+        FMCPShooterBullet& Bullet = Bullets[Index];
+        if (!Bullet.PendingTrace.IsValid())
+        {
+            continue;
+        }
+
+        FTraceDatum TraceDatum;
+        const bool bHasResult = World->QueryTraceData(Bullet.PendingTrace, TraceDatum);
+        Bullet.PendingTrace = FTraceHandle();
+        if (!bHasResult)
+        {
+            continue;
+        }
+
+        const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+        if (BlockingHit)
+        {
+            ApplyHit(Bullet, *BlockingHit);
+            Bullets.RemoveAtSwap(Index, 1, false);
+        }
+    }
+}
+
+void UMCPShooterBulletSystem::ApplyHit(const FMCPShooterBullet& Bullet, const FHitResult& Hit) const
+{
+    // AMCPShooterProjectile::OnHit と同じく、発射者以外に当たった時だけダメージを与える
+    AActor* OtherActor = Hit.GetActor();
+    AActor* BulletOwner = Bullet.Owner.Get();
+    if (!OtherActor || OtherActor == BulletOwner)
+    {
+        return;
+    }
+
+    // 着弾エフェクトはクライアントで再現した弾丸でも再生する
+    if (UMCPShooterHitResolver* HitResolver = UMCPShooterHitResolver::Get(this))
+    {
+        HitResolver->EmitImpactEffects(Bullet.ProjectileClass->GetDefaultObject<AMCPShooterProjectile>(), Hit.ImpactPoint, Bullet.Rotation.Rotator());
+    }
+
+    if (!Bullet.bCosmetic)
+    {
+        UMCPShooterHitResolver::ApplyProjectileDamage(OtherActor, BulletOwner, Bullet.Damage, Bullet.bEnemyBullet);
+    }
+}
+
+void UMCPShooterBulletSystem::IntegrateBullets(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+
+    // 弾丸が当たる対象（敵・プレイヤー・地形）
+    FCollisionObjectQueryParams ObjectQueryParams;
+    ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+    ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+    ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+    const FCollisionShape BulletShape = FCollisionShape::MakeSphere(BulletRadius);
+
+    for (int32 Index = Bullets.Num() - 1; Index >= 0; --Index)
+    {
+        FMCPShooterBullet& Bullet = Bullets[Index];
+
+        Bullet.RemainingLifetime -= DeltaTime;
+        if (Bullet.RemainingLifetime <= 0.0f)
+        {
+            Bullets.RemoveAtSwap(Index, 1, false);
+            continue;
+        }
+
+        const FVector Start = Bullet.Location;
+        Bullet.Location += Bullet.Velocity * DeltaTime;
+
+        // 移動した区間の衝突判定を発行し、結果は次のフレームで受け取る
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MCPShooterBullet), false);
+        if (AActor* BulletOwner = Bullet.Owner.Get())
+        {
+            QueryParams.AddIgnoredActor(BulletOwner);
+        }
+
+        if (BulletRadius > 0.0f)
+        {
+            Bullet.PendingTrace = World->AsyncSweepByObjectType(EAsyncTraceType::Single, Start, Bullet.Location, FQuat::Identity,
+                ObjectQueryParams, BulletShape, QueryParams);
+        }
+        else
+        {
+            Bullet.PendingTrace = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Start, Bullet.Location,
+                ObjectQueryParams, QueryParams);
+        }
+    }
+}
+
+void UMCPShooterBulletSystem::EnsureRenderComponents()
+{
+    if (IsValid(RenderActor))
+    {
+        return;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    RenderActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!RenderActor)
+    {
+        return;
+    }
+
+    auto CreateInstances = [this]() -> UInstancedStaticMeshComponent*
+    {
+        UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(RenderActor);
+        Instances->SetMobility(EComponentMobility::Movable);
+        Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Instances->SetCastShadow(false);
+
+        if (RenderActor->GetRootComponent())
+        {
+            Instances->SetupAttachment(RenderActor->GetRootComponent());
+        }
+        else
+        {
+            RenderActor->SetRootComponent(Instances);
+        }
+        Instances->RegisterComponent();
+        return Instances;
+    };
+
+    PlayerBulletInstances = CreateInstances();
+    EnemyBulletInstances = CreateInstances();
+    ApplyVisuals();
+
+    // メッシュのインポートが後から完了した場合は、その時点で設定し直す
+    UMCPShooterProjectileVisualCache* VisualCache = UMCPShooterProjectileVisualCache::Get(this);
+    if (VisualCache && !VisualsChangedHandle.IsValid())
+    {
+        VisualsChangedHandle = VisualCache->OnVisualsChanged().AddUObject(this, &UMCPShooterBulletSystem::ApplyVisuals);
+    }
+}
+
+void UMCPShooterBulletSystem::ApplyVisuals()
+{
+    UMCPShooterProjectileVisualCache* VisualCache = UMCPShooterProjectileVisualCache::Get(this);
+    if (!VisualCache)
+    {
+        return;
+    }
+
+    auto Apply = [VisualCache](UInstancedStaticMeshComponent* Instances, bool bEnemyBullet)
+    {
+        if (!Instances)
+        {
+            return;
+        }
+
+        const FMCPProjectileVisuals& Visuals = VisualCache->GetVisuals(bEnemyBullet);
+        Instances->SetStaticMesh(Visuals.Mesh);
+        if (Visuals.Material)
+        {
+            Instances->SetMaterial(0, Visuals.Material);
+        }
+    };
+
+    Apply(PlayerBulletInstances, false);
+    Apply(EnemyBulletInstances, true);
+}
+
+void UMCPShooterBulletSystem::UpdateInstances()
+{
+    PlayerInstanceTransforms.Reset();
+    EnemyInstanceTransforms.Reset();
+    for (const FMCPShooterBullet& Bullet : Bullets)
+    {
+        TArray<FTransform>& Transforms = Bullet.bEnemyBullet ? EnemyInstanceTransforms : PlayerInstanceTransforms;
+        Transforms.Emplace(Bullet.Rotation, Bullet.Location, BulletMeshScale);
+    }
+
+    if (Bullets.Num() > 0)
+    {
+        EnsureRenderComponents();
+    }
+
+    auto ApplyTransforms = [](UInstancedStaticMeshComponent* Instances, TArray<FTransform>& Transforms, int32& VisibleCount)
+    {
+        // 前回も今回も表示する弾丸がなければ更新しない
+        if (!Instances || (Transforms.Num() == 0 && VisibleCount == 0))
+        {
+            return;
+        }
+        VisibleCount = Transforms.Num();
+
+        // インスタンスは減らさずに使い回し、余った分は大きさ0にして隠す
+        const int32 InstanceCount = Instances->GetInstanceCount();
+        if (Transforms.Num() > InstanceCount)
+        {
+            TArray<FTransform> NewInstances;
+            NewInstances.Init(HiddenInstanceTransform, Transforms.Num() - InstanceCount);
+            Instances->AddInstances(NewInstances, false, true);
+        }
+        else
+        {
+            while (Transforms.Num() < InstanceCount)
+            {
+                Transforms.Add(HiddenInstanceTransform);
+            }
+        }
+
+        Instances->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+    };
+
+    ApplyTransforms(PlayerBulletInstances, PlayerInstanceTransforms, PlayerVisibleCount);
+    ApplyTransforms(EnemyBulletInstances, EnemyInstanceTransforms, EnemyVisibleCount);
+}
@@ -0,0 +1,235 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "Engine/NetSerialization.h"
+#include "MCPShooterBulletSystem.generated.h"
+
+class AMCPShooterProjectile;
+class UInstancedStaticMeshComponent;
+
+/**
+ * 弾丸システムの弾丸1発分
+ *
+ * アクターやコンポーネントを持たない単純な構造体で、連続した配列に格納されます。
+ */
+struct FMCPShooterBullet
+{
+	/** 現在位置 */
+	FVector Location;
+
+	/** 速度（弾丸は重力の影響を受けず等速で進む） */
+	FVector Velocity;
+
+	/** 向き（描画用、発射時に決まる） */
+	FQuat Rotation;
+
+	/** 当たった相手に与えるダメージ量 */
+	float Damage;
+
+	/** 残りの寿命（秒） */
+	float RemainingLifetime;
+
+	/** 敵の弾丸かどうか */
+	bool bEnemyBullet;
+
+	/** 発射者（衝突判定から除外する） */
+	TWeakObjectPtr<AActor> Owner;
+
+	/** 前回の移動で発行した非同期トレース（次のフレームで結果を受け取る） */
+	FTraceHandle PendingTrace;
+
+	/** 見た目だけの弾丸かどうか（クライアントで再現した弾丸はダメージを与えない） */
+	bool bCosmetic;
+
+	/** 弾丸クラス（着弾エフェクトの参照用） */
+	UClass* ProjectileClass;
+};
+
+/**
+ * サーバーからクライアントへ送る弾丸の発射イベント
+ *
+ * 弾丸はアクターとして複製せず、このイベントを受け取ったクライアントが
+ * 弾丸システムで同じ直線の弾道を再現します。速度・寿命は弾丸クラスの既定値です。
+ */
+USTRUCT()
+struct FMCPShooterProjectileSpawnEvent
+{
+	GENERATED_BODY()
+
+	/** 発射位置（小数点以下1桁に量子化） */
+	UPROPERTY()
+	FVector_NetQuantize10 Origin;
+
+	/** 発射方向（単位ベクトルとして量子化） */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	/** 弾丸クラス */
+	UPROPERTY()
+	TSubclassOf<AMCPShooterProjectile> ProjectileClass;
+
+	/** 発射時のサーバーのワールド時間（遅延分を進めるために使う） */
+	UPROPERTY()
+	float FireTime = 0.0f;
+
+	/** 敵の弾丸かどうか */
+	UPROPERTY()
+	bool bEnemyBullet = false;
+};
+
+/**
+ * シューティングゲームの弾丸システム
+ *
+ * MCP.Shooter.BulletSystem が有効な場合、弾丸をアクターとして生成する代わりに
+ * 構造体の配列で管理します。移動は1つのループでまとめて計算し、衝突判定は
+ * 非同期トレースで行い（結果は次のフレームで処理）、描画は陣営ごとの
+ * インスタンススタティックメッシュ1つで行います。
+ * 当たった際のダメージと陣営の判定は AMCPShooterProjectile::OnHit と同じです。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API UMCPShooterBulletSystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	UMCPShooterBulletSystem();
+
+	/** ワールドから弾丸システムを取得する */
+	static UMCPShooterBulletSystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * 弾丸システムで弾丸を発射する設定かどうか
+	 * MCP.Shooter.BulletSystem が有効な場合と、ネットワークゲームの場合（弾丸をアクターとして複製しない）はtrueです。
+	 */
+	static bool IsEnabled(const UObject* WorldContextObject);
+
+	/** USubsystemの実装 */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObjectの実装 */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * 弾丸を発射する
+	 * 速度・ダメージ・寿命は弾丸クラスの既定値を使用します。
+	 * @param ProjectileClass 弾丸クラス
+	 * @param SpawnTransform 発射位置と向き
+	 * @param NewOwner 発射者
+	 * @param bEnemyBullet 敵の弾丸かどうか
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Bullets")
+	void FireBullet(TSubclassOf<AMCPShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* NewOwner, bool bEnemyBullet);
+
+	/**
+	 * サーバーから届いた発射イベントの弾丸を見た目だけ再現する（クライアント）
+	 * @param SpawnEvent 発射イベント
+	 * @param CatchUpSeconds 発射から経過した時間（この分だけ進めた位置から始める）
+	 */
+	void SpawnReplicatedBullet(const FMCPShooterProjectileSpawnEvent& SpawnEvent, float CatchUpSeconds);
+
+	/** 飛行中の弾丸の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Bullets")
+	int32 GetBulletCount() const { return Bullets.Num(); }
+
+	/** 全ての弾丸を消す */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Bullets")
+	void ClearBullets();
+
+protected:
+	/** 弾丸クラスごとの既定値 */
+	struct FBulletClassDefaults
+	{
+		float Speed = 0.0f;
+		float Damage = 0.0f;
+		float Lifetime = 0.0f;
+	};
+
+	/** USubsystemの実装 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** 弾丸クラスの既定値を取得する（初回のみクラスのデフォルトオブジェクトから読む） */
+	const FBulletClassDefaults& GetClassDefaults(UClass* ProjectileClass);
+
+	/** 前のフレームで発行した衝突判定の結果を処理する */
+	void ResolveTraces();
+
+	/**
+	 * 全ての弾丸を移動させ、移動区間の衝突判定を発行する
+	 * @param DeltaTime 経過時間（秒）
+	 */
+	void IntegrateBullets(float DeltaTime);
+
+	/** 弾丸の位置をインスタンスメッシュに反映する */
+	void UpdateInstances();
+
+	/** 描画用のインスタンスメッシュを作成する（初回のみ） */
+	void EnsureRenderComponents();
+
+	/** 見た目キャッシュのメッシュとマテリアルをインスタンスメッシュに設定する */
+	void ApplyVisuals();
+
+	/** 弾丸を配列に追加する（上限に達している場合はnullptr） */
+	FMCPShooterBullet* AddBullet(UClass* ProjectileClass, const FVector& Location, const FQuat& Rotation, bool bEnemyBullet);
+
+	/**
+	 * 弾丸が当たった時の処理（チームの判定・ダメージ・着弾エフェクト）
+	 * @param Bullet 当たった弾丸
+	 * @param Hit 衝突情報
+	 */
+	void ApplyHit(const FMCPShooterBullet& Bullet, const FHitResult& Hit) const;
+
+	/** 衝突判定に球を使う場合の半径（0の場合は線分のトレース） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Bullets")
+	float BulletRadius;
+
+	/** 弾丸のメッシュの大きさ */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Bullets")
+	FVector BulletMeshScale;
+
+	/** 同時に存在できる弾丸の上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Bullets")
+	int32 MaxBullets;
+
+	/** 飛行中の弾丸 */
+	TArray<FMCPShooterBullet> Bullets;
+
+	/** 弾丸クラスごとの既定値 */
+	TMap<TWeakObjectPtr<UClass>, FBulletClassDefaults> ClassDefaults;
+
+	/** 描画用のアクター */
+	UPROPERTY()
+	AActor* RenderActor;
+
+	/** プレイヤーの弾丸のインスタンスメッシュ */
+	UPROPERTY()
+	UInstancedStaticMeshComponent* PlayerBulletInstances;
+
+	/** 敵の弾丸のインスタンスメッシュ */
+	UPROPERTY()
+	UInstancedStaticMeshComponent* EnemyBulletInstances;
+
+	/** 見た目キャッシュの更新通知の登録 */
+	FDelegateHandle VisualsChangedHandle;
+
+	/** インスタンスの位置（作業配列） */
+	TArray<FTransform> PlayerInstanceTransforms;
+	TArray<FTransform> EnemyInstanceTransforms;
+
+	/** 前回の更新で表示したインスタンスの数 */
+	int32 PlayerVisibleCount;
+	int32 EnemyVisibleCount;
+
+	/** 固定ステップの場合に、まだ消化していない経過時間 */
+	double StepAccumulator;
+
+	/** 遅れて届いた発射イベントを進める時間の上限（秒） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Bullets")
+	float MaxCatchUpSeconds;
+};
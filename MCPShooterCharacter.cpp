@@ -2,6 +2,8 @@
 
 #include "MCPShooterCharacter.h"
 #include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
+#include "MCPShooterBulletSystem.h"
 #include "MCPShooterGameMode.h"
 #include "MCPAssetManager.h"
 #include "Camera/CameraComponent.h"
@@ -12,13 +14,14 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "GameFramework/FloatingPawnMovement.h"
 #include "UObject/ConstructorHelpers.h"
 #include "TimerManager.h"
 #include "MCPShooterEnemy.h"
 
-AMCPShooterCharacter::AMCPShooterCharacter()
-    : Health(100.0f)
+AMCPShooterCharacter::AMCPShooterCharacter(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer.DoNotCreateDefaultSubobject(ACharacter::MeshComponentName))
+    , FireOffset(100.0f, 0.0f, 0.0f)
+    , Health(100.0f)
     , MaxHealth(100.0f)
     , FireRate(2.0f)
     , LastFireTime(0.0f)
@@ -42,11 +45,6 @@ AMCPShooterCharacter::AMCPShooterCharacter()
     ShipMeshComponent->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
     ShipMeshComponent->SetCollisionProfileName(TEXT("CharacterMesh"));
     
-    // 射撃位置コンポーネントの作成
-    GunLocation = CreateDefaultSubobject<USceneComponent>(TEXT("GunLocation"));
-    GunLocation->SetupAttachment(ShipMeshComponent);
-    GunLocation->SetRelativeLocation(FVector(100.0f, 0.0f, 0.0f));
-    
     // カメラブームの作成
     USpringArmComponent* CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
     CameraBoom->SetupAttachment(RootComponent);
@@ -59,9 +57,9 @@ AMCPShooterCharacter::AMCPShooterCharacter()
     CameraBoom->bDoCollisionTest = false;
     
     // カメラの作成
-    UCameraComponent* Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
-    Camera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
-    Camera->bUsePawnControlRotation = false;
+    CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
+    CameraComponent->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
+    CameraComponent->bUsePawnControlRotation = false;
     
     // 射撃間隔を計算
     FireInterval = 1.0f / FireRate;
@@ -78,10 +76,6 @@ AMCPShooterCharacter::AMCPShooterCharacter()
     
     // AIコントローラによる制御を無効化
     AutoPossessAI = EAutoPossessAI::Disabled;
-
-    // 移動コンポーネントを作成
-    MovementComponent = CreateDefaultSubobject<UFloatingPawnMovement>(TEXT("MovementComponent"));
-    MovementComponent->MaxSpeed = 1000.0f;
 }
 
 void AMCPShooterCharacter::BeginPlay()
@@ -184,6 +178,13 @@ void AMCPShooterCharacter::Fire()
         // 射撃時間を更新
         LastFireTime = GetWorld()->GetTimeSeconds();
         
+        // ネットワークゲームのクライアントでは、サーバーで発射する
+        if (!HasAuthority())
+        {
+            ServerFire();
+            return;
+        }
+        
         // プロジェクタイルクラスが設定されているか確認
         if (!ProjectileClass)
         {
@@ -192,25 +193,43 @@ void AMCPShooterCharacter::Fire()
         }
         
         // 射撃位置と方向を取得
-        FVector SpawnLocation = GunLocation->GetComponentLocation();
+        FVector SpawnLocation = GetActorTransform().TransformPosition(FireOffset);
         FRotator SpawnRotation = GetActorRotation();
         
-        // スポーンパラメータの設定
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-        SpawnParams.Owner = this;
-        SpawnParams.Instigator = GetInstigator();
+        // 弾丸システムが有効な場合はアクターを使わずに発射
+        if (UMCPShooterBulletSystem::IsEnabled(this))
+        {
+            if (UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::Get(this))
+            {
+                BulletSystem->FireBullet(ProjectileClass, FTransform(SpawnRotation, SpawnLocation), this, false);
+                return;
+            }
+        }
         
-        // プロジェクタイルの生成
-        AActor* SpawnedProjectile = GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+        // プールから弾丸を取得して発射
+        UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+        if (!ProjectilePool)
+        {
+            UE_LOG(LogTemp, Error, TEXT("プロジェクタイルプールを取得できませんでした"));
+            return;
+        }
+        
+        AMCPShooterProjectile* SpawnedProjectile = ProjectilePool->AcquireProjectile(
+            ProjectileClass, FTransform(SpawnRotation, SpawnLocation), this, GetInstigator(), false);
         if (SpawnedProjectile)
         {
             // プロジェクタイルのログ
-            UE_LOG(LogTemp, Display, TEXT("プロジェクタイルを発射しました: %s"), *SpawnedProjectile->GetName());
+            UE_LOG(LogTemp, Verbose, TEXT("プロジェクタイルを発射しました: %s"), *SpawnedProjectile->GetName());
         }
     }
 }
 
+void AMCPShooterCharacter::ServerFire_Implementation()
+{
+    // 射撃間隔はサーバー側でも確認される
+    Fire();
+}
+
 void AMCPShooterCharacter::SetFireRate(float NewFireRate)
 {
     if (NewFireRate > 0.0f)
@@ -232,34 +251,30 @@ void AMCPShooterCharacter::SetupPlayerMesh()
     // MCPアセットマネージャーを使ってBlenderからインポートしたメッシュを設定
     if (MCPComponent)
     {
-        // PlayerShipアセットをロード
-        MCPComponent->LoadBlenderAsset("/Game/BlenderAssets/PlayerShip", 
-            UMCPGameplayComponent::FOnAssetLoaded::CreateLambda([this](bool bSuccess) {
-                if (bSuccess)
-                {
-                    // アセットロード成功
-                    UE_LOG(LogTemp, Log, TEXT("プレイヤーシップアセットのロードに成功しました"));
-                    
-                    // メッシュアセットを取得して設定
-                    UObject* Asset = LoadObject<UObject>(nullptr, TEXT("/Game/BlenderAssets/PlayerShip"));
-                    UStaticMesh* ShipMesh = Cast<UStaticMesh>(Asset);
-                    if (ShipMesh)
-                    {
-                        ShipMeshComponent->SetStaticMesh(ShipMesh);
-                        UE_LOG(LogTemp, Log, TEXT("プレイヤーシップメッシュを設定しました"));
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("PlayerShipメッシュアセットが見つかりませんでした"));
-                    }
-                }
-                else
-                {
-                    // アセットロード失敗
-                    UE_LOG(LogTemp, Warning, TEXT("プレイヤーシップアセットのロードに失敗しました"));
-                }
-            })
-        );
+        // PlayerShipアセットを非同期でロードし、ロード完了時に直接メッシュを設定する
+        TWeakObjectPtr<AMCPShooterCharacter> WeakThis(this);
+        MCPComponent->RequestBlenderAsset(TEXT("/Game/BlenderAssets/PlayerShip"), [WeakThis](UObject* Asset) {
+            if (!WeakThis.IsValid())
+            {
+                return;
+            }
+            
+            UStaticMesh* ShipMesh = Cast<UStaticMesh>(Asset);
+            if (ShipMesh)
+            {
+                WeakThis->ShipMeshComponent->SetStaticMesh(ShipMesh);
+                UE_LOG(LogTemp, Verbose, TEXT("プレイヤーシップメッシュを設定しました"));
+            }
+            else if (Asset)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PlayerShipメッシュアセットが見つかりませんでした"));
+            }
+            else
+            {
+                // アセットロード失敗
+                UE_LOG(LogTemp, Warning, TEXT("プレイヤーシップアセットのロードに失敗しました"));
+            }
+        });
     }
     else
     {
@@ -3,14 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Pawn.h"
+#include "GameFramework/Character.h"
 #include "MCPGameplayComponent.h"
 #include "MCPShooterCharacter.generated.h"
 
 class UStaticMeshComponent;
 class UCameraComponent;
-class USceneComponent;
-class UFloatingPawnMovement;
 class AMCPShooterProjectile;
 
 /**
@@ -18,9 +16,11 @@ class AMCPShooterProjectile;
  *
  * このクラスはプレイヤーが操作する宇宙船を表現します。
  * 移動機能と射撃機能を提供します。
+ * 移動はキャラクターの移動コンポーネント（飛行モード）だけで行い、
+ * 見た目は ShipMesh のスタティックメッシュのため、キャラクターのスケルタルメッシュは作成しません。
  */
 UCLASS()
-class SPACESHOOTERGAME_API AMCPShooterCharacter : public APawn
+class SPACESHOOTERGAME_API AMCPShooterCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
@@ -28,8 +28,9 @@ public:
 	/**
 	 * コンストラクタ
 	 * キャラクターの初期設定を行います
+	 * @param ObjectInitializer 使わないスケルタルメッシュを作成しないための初期化子
 	 */
-	AMCPShooterCharacter();
+	AMCPShooterCharacter(const FObjectInitializer& ObjectInitializer);
 
 	/**
 	 * 射撃を行う関数
@@ -58,6 +59,10 @@ public:
 	bool CanFire() const;
 
 protected:
+	/** クライアントの射撃をサーバーで実行する（弾丸はサーバーから発射イベントとして届く） */
+	UFUNCTION(Server, Unreliable)
+	void ServerFire();
+
 	/**
 	 * ゲーム開始時に呼び出される関数
 	 */
@@ -85,9 +90,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Shooting")
 	TSubclassOf<AMCPShooterProjectile> ProjectileClass;
 
-	/** 射撃位置の参照 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Shooting")
-	USceneComponent* ProjectileSpawnPoint;
+	/** 発射位置（ローカル座標、向きはキャラクターと同じ） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Shooting")
+	FVector FireOffset;
 
 	/** MCPゲームプレイコンポーネント */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP")
@@ -123,6 +128,10 @@ protected:
 	/** プレイヤーの見た目をBlenderアセットで設定 */
 	void SetupPlayerMesh();
 
+	/** 機体の衝突処理 */
+	UFUNCTION()
+	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
 	/** プレイヤーのメッシュコンポーネント */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mesh")
 	UStaticMeshComponent* ShipMeshComponent;
@@ -131,13 +140,8 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* CameraComponent;
 
-	/** 移動コンポーネント */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
-	UFloatingPawnMovement* MovementComponent;
-
 public:
 	/** コンポーネントのゲッター */
 	FORCEINLINE UStaticMeshComponent* GetShipMeshComponent() const { return ShipMeshComponent; }
 	FORCEINLINE UCameraComponent* GetCameraComponent() const { return CameraComponent; }
-	FORCEINLINE UFloatingPawnMovement* GetMovementComponent() const { return MovementComponent; }
 }; 
@@ -2,29 +2,37 @@
 
 #include "MCPShooterEnemy.h"
 #include "MCPShooterCharacter.h"
-#include "MCPShooterGameMode.h"
-#include "MCPAssetManager.h"
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterEnemyData.h"
+#include "MCPSubsystem.h"
 #include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
-#include "Kismet/GameplayStatics.h"
 #include "GameFramework/FloatingPawnMovement.h"
 #include "UObject/ConstructorHelpers.h"
-#include "Components/SceneComponent.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "TimerManager.h"
+#include "MCPShooterBulletSystem.h"
+#include "MCPStats.h"
 
 AMCPShooterEnemy::AMCPShooterEnemy()
-    : Health(100.0f)
-    , MaxHealth(100.0f)
+    : EnemyData(nullptr)
+    , Health(100.0f)
     , MoveSpeed(200.0f)
-    , AttackDamage(10.0f)
-    , AttackInterval(3.0f)
-    , LastAttackTime(0.0f)
-    , ScoreValue(100)
+    , ManagerIndex(INDEX_NONE)
 {
-    // ティックを有効化
-    PrimaryActorTick.bCanEverTick = true;
+    // 移動と射撃は敵マネージャーがまとめて更新するため、個別のティックは不要
+    PrimaryActorTick.bCanEverTick = false;
+    
+    // 移動はサーバーで計算し、量子化した位置と向きをクライアントへ複製する
+    bReplicates = true;
+    SetReplicatingMovement(true);
+    FRepMovement& RepMovement = GetReplicatedMovement_Mutable();
+    RepMovement.LocationQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+    RepMovement.VelocityQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+    RepMovement.RotationQuantizationLevel = ERotatorQuantization::ByteComponents;
+    SetNetUpdateFrequency(10.0f);
+    SetMinNetUpdateFrequency(2.0f);
     
     // 敵のルートコンポーネントとなるメッシュコンポーネントを作成
     EnemyMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("EnemyMeshComponent"));
@@ -37,14 +45,6 @@ AMCPShooterEnemy::AMCPShooterEnemy()
     // 衝突イベントをバインド
     EnemyMeshComponent->OnComponentHit.AddDynamic(this, &AMCPShooterEnemy::OnHit);
     
-    // 射撃位置コンポーネントの作成
-    ProjectileSpawnPoint = CreateDefaultSubobject<USceneComponent>(TEXT("ProjectileSpawnPoint"));
-    ProjectileSpawnPoint->SetupAttachment(EnemyMeshComponent);
-    ProjectileSpawnPoint->SetRelativeLocation(FVector(100.0f, 0.0f, 0.0f));
-    
-    // MCPコンポーネントの作成
-    MCPComponent = CreateDefaultSubobject<UMCPGameplayComponent>(TEXT("MCPComponent"));
-    
     // メッシュを設定
     static ConstructorHelpers::FObjectFinder<UStaticMesh> EnemyMeshAsset(TEXT("/Game/ShooterGame/Assets/EnemyShip"));
     if (EnemyMeshAsset.Succeeded())
@@ -52,8 +52,8 @@ AMCPShooterEnemy::AMCPShooterEnemy()
         EnemyMeshComponent->SetStaticMesh(EnemyMeshAsset.Object);
     }
     
-    // タグを追加
-    Tags.Add(TEXT("Enemy"));
+    // 発射位置はシーンコンポーネントを作らず、EnemyData の FireOffset から求める
+    // 敵の判定はクラスで行うため、1体ごとにタグの配列は持たない
     
     // 移動コンポーネントを作成
     MovementComponent = CreateDefaultSubobject<UFloatingPawnMovement>(TEXT("MovementComponent"));
@@ -71,61 +71,65 @@ void AMCPShooterEnemy::BeginPlay()
 {
     Super::BeginPlay();
     
-    // 体力を最大値に設定
-    Health = MaxHealth;
+    // 体力と移動速度を種類ごとの値で初期化
+    const UMCPShooterEnemyData& Data = GetEnemyData();
+    Health = Data.MaxHealth;
+    MoveSpeed = Data.MoveSpeed;
+    MovementComponent->MaxSpeed = MoveSpeed;
     
     // 敵のメッシュを設定
     SetupEnemyMesh();
     
-    // 最初の攻撃時間を記録
-    LastAttackTime = GetWorld()->GetTimeSeconds();
-    
-    // タイマーをセット
-    GetWorldTimerManager().SetTimer(FireTimerHandle, this, &AMCPShooterEnemy::FireTimerHandler, AttackInterval, true);
-    GetWorldTimerManager().SetTimer(MoveTimerHandle, this, &AMCPShooterEnemy::MoveTimerHandler, 0.1f, true);
-}
-
-void AMCPShooterEnemy::Tick(float DeltaTime)
-{
-    Super::Tick(DeltaTime);
+    // 移動と射撃は敵マネージャーに任せる
+    UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    if (EnemyManager)
+    {
+        EnemyManager->RegisterEnemy(this);
+    }
 }
 
-void AMCPShooterEnemy::FireTimerHandler()
+void AMCPShooterEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    // 射撃を実行
-    Fire();
+    UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    if (EnemyManager)
+    {
+        EnemyManager->UnregisterEnemy(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
-void AMCPShooterEnemy::MoveTimerHandler()
+void AMCPShooterEnemy::Tick(float DeltaTime)
 {
-    // プレイヤーを検索
-    AActor* PlayerActor = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-    if (PlayerActor)
-    {
-        // プレイヤーに向かって移動
-        MoveTowardsPlayer(PlayerActor->GetActorLocation());
-    }
+    Super::Tick(DeltaTime);
 }
 
 void AMCPShooterEnemy::Fire()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(AMCPShooterEnemy::Fire);
+    
     // 発射位置と向きを取得
-    const FVector SpawnLocation = ProjectileSpawnPoint->GetComponentLocation();
-    const FRotator SpawnRotation = ProjectileSpawnPoint->GetComponentRotation();
+    const FVector SpawnLocation = GetActorTransform().TransformPosition(GetEnemyData().FireOffset);
+    const FRotator SpawnRotation = GetActorRotation();
     
     // 弾丸クラスが設定されていることを確認
     if (ProjectileClass)
     {
-        // 弾丸を発射
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Owner = this;
-        SpawnParams.Instigator = GetInstigator();
+        // 弾丸システムが有効な場合はアクターを使わずに発射
+        if (UMCPShooterBulletSystem::IsEnabled(this))
+        {
+            if (UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::Get(this))
+            {
+                BulletSystem->FireBullet(ProjectileClass, FTransform(SpawnRotation, SpawnLocation), this, true);
+                return;
+            }
+        }
         
-        AMCPShooterProjectile* Projectile = GetWorld()->SpawnActor<AMCPShooterProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
-        if (Projectile)
+        // プールから敵の弾として取得して発射
+        UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+        if (ProjectilePool)
         {
-            // 敵の弾として設定
-            Projectile->SetIsEnemyProjectile(true);
+            ProjectilePool->AcquireProjectile(ProjectileClass, FTransform(SpawnRotation, SpawnLocation), this, GetInstigator(), true);
         }
     }
 }
@@ -168,7 +172,7 @@ float AMCPShooterEnemy::TakeDamage(float DamageAmount, FDamageEvent const& Damag
 
 void AMCPShooterEnemy::SetHealth(float NewHealth)
 {
-    Health = FMath::Clamp(NewHealth, 0.0f, MaxHealth);
+    Health = FMath::Clamp(NewHealth, 0.0f, GetEnemyData().MaxHealth);
     
     // 体力が0になったら敵を破壊
     if (Health <= 0.0f)
@@ -179,28 +183,31 @@ void AMCPShooterEnemy::SetHealth(float NewHealth)
 
 void AMCPShooterEnemy::HandleDestruction()
 {
-    // 敵が破壊されたことをゲームモードに通知
-    AMCPShooterGameMode* GameMode = Cast<AMCPShooterGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
-    if (GameMode)
+    // 敵が破壊されたイベントを発行（スコアは敵マネージャーの通知を購読しているゲームモードが1回だけ加算する）
+    OnEnemyDestroyed.Broadcast(this);
+    if (UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this))
     {
-        GameMode->AddScore(ScoreValue);
+        EnemyManager->NotifyEnemyKilled(this);
     }
     
-    // 敵が破壊されたイベントを発行
-    OnEnemyDestroyed.Broadcast(this);
-    
     // アクターを破壊
     Destroy();
 }
 
 void AMCPShooterEnemy::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+    // 衝突によるダメージと破壊はサーバーで判定する
+    if (!HasAuthority())
+    {
+        return;
+    }
+    
     // プレイヤーとの衝突を処理
     AMCPShooterCharacter* Player = Cast<AMCPShooterCharacter>(OtherActor);
     if (Player)
     {
         // プレイヤーにダメージを与える
-        float DamageToPlayer = AttackDamage * 2.0f;  // 衝突時は通常攻撃の2倍のダメージ
+        float DamageToPlayer = GetEnemyData().AttackDamage * 2.0f;  // 衝突時は通常攻撃の2倍のダメージ
         FDamageEvent DamageEvent;
         Player->TakeDamage(DamageToPlayer, DamageEvent, nullptr, this);
         
@@ -212,43 +219,62 @@ void AMCPShooterEnemy::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherAct
 void AMCPShooterEnemy::SetupEnemyMesh()
 {
     // MCPアセットマネージャーを使ってBlenderからインポートしたメッシュを設定
-    if (MCPComponent)
+    // （敵ごとにコンポーネントは持たず、ゲームインスタンスで共有するサブシステムから取得する）
+    UMCPSubsystem* Subsystem = UMCPSubsystem::Get(this);
+    UMCPAssetManager* AssetManager = Subsystem ? Subsystem->GetAssetManager() : nullptr;
+    if (AssetManager)
     {
-        // EnemyShipアセットをロード
-        MCPComponent->LoadBlenderAsset("/Game/BlenderAssets/EnemyShip", 
-            UMCPGameplayComponent::FOnAssetLoaded::CreateLambda([this](bool bSuccess) {
-                if (bSuccess)
-                {
-                    // アセットロード成功
-                    UE_LOG(LogTemp, Log, TEXT("敵シップアセットのロードに成功しました"));
-                    
-                    // メッシュアセットを取得して設定
-                    UObject* Asset = LoadObject<UObject>(nullptr, TEXT("/Game/BlenderAssets/EnemyShip"));
-                    UStaticMesh* ShipMesh = Cast<UStaticMesh>(Asset);
-                    if (ShipMesh)
-                    {
-                        EnemyMeshComponent->SetStaticMesh(ShipMesh);
-                        UE_LOG(LogTemp, Log, TEXT("敵シップメッシュを設定しました"));
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("EnemyShipメッシュアセットが見つかりませんでした"));
-                    }
-                }
-                else
-                {
-                    // アセットロード失敗
-                    UE_LOG(LogTemp, Warning, TEXT("敵シップアセットのロードに失敗しました"));
-                }
-            })
-        );
+        // EnemyShipアセットを非同期でロードし、ロード完了時に直接メッシュを設定する
+        TWeakObjectPtr<AMCPShooterEnemy> WeakThis(this);
+        AssetManager->RequestAsset(TEXT("/Game/BlenderAssets/EnemyShip"), [WeakThis](UObject* Asset) {
+            if (!WeakThis.IsValid())
+            {
+                return;
+            }
+            
+            UStaticMesh* ShipMesh = Cast<UStaticMesh>(Asset);
+            if (ShipMesh)
+            {
+                WeakThis->EnemyMeshComponent->SetStaticMesh(ShipMesh);
+                UE_LOG(LogTemp, Verbose, TEXT("敵シップメッシュを設定しました"));
+            }
+            else if (Asset)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("EnemyShipメッシュアセットが見つかりませんでした"));
+            }
+            else
+            {
+                // アセットロード失敗
+                UE_LOG(LogTemp, Warning, TEXT("敵シップアセットのロードに失敗しました"));
+            }
+        });
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("MCPコンポーネントが初期化されていません"));
+        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
     }
 }
 
+const UMCPShooterEnemyData& AMCPShooterEnemy::GetEnemyData() const
+{
+    return EnemyData ? *EnemyData : *GetDefault<UMCPShooterEnemyData>();
+}
+
+float AMCPShooterEnemy::GetMaxHealth() const
+{
+    return GetEnemyData().MaxHealth;
+}
+
+int32 AMCPShooterEnemy::GetScoreValue() const
+{
+    return GetEnemyData().ScoreValue;
+}
+
+float AMCPShooterEnemy::GetAttackInterval() const
+{
+    return GetEnemyData().FireInterval;
+}
+
 bool AMCPShooterEnemy::CanAttack() const
 {
     // ここでは常に攻撃可能とする
@@ -270,4 +296,11 @@ void AMCPShooterEnemy::SetMoveSpeed(float NewSpeed)
     {
         MovementComponent->MaxSpeed = MoveSpeed;
     }
+    
+    // 敵マネージャーの速度も更新
+    UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    if (EnemyManager)
+    {
+        EnemyManager->SetEnemySpeed(this, MoveSpeed);
+    }
 } 
@@ -4,13 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
-#include "MCPGameplayComponent.h"
 #include "MCPShooterEnemy.generated.h"
 
 class UStaticMeshComponent;
 class UFloatingPawnMovement;
-class USceneComponent;
 class AMCPShooterProjectile;
+class UMCPShooterEnemyData;
 
 /** 敵が破壊されたときのデリゲート */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDestroyedSignature, class AMCPShooterEnemy*, DestroyedEnemy);
@@ -20,6 +19,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDestroyedSignature, class AM
  *
  * このクラスは敵の宇宙船を表現します。
  * 自動で移動し、プレイヤーに向かって攻撃を行います。
+ * 多数の敵を出すため、コンポーネントはメッシュと移動の2つだけにしています。
+ * 発射位置はシーンコンポーネントではなくデータの位置で持ち、体力・得点・射撃間隔などの
+ * 種類ごとの定数は EnemyData のデータアセットを敵の間で共有します。
  */
 UCLASS()
 class SPACESHOOTERGAME_API AMCPShooterEnemy : public APawn
@@ -61,6 +63,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Health")
 	float GetHealth() const { return Health; }
 
+	/** 最大体力値を取得 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Health")
+	float GetMaxHealth() const;
+
 	/**
 	 * ダメージを受けた時の処理
 	 * @param DamageAmount 受けるダメージ量
@@ -89,29 +95,40 @@ public:
 
 	/** 敵の得点を取得 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
-	int32 GetScoreValue() const { return ScoreValue; }
+	int32 GetScoreValue() const;
+
+	/** 敵の移動速度を取得 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	float GetMoveSpeed() const { return MoveSpeed; }
+
+	/** 敵の攻撃間隔（秒）を取得 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	float GetAttackInterval() const;
+
+	/** 種類ごとの定数（データアセットが設定されていない場合はクラスの既定値） */
+	const UMCPShooterEnemyData& GetEnemyData() const;
 
 protected:
+	friend class UMCPShooterEnemyManager;
+
 	/**
 	 * ゲーム開始時に呼び出される関数
 	 */
 	virtual void BeginPlay() override;
 
 	/**
-	 * 毎フレーム呼び出される関数
-	 * @param DeltaTime 前フレームからの経過時間
+	 * ゲーム終了時・破棄時に呼び出される関数
 	 */
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
-	 * 射撃タイマーのハンドラ
+	 * 毎フレーム呼び出される関数
+	 * @param DeltaTime 前フレームからの経過時間
 	 */
-	void FireTimerHandler();
+	virtual void Tick(float DeltaTime) override;
 
-	/**
-	 * 移動タイマーのハンドラ
-	 */
-	void MoveTimerHandler();
+	/** 敵のメッシュをBlenderアセットで設定 */
+	void SetupEnemyMesh();
 
 	/**
 	 * 敵が破壊されたときの処理
@@ -125,10 +142,6 @@ protected:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
-	/** MCPゲームプレイコンポーネント */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP")
-	UMCPGameplayComponent* MCPComponent;
-
 	/** 敵機体のメッシュコンポーネント */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* EnemyMeshComponent;
@@ -137,39 +150,24 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UFloatingPawnMovement* MovementComponent;
 
-	/** 発射位置コンポーネント */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
-	USceneComponent* ProjectileSpawnPoint;
-
 	/** 発射する弾丸のクラス */
 	UPROPERTY(EditDefaultsOnly, Category = "Shooting")
 	TSubclassOf<AMCPShooterProjectile> ProjectileClass;
 
+	/** 種類ごとの定数（同じ種類の敵で共有する） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter")
+	UMCPShooterEnemyData* EnemyData;
+
 	/** 体力値 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health", meta = (AllowPrivateAccess = "true"))
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Health", meta = (AllowPrivateAccess = "true"))
 	float Health;
 
-	/** 最大体力値 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health", meta = (AllowPrivateAccess = "true"))
-	float MaxHealth;
-
-	/** 射撃間隔（秒） */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Shooting", meta = (AllowPrivateAccess = "true"))
-	float FireInterval;
-
-	/** 移動速度 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement", meta = (AllowPrivateAccess = "true"))
+	/** 移動速度（開始時は EnemyData の値、SetMoveSpeed で変更できる） */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Movement", meta = (AllowPrivateAccess = "true"))
 	float MoveSpeed;
 
-	/** 射撃タイマーハンドル */
-	FTimerHandle FireTimerHandle;
-
-	/** 移動タイマーハンドル */
-	FTimerHandle MoveTimerHandle;
-
-	/** 得点価値 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter")
-	int32 ScoreValue;
+	/** 敵マネージャー内の配列インデックス（未登録の場合はINDEX_NONE） */
+	int32 ManagerIndex;
 
 public:
 	/** コンポーネントのゲッター */
@@ -0,0 +1,44 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MCPShooterEnemyData.generated.h"
+
+/**
+ * 敵の種類ごとの定数のデータアセット
+ *
+ * 体力・得点・射撃間隔などの種類ごとに同じ値は、敵の1体ごとに持たずにこのアセットを共有します。
+ * 敵にアセットが設定されていない場合は、このクラスの既定値が使われます。
+ */
+UCLASS(BlueprintType)
+class SPACESHOOTERGAME_API UMCPShooterEnemyData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** 最大体力値 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy", meta = (ClampMin = "1.0"))
+	float MaxHealth = 100.0f;
+
+	/** 得点価値 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy", meta = (ClampMin = "0"))
+	int32 ScoreValue = 100;
+
+	/** 射撃間隔（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy", meta = (ClampMin = "0.01"))
+	float FireInterval = 3.0f;
+
+	/** 移動速度の初期値 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy", meta = (ClampMin = "0.0"))
+	float MoveSpeed = 200.0f;
+
+	/** 攻撃力（衝突時はこの2倍のダメージ） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy", meta = (ClampMin = "0.0"))
+	float AttackDamage = 10.0f;
+
+	/** 発射位置（敵のローカル座標、向きは敵と同じ） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Enemy")
+	FVector FireOffset = FVector(100.0f, 0.0f, 0.0f);
+};
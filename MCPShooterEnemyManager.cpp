@@ -0,0 +1,1001 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterEnemy.h"
+#include "MCPShooterSteering.h"
+#include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/FloatingPawnMovement.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/StaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Manager Tick"), STAT_MCPShooterEnemyManagerTick, STATGROUP_MCP);
+DECLARE_CYCLE_STAT(TEXT("Shooter Spatial Hash Rebuild"), STAT_MCPShooterSpatialHashRebuild, STATGROUP_MCP);
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Steer"), STAT_MCPShooterEnemySteer, STATGROUP_MCP);
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Fire"), STAT_MCPShooterEnemyFire, STATGROUP_MCP);
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Significance"), STAT_MCPShooterEnemySignificance, STATGROUP_MCP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shooter Enemies"), STAT_MCPShooterEnemies, STATGROUP_MCP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shooter Significant Enemies"), STAT_MCPShooterSignificantEnemies, STATGROUP_MCP);
+
+namespace
+{
+    /** スカラー版のステアリング計算を使うかどうか（比較・デバッグ用） */
+    TAutoConsoleVariable<bool> CVarUseScalarSteering(
+        TEXT("MCP.Shooter.UseScalarSteering"),
+        false,
+        TEXT("trueの場合、敵のステアリング計算にスカラー版の参照実装を使います"));
+
+    /** 固定ステップの頻度 */
+    TAutoConsoleVariable<float> CVarFixedStepHz(
+        TEXT("MCP.Shooter.FixedStepHz"),
+        0.0f,
+        TEXT("0より大きい場合、敵と弾丸をこの頻度の固定ステップで更新します（0の場合はフレームごとの可変ステップ）"));
+
+    /** 1フレームに進める固定ステップの上限 */
+    TAutoConsoleVariable<int32> CVarMaxSubsteps(
+        TEXT("MCP.Shooter.MaxSubsteps"),
+        8,
+        TEXT("1フレームに進める固定ステップの上限（超えた分の時間は捨てます）"));
+
+    /** 重要度による間引きを使うかどうか */
+    TAutoConsoleVariable<bool> CVarUseSignificance(
+        TEXT("MCP.Shooter.Significance"),
+        true,
+        TEXT("falseの場合、重要度に関係なく全ての敵を毎フレーム更新し、射撃・衝突・影も有効にします"));
+
+    /** 敵1体あたりのメモリの予算 */
+    TAutoConsoleVariable<int32> CVarEnemyByteBudget(
+        TEXT("MCP.Shooter.EnemyByteBudget"),
+        8 * 1024,
+        TEXT("敵1体あたりのメモリの予算（バイト、MCP.Shooter.DumpEnemyMemory で超えている場合に警告します）"));
+
+    /** 登録されている敵のメモリをログに出力するコンソールコマンド */
+    FAutoConsoleCommandWithWorld DumpEnemyMemoryCommand(
+        TEXT("MCP.Shooter.DumpEnemyMemory"),
+        TEXT("敵1体あたりのメモリ（アクターとコンポーネント）と合計をログに出力します"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+        {
+            if (const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(World))
+            {
+                EnemyManager->DumpEnemyMemory();
+            }
+        }));
+
+    /** 段階が設定されていない場合の既定値（全ての処理を行う） */
+    const FMCPShooterSignificanceBucket FullSignificanceBucket;
+}
+
+UMCPShooterEnemyManager::UMCPShooterEnemyManager()
+    : RotationInterpSpeed(2.0f)
+    , FireStaggerCounter(0)
+    , SignificanceMaxDistance(6000.0f)
+    , OffScreenSignificanceScale(0.25f)
+    , OnScreenMarginDegrees(10.0f)
+    , SignificanceUpdateInterval(0.2f)
+    , NextSignificanceTime(0.0)
+    , SpatialCellSize(500.0f)
+    , SimulationTime(0.0)
+    , StepAccumulator(0.0)
+    , SimulationStepCount(0)
+    , bDeferRemovals(false)
+    , bFixedStepActive(false)
+{
+    // 近くの画面内の敵は全て処理し、中距離は間引き、遠くや画面外は射撃も止める
+    FMCPShooterSignificanceBucket NearBucket;
+    NearBucket.MinSignificance = 0.5f;
+    NearBucket.MaxEnemies = 200;
+    SignificanceBuckets.Add(NearBucket);
+
+    FMCPShooterSignificanceBucket MidBucket;
+    MidBucket.MinSignificance = 0.2f;
+    MidBucket.MaxEnemies = 500;
+    MidBucket.UpdateInterval = 0.1f;
+    MidBucket.bCastShadow = false;
+    SignificanceBuckets.Add(MidBucket);
+
+    FMCPShooterSignificanceBucket FarBucket;
+    FarBucket.UpdateInterval = 0.25f;
+    FarBucket.bCanFire = false;
+    FarBucket.bEnableCollision = false;
+    FarBucket.bCastShadow = false;
+    SignificanceBuckets.Add(FarBucket);
+}
+
+UMCPShooterEnemyManager* UMCPShooterEnemyManager::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UMCPShooterEnemyManager>() : nullptr;
+}
+
+bool UMCPShooterEnemyManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // ゲームとPIEのワールドでのみ使用する
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMCPShooterEnemyManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // -MCPFixedStepHz=60 で固定ステップを有効にする
+    float FixedStepHz = 0.0f;
+    if (FParse::Value(FCommandLine::Get(), TEXT("MCPFixedStepHz="), FixedStepHz))
+    {
+        CVarFixedStepHz->Set(FixedStepHz, ECVF_SetByCommandline);
+    }
+
+    // -MCPUncapped はエンジンのフレームも固定ステップにし、待たずに次のフレームへ進める
+    // （ヘッドレスの負荷テストを実時間より速く回すため）
+    if (FParse::Param(FCommandLine::Get(), TEXT("MCPUncapped")))
+    {
+        if (CVarFixedStepHz.GetValueOnGameThread() <= 0.0f)
+        {
+            CVarFixedStepHz->Set(60.0f, ECVF_SetByCommandline);
+        }
+
+        FApp::SetUseFixedTimeStep(true);
+        FApp::SetFixedDeltaTime(GetFixedStepSeconds());
+        UE_LOG(LogTemp, Log, TEXT("シューティングのシミュレーションを上限なしの固定ステップで実行します: %.1fHz"),
+               CVarFixedStepHz.GetValueOnGameThread());
+    }
+}
+
+void UMCPShooterEnemyManager::Deinitialize()
+{
+    for (AMCPShooterEnemy* Enemy : Enemies)
+    {
+        if (Enemy)
+        {
+            Enemy->ManagerIndex = INDEX_NONE;
+        }
+    }
+
+    Enemies.Empty();
+    Positions.Empty();
+    RelativeX.Empty();
+    RelativeY.Empty();
+    DirectionX.Empty();
+    DirectionY.Empty();
+    Headings.Empty();
+    Speeds.Empty();
+    FireIntervals.Empty();
+    NextFireTimes.Empty();
+    Significances.Empty();
+    BucketIndices.Empty();
+    UpdateCountdowns.Empty();
+    PendingMoveSeconds.Empty();
+    PendingRemovals.Empty();
+    bDeferRemovals = false;
+    DueIndicesByBucket.Empty();
+    SteerPosX.Empty();
+    SteerPosY.Empty();
+    SteerYaw.Empty();
+    SteerDirX.Empty();
+    SteerDirY.Empty();
+    SignificanceOrder.Empty();
+
+    EnemyHash.Reset();
+    HashedEnemies.Empty();
+    ProjectileHash.Reset();
+    HashedProjectiles.Empty();
+    SteppedProjectiles.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UMCPShooterEnemyManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMCPShooterEnemyManager, STATGROUP_Tickables);
+}
+
+void UMCPShooterEnemyManager::RegisterEnemy(AMCPShooterEnemy* Enemy)
+{
+    if (!IsValid(Enemy) || Enemy->ManagerIndex != INDEX_NONE)
+    {
+        return;
+    }
+
+    const double CurrentTime = GetSimulationTime();
+    const float FireInterval = Enemy->GetAttackInterval();
+
+    Enemy->ManagerIndex = Enemies.Add(Enemy);
+    Positions.Add(Enemy->GetActorLocation());
+    RelativeX.Add(0.0f);
+    RelativeY.Add(0.0f);
+    DirectionX.Add(0.0f);
+    DirectionY.Add(0.0f);
+    Headings.Add(Enemy->GetActorRotation().Yaw);
+    Speeds.Add(Enemy->GetMoveSpeed());
+    FireIntervals.Add(FireInterval);
+    NextFireTimes.Add(ComputeInitialFireTime(CurrentTime, FireInterval));
+
+    // 次の評価までは最も重要な段階として扱う
+    Significances.Add(1.0f);
+    BucketIndices.Add(MAX_uint8);
+    UpdateCountdowns.Add(0.0f);
+    PendingMoveSeconds.Add(0.0f);
+    ApplySignificanceBucket(Enemy->ManagerIndex, 0);
+
+    ApplyMovementMode(Enemy);
+}
+
+void UMCPShooterEnemyManager::UnregisterEnemy(AMCPShooterEnemy* Enemy)
+{
+    if (!Enemy || !Enemies.IsValidIndex(Enemy->ManagerIndex) || Enemies[Enemy->ManagerIndex] != Enemy)
+    {
+        return;
+    }
+
+    const int32 Index = Enemy->ManagerIndex;
+    Enemy->ManagerIndex = INDEX_NONE;
+
+    // 更新中に詰めると末尾の敵が処理済みのインデックスに移り、同じフレームに2回処理されるため、更新の終わりまで遅らせる
+    if (bDeferRemovals)
+    {
+        Enemies[Index] = nullptr;
+        PendingRemovals.Add(Index);
+        return;
+    }
+
+    RemoveEnemyAt(Index);
+}
+
+void UMCPShooterEnemyManager::RemoveEnemyAt(int32 Index)
+{
+    // 末尾の要素と入れ替えて削除（O(1)）
+    Enemies.RemoveAtSwap(Index, 1, false);
+    Positions.RemoveAtSwap(Index, 1, false);
+    RelativeX.RemoveAtSwap(Index, 1, false);
+    RelativeY.RemoveAtSwap(Index, 1, false);
+    DirectionX.RemoveAtSwap(Index, 1, false);
+    DirectionY.RemoveAtSwap(Index, 1, false);
+    Headings.RemoveAtSwap(Index, 1, false);
+    Speeds.RemoveAtSwap(Index, 1, false);
+    FireIntervals.RemoveAtSwap(Index, 1, false);
+    NextFireTimes.RemoveAtSwap(Index, 1, false);
+    Significances.RemoveAtSwap(Index, 1, false);
+    BucketIndices.RemoveAtSwap(Index, 1, false);
+    UpdateCountdowns.RemoveAtSwap(Index, 1, false);
+    PendingMoveSeconds.RemoveAtSwap(Index, 1, false);
+
+    if (Enemies.IsValidIndex(Index) && Enemies[Index])
+    {
+        Enemies[Index]->ManagerIndex = Index;
+    }
+}
+
+void UMCPShooterEnemyManager::BeginEnemyUpdate()
+{
+    bDeferRemovals = true;
+}
+
+void UMCPShooterEnemyManager::FlushPendingRemovals()
+{
+    bDeferRemovals = false;
+
+    // 大きいインデックスから取り除けば、末尾から入れ替わってくる敵はまだ取り除いていない敵にならない
+    PendingRemovals.Sort(TGreater<int32>());
+    for (int32 Index : PendingRemovals)
+    {
+        RemoveEnemyAt(Index);
+    }
+    PendingRemovals.Reset();
+}
+
+void UMCPShooterEnemyManager::SetEnemySpeed(AMCPShooterEnemy* Enemy, float NewSpeed)
+{
+    if (Enemy && Speeds.IsValidIndex(Enemy->ManagerIndex))
+    {
+        Speeds[Enemy->ManagerIndex] = NewSpeed;
+    }
+}
+
+void UMCPShooterEnemyManager::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemyManagerTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::Tick);
+    SET_DWORD_STAT(STAT_MCPShooterEnemies, Enemies.Num());
+
+    UWorld* World = GetWorld();
+
+    // プレイヤーの検索はフレームごとに1回だけ
+    APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+
+    // クライアントでは敵の移動と射撃はサーバーから複製されるため、検索用の空間ハッシュだけを更新する
+    if (World->GetNetMode() == NM_Client)
+    {
+        if (PlayerPawn)
+        {
+            GatherPositions(PlayerPawn->GetActorLocation());
+            RebuildSpatialHashes();
+        }
+        return;
+    }
+
+    const float StepSeconds = GetFixedStepSeconds();
+    const bool bFixedStep = StepSeconds > 0.0f;
+    if (bFixedStep != bFixedStepActive)
+    {
+        // 切り替え時は時刻を揃え、移動コンポーネントのティックを切り替える
+        bFixedStepActive = bFixedStep;
+        SimulationTime = World->GetTimeSeconds();
+        StepAccumulator = 0.0;
+        for (AMCPShooterEnemy* Enemy : Enemies)
+        {
+            ApplyMovementMode(Enemy);
+        }
+
+        // 固定ステップで飛んでいた弾丸は以後進まなくなるため、プールに戻す
+        if (!bFixedStep)
+        {
+            ReleaseFixedStepProjectiles();
+        }
+    }
+
+    if (bFixedStep)
+    {
+        // 経過時間を固定ステップに分割して進める（結果がフレームレートに依存しない）
+        StepAccumulator += DeltaTime;
+        const int32 MaxSubsteps = FMath::Max(1, CVarMaxSubsteps.GetValueOnGameThread());
+        int32 Substeps = 0;
+        while (StepAccumulator >= StepSeconds && Substeps < MaxSubsteps)
+        {
+            StepAccumulator -= StepSeconds;
+            StepSimulation(PlayerPawn, StepSeconds);
+            ++Substeps;
+        }
+
+        // 処理が追いつかない場合は超えた分を捨て、次のフレームに負債を持ち越さない
+        if (StepAccumulator >= StepSeconds)
+        {
+            StepAccumulator = FMath::Fmod(StepAccumulator, static_cast<double>(StepSeconds));
+        }
+
+        if (PlayerPawn)
+        {
+            GatherPositions(PlayerPawn->GetActorLocation());
+            RebuildSpatialHashes();
+            UpdateSignificance(PlayerPawn);
+        }
+        return;
+    }
+
+    if (!PlayerPawn)
+    {
+        return;
+    }
+
+    GatherPositions(PlayerPawn->GetActorLocation());
+    RebuildSpatialHashes();
+    UpdateSignificance(PlayerPawn);
+
+    if (Enemies.Num() > 0)
+    {
+        BeginEnemyUpdate();
+        UpdateSteering(DeltaTime);
+        ApplyMovementInput();
+        UpdateFiring(World->GetTimeSeconds());
+        FlushPendingRemovals();
+    }
+}
+
+float UMCPShooterEnemyManager::GetFixedStepSeconds()
+{
+    const float FixedStepHz = CVarFixedStepHz.GetValueOnGameThread();
+    return FixedStepHz > 0.0f ? 1.0f / FixedStepHz : 0.0f;
+}
+
+double UMCPShooterEnemyManager::GetSimulationTime() const
+{
+    return bFixedStepActive ? SimulationTime : GetWorld()->GetTimeSeconds();
+}
+
+void UMCPShooterEnemyManager::StepSimulation(const APawn* PlayerPawn, float StepSeconds)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::StepSimulation);
+
+    // プレイヤーがいない間も弾丸は進め、敵の移動と射撃だけを止める
+    const bool bUpdateEnemies = PlayerPawn && Enemies.Num() > 0;
+    BeginEnemyUpdate();
+    if (bUpdateEnemies)
+    {
+        GatherPositions(PlayerPawn->GetActorLocation());
+        UpdateSteering(StepSeconds);
+        IntegrateMovement();
+    }
+
+    StepProjectiles(StepSeconds);
+
+    SimulationTime += StepSeconds;
+    ++SimulationStepCount;
+
+    if (bUpdateEnemies)
+    {
+        UpdateFiring(SimulationTime);
+    }
+
+    FlushPendingRemovals();
+}
+
+void UMCPShooterEnemyManager::ApplyMovementMode(AMCPShooterEnemy* Enemy) const
+{
+    if (UFloatingPawnMovement* Movement = Enemy ? Enemy->GetMovementComponent() : nullptr)
+    {
+        Movement->SetComponentTickEnabled(!bFixedStepActive);
+        if (bFixedStepActive)
+        {
+            Movement->ConsumeInputVector();
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::DestroyAllEnemies()
+{
+    // 破棄時のEndPlayで配列が変化するため、コピーを走査する
+    const TArray<AMCPShooterEnemy*> EnemiesToDestroy = Enemies;
+    for (AMCPShooterEnemy* Enemy : EnemiesToDestroy)
+    {
+        if (IsValid(Enemy))
+        {
+            Enemy->Destroy();
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::RebuildSpatialHashes()
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterSpatialHashRebuild);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::RebuildSpatialHashes);
+
+    if (EnemyHash.GetCellSize() != SpatialCellSize)
+    {
+        EnemyHash.SetCellSize(SpatialCellSize);
+        ProjectileHash.SetCellSize(SpatialCellSize);
+    }
+
+    // 敵の位置はGatherPositionsで読み込み済み
+    HashedEnemies = Enemies;
+    EnemyHash.Build(Positions);
+
+    // 飛行中の弾丸はプールの使用中一覧から取得する
+    HashedProjectiles.Reset();
+    ProjectilePositions.Reset();
+    if (const UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this))
+    {
+        for (AMCPShooterProjectile* Projectile : ProjectilePool->GetActiveProjectiles())
+        {
+            HashedProjectiles.Add(Projectile);
+            ProjectilePositions.Add(Projectile->GetActorLocation());
+        }
+    }
+    ProjectileHash.Build(ProjectilePositions);
+}
+
+void UMCPShooterEnemyManager::ResolveEnemyHits(const TArray<int32>& Indices, TArray<AMCPShooterEnemy*>& OutEnemies) const
+{
+    OutEnemies.Reserve(OutEnemies.Num() + Indices.Num());
+    for (int32 Index : Indices)
+    {
+        // 構築後に破棄された敵は除外する
+        AMCPShooterEnemy* Enemy = HashedEnemies[Index];
+        if (IsValid(Enemy) && Enemy->ManagerIndex != INDEX_NONE)
+        {
+            OutEnemies.Add(Enemy);
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::ResolveProjectileHits(const TArray<int32>& Indices, TArray<AMCPShooterProjectile*>& OutProjectiles) const
+{
+    OutProjectiles.Reserve(OutProjectiles.Num() + Indices.Num());
+    for (int32 Index : Indices)
+    {
+        // 構築後にプールへ戻された弾丸は除外する
+        AMCPShooterProjectile* Projectile = HashedProjectiles[Index];
+        if (IsValid(Projectile) && Projectile->IsInFlight())
+        {
+            OutProjectiles.Add(Projectile);
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::QueryEnemiesInRadius(const FVector& Center, float Radius, TArray<AMCPShooterEnemy*>& OutEnemies) const
+{
+    TArray<int32> Indices;
+    EnemyHash.QueryRadius(Center, Radius, Indices);
+    ResolveEnemyHits(Indices, OutEnemies);
+}
+
+void UMCPShooterEnemyManager::QueryEnemiesInBox(const FBox& Box, TArray<AMCPShooterEnemy*>& OutEnemies) const
+{
+    TArray<int32> Indices;
+    EnemyHash.QueryBox(Box, Indices);
+    ResolveEnemyHits(Indices, OutEnemies);
+}
+
+AMCPShooterEnemy* UMCPShooterEnemyManager::FindNearestEnemy(const FVector& Center, float MaxRadius) const
+{
+    const int32 Index = EnemyHash.FindNearest(Center, MaxRadius);
+    if (Index == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    AMCPShooterEnemy* Enemy = HashedEnemies[Index];
+    return (IsValid(Enemy) && Enemy->ManagerIndex != INDEX_NONE) ? Enemy : nullptr;
+}
+
+void UMCPShooterEnemyManager::QueryProjectilesInRadius(const FVector& Center, float Radius, TArray<AMCPShooterProjectile*>& OutProjectiles) const
+{
+    TArray<int32> Indices;
+    ProjectileHash.QueryRadius(Center, Radius, Indices);
+    ResolveProjectileHits(Indices, OutProjectiles);
+}
+
+void UMCPShooterEnemyManager::QueryProjectilesInBox(const FBox& Box, TArray<AMCPShooterProjectile*>& OutProjectiles) const
+{
+    TArray<int32> Indices;
+    ProjectileHash.QueryBox(Box, Indices);
+    ResolveProjectileHits(Indices, OutProjectiles);
+}
+
+void UMCPShooterEnemyManager::GatherPositions(const FVector& PlayerLocation)
+{
+    const int32 Count = Enemies.Num();
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Positions[Index] = Enemies[Index]->GetActorLocation();
+
+        // float精度を保つため、プレイヤーを原点とした相対座標で計算する
+        const FVector Relative = Positions[Index] - PlayerLocation;
+        RelativeX[Index] = static_cast<float>(Relative.X);
+        RelativeY[Index] = static_cast<float>(Relative.Y);
+    }
+}
+
+void UMCPShooterEnemyManager::CollectDueEnemies(float DeltaTime)
+{
+    const int32 Count = Enemies.Num();
+    const int32 FallbackSlot = SignificanceBuckets.Num();
+
+    DueIndicesByBucket.SetNum(FallbackSlot + 1);
+    for (TArray<int32>& DueIndices : DueIndicesByBucket)
+    {
+        DueIndices.Reset();
+    }
+
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        // 重要度の低い敵は間引いた間の時間をまとめて移動する
+        PendingMoveSeconds[Index] += DeltaTime;
+        if (ConsumeUpdateCountdown(Index, DeltaTime))
+        {
+            const int32 Bucket = BucketIndices[Index];
+            DueIndicesByBucket[SignificanceBuckets.IsValidIndex(Bucket) ? Bucket : FallbackSlot].Add(Index);
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::UpdateSteering(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemySteer);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::UpdateSteering);
+
+    CollectDueEnemies(DeltaTime);
+
+    const bool bUseScalarSteering = CVarUseScalarSteering.GetValueOnGameThread();
+    for (int32 Slot = 0; Slot < DueIndicesByBucket.Num(); ++Slot)
+    {
+        const TArray<int32>& DueIndices = DueIndicesByBucket[Slot];
+        const int32 Count = DueIndices.Num();
+        if (Count == 0)
+        {
+            continue;
+        }
+
+        // 今回更新する敵だけを連続した配列に詰める
+        SteerPosX.SetNumUninitialized(Count, false);
+        SteerPosY.SetNumUninitialized(Count, false);
+        SteerYaw.SetNumUninitialized(Count, false);
+        SteerDirX.SetNumUninitialized(Count, false);
+        SteerDirY.SetNumUninitialized(Count, false);
+        for (int32 DueIndex = 0; DueIndex < Count; ++DueIndex)
+        {
+            const int32 Index = DueIndices[DueIndex];
+            SteerPosX[DueIndex] = RelativeX[Index];
+            SteerPosY[DueIndex] = RelativeY[Index];
+            SteerYaw[DueIndex] = Headings[Index];
+        }
+
+        // 方向・正規化・ヨー角の補間をまとめて計算する
+        MCPShooterSteering::FSteeringBatch Batch;
+        Batch.PosX = SteerPosX.GetData();
+        Batch.PosY = SteerPosY.GetData();
+        Batch.Yaw = SteerYaw.GetData();
+        Batch.OutDirX = SteerDirX.GetData();
+        Batch.OutDirY = SteerDirY.GetData();
+        Batch.Count = Count;
+
+        // 間引いた段階は更新の間隔分だけ向きを補間する
+        const float UpdateInterval = SignificanceBuckets.IsValidIndex(Slot) ? SignificanceBuckets[Slot].UpdateInterval : 0.0f;
+        const float SteerSeconds = FMath::Max(DeltaTime, UpdateInterval);
+        if (bUseScalarSteering)
+        {
+            MCPShooterSteering::SteerScalar(Batch, 0.0f, 0.0f, SteerSeconds, RotationInterpSpeed);
+        }
+        else
+        {
+            MCPShooterSteering::SteerVectorized(Batch, 0.0f, 0.0f, SteerSeconds, RotationInterpSpeed);
+        }
+
+        for (int32 DueIndex = 0; DueIndex < Count; ++DueIndex)
+        {
+            const int32 Index = DueIndices[DueIndex];
+            Headings[Index] = SteerYaw[DueIndex];
+            DirectionX[Index] = SteerDirX[DueIndex];
+            DirectionY[Index] = SteerDirY[DueIndex];
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::ApplyMovementInput()
+{
+    // 計算結果をアクターに反映する（重要度の低い敵は段階の間隔ごと）
+    for (const TArray<int32>& DueIndices : DueIndicesByBucket)
+    {
+        for (int32 Index : DueIndices)
+        {
+            // 可変ステップでは移動コンポーネントが経過時間を扱うため、溜めた時間は使わない
+            PendingMoveSeconds[Index] = 0.0f;
+            if (DirectionX[Index] == 0.0f && DirectionY[Index] == 0.0f)
+            {
+                continue;
+            }
+
+            AMCPShooterEnemy* Enemy = Enemies[Index];
+            if (!Enemy)
+            {
+                continue;
+            }
+
+            Enemy->AddMovementInput(FVector(DirectionX[Index], DirectionY[Index], 0.0f), Speeds[Index] * 0.01f);
+            Enemy->SetActorRotation(FRotator(0.0f, Headings[Index], 0.0f));
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::IntegrateMovement()
+{
+    // 移動中の衝突で破壊された敵はnullptrになるだけで、配列は更新の終わりまで詰められない
+    for (const TArray<int32>& DueIndices : DueIndicesByBucket)
+    {
+        for (int32 Index : DueIndices)
+        {
+            const float MoveSeconds = PendingMoveSeconds[Index];
+            PendingMoveSeconds[Index] = 0.0f;
+            if (DirectionX[Index] == 0.0f && DirectionY[Index] == 0.0f)
+            {
+                continue;
+            }
+
+            AMCPShooterEnemy* Enemy = Enemies[Index];
+            UFloatingPawnMovement* Movement = Enemy ? Enemy->GetMovementComponent() : nullptr;
+            if (!Movement)
+            {
+                continue;
+            }
+
+            // 可変ステップでは移動コンポーネントの加速を経て最高速度に達するため、固定ステップでは最高速度で直接移動させる
+            const FVector Velocity(DirectionX[Index] * Speeds[Index], DirectionY[Index] * Speeds[Index], 0.0f);
+            Movement->Velocity = Velocity;
+
+            FHitResult Hit;
+            Movement->SafeMoveUpdatedComponent(Velocity * MoveSeconds, FRotator(0.0f, Headings[Index], 0.0f), true, Hit);
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::StepProjectiles(float StepSeconds)
+{
+    const UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    if (!ProjectilePool)
+    {
+        return;
+    }
+
+    // 移動中の衝突でプールの使用中一覧が変わるため、写しを走査する
+    SteppedProjectiles.Reset();
+    for (AMCPShooterProjectile* Projectile : ProjectilePool->GetActiveProjectiles())
+    {
+        if (Projectile->IsFixedStepDriven())
+        {
+            SteppedProjectiles.Add(Projectile);
+        }
+    }
+
+    for (AMCPShooterProjectile* Projectile : SteppedProjectiles)
+    {
+        if (IsValid(Projectile) && Projectile->IsFixedStepDriven())
+        {
+            Projectile->StepSimulation(StepSeconds);
+        }
+    }
+}
+
+void UMCPShooterEnemyManager::ReleaseFixedStepProjectiles()
+{
+    const UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    if (!ProjectilePool)
+    {
+        return;
+    }
+
+    SteppedProjectiles.Reset();
+    for (AMCPShooterProjectile* Projectile : ProjectilePool->GetActiveProjectiles())
+    {
+        if (Projectile->IsFixedStepDriven())
+        {
+            SteppedProjectiles.Add(Projectile);
+        }
+    }
+
+    for (AMCPShooterProjectile* Projectile : SteppedProjectiles)
+    {
+        Projectile->ReturnToPool();
+    }
+}
+
+void UMCPShooterEnemyManager::UpdateFiring(double CurrentTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemyFire);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::UpdateFiring);
+
+    // 射撃の結果で破壊された敵はnullptrになる（射撃でスポーンした敵は末尾に追加されるため、毎回要素数を確認する）
+    for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+    {
+        if (!Enemies[Index] || CurrentTime < NextFireTimes[Index])
+        {
+            continue;
+        }
+
+        // 次の射撃時刻を決める（ヒッチで遅れた場合は位相を取り直す）
+        NextFireTimes[Index] += FireIntervals[Index];
+        if (NextFireTimes[Index] <= CurrentTime)
+        {
+            NextFireTimes[Index] = CurrentTime + FireIntervals[Index];
+        }
+
+        // 重要度の低い敵は射撃しない（射撃時刻は進めておき、段階が上がった時にまとめて撃たない）
+        AMCPShooterEnemy* Enemy = Enemies[Index];
+        if (GetBucketSettings(Index).bCanFire && Enemy->CanAttack())
+        {
+            Enemy->Fire();
+        }
+    }
+}
+
+float UMCPShooterEnemyManager::GetEnemySignificance(const AMCPShooterEnemy* Enemy) const
+{
+    return (Enemy && Significances.IsValidIndex(Enemy->ManagerIndex)) ? Significances[Enemy->ManagerIndex] : 0.0f;
+}
+
+int32 UMCPShooterEnemyManager::GetEnemySignificanceBucket(const AMCPShooterEnemy* Enemy) const
+{
+    return (Enemy && BucketIndices.IsValidIndex(Enemy->ManagerIndex)) ? BucketIndices[Enemy->ManagerIndex] : INDEX_NONE;
+}
+
+const FMCPShooterSignificanceBucket& UMCPShooterEnemyManager::GetBucketSettings(int32 Index) const
+{
+    const int32 Bucket = BucketIndices[Index];
+    return SignificanceBuckets.IsValidIndex(Bucket) ? SignificanceBuckets[Bucket] : FullSignificanceBucket;
+}
+
+bool UMCPShooterEnemyManager::ConsumeUpdateCountdown(int32 Index, float DeltaTime)
+{
+    const float Interval = GetBucketSettings(Index).UpdateInterval;
+    if (Interval <= 0.0f)
+    {
+        return true;
+    }
+
+    UpdateCountdowns[Index] -= DeltaTime;
+    if (UpdateCountdowns[Index] > 0.0f)
+    {
+        return false;
+    }
+
+    // 間隔の位相を保ちつつ、大きく遅れた場合は取り直す
+    UpdateCountdowns[Index] = FMath::Max(UpdateCountdowns[Index] + Interval, 0.0f);
+    return true;
+}
+
+void UMCPShooterEnemyManager::UpdateSignificance(const APawn* PlayerPawn)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemySignificance);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterEnemyManager::UpdateSignificance);
+
+    const int32 Count = Enemies.Num();
+
+    // サーバーでは1人のプレイヤーの画面で他のプレイヤーから見える敵を間引けないため、ローカルのゲームでのみ使う
+    const bool bUseSignificance = CVarUseSignificance.GetValueOnGameThread() && SignificanceBuckets.Num() > 0
+        && GetWorld()->GetNetMode() == NM_Standalone;
+
+    // 無効化された場合は全ての敵を最も重要な段階に戻す
+    if (!bUseSignificance)
+    {
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Significances[Index] = 1.0f;
+            ApplySignificanceBucket(Index, 0);
+        }
+        SET_DWORD_STAT(STAT_MCPShooterSignificantEnemies, Count);
+        return;
+    }
+
+    // 評価は一定間隔ごと（段階の切り替えでコンポーネントの状態が変わるため、毎フレームは行わない）
+    const double CurrentTime = GetSimulationTime();
+    if (CurrentTime < NextSignificanceTime)
+    {
+        return;
+    }
+    NextSignificanceTime = CurrentTime + SignificanceUpdateInterval;
+
+    // 視点はプレイヤーのカメラ（取得できない場合はポーン）
+    FVector ViewLocation = PlayerPawn->GetActorLocation();
+    FRotator ViewRotation = PlayerPawn->GetActorRotation();
+    float HalfFovDegrees = 45.0f;
+    if (const APlayerController* PlayerController = Cast<APlayerController>(PlayerPawn->GetController()))
+    {
+        PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+        if (PlayerController->PlayerCameraManager)
+        {
+            HalfFovDegrees = PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f;
+        }
+    }
+
+    // 画面内の判定は水平視野角の円錐で近似する（縦方向は広めに判定される）
+    const FVector ViewForward = ViewRotation.Vector();
+    const float CosHalfFov = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfFovDegrees + OnScreenMarginDegrees, 0.0f, 180.0f)));
+    const float InvMaxDistance = SignificanceMaxDistance > 0.0f ? 1.0f / SignificanceMaxDistance : 0.0f;
+
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        // 距離はステアリングと同じプレイヤーからの相対座標で求める
+        const float Distance = FMath::Sqrt(RelativeX[Index] * RelativeX[Index] + RelativeY[Index] * RelativeY[Index]);
+        const float DistanceScore = 1.0f - FMath::Clamp(Distance * InvMaxDistance, 0.0f, 1.0f);
+
+        const FVector ToEnemy = (Positions[Index] - ViewLocation).GetSafeNormal();
+        const bool bOnScreen = FVector::DotProduct(ToEnemy, ViewForward) >= CosHalfFov;
+
+        Significances[Index] = bOnScreen ? DistanceScore : DistanceScore * OffScreenSignificanceScale;
+    }
+
+    // 重要度の高い順に段階の上限まで割り当てる
+    SignificanceOrder.Reset(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        SignificanceOrder.Add(Index);
+    }
+    SignificanceOrder.Sort([this](int32 A, int32 B)
+    {
+        return Significances[A] > Significances[B];
+    });
+
+    const int32 BucketCount = FMath::Min(SignificanceBuckets.Num(), static_cast<int32>(MAX_uint8));
+    TArray<int32, TInlineAllocator<8>> BucketFill;
+    BucketFill.SetNumZeroed(BucketCount);
+
+    for (int32 Index : SignificanceOrder)
+    {
+        int32 NewBucket = BucketCount - 1;
+        for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+        {
+            const FMCPShooterSignificanceBucket& Settings = SignificanceBuckets[Bucket];
+            if (Significances[Index] >= Settings.MinSignificance && (Settings.MaxEnemies <= 0 || BucketFill[Bucket] < Settings.MaxEnemies))
+            {
+                NewBucket = Bucket;
+                break;
+            }
+        }
+
+        ++BucketFill[NewBucket];
+        ApplySignificanceBucket(Index, NewBucket);
+    }
+
+    SET_DWORD_STAT(STAT_MCPShooterSignificantEnemies, BucketCount > 0 ? BucketFill[0] : 0);
+}
+
+void UMCPShooterEnemyManager::ApplySignificanceBucket(int32 Index, int32 NewBucket)
+{
+    if (BucketIndices[Index] == NewBucket)
+    {
+        return;
+    }
+
+    BucketIndices[Index] = static_cast<uint8>(NewBucket);
+    const FMCPShooterSignificanceBucket& Settings = GetBucketSettings(Index);
+
+    // 更新のタイミングが揃わないように、間隔内で位相をずらす
+    UpdateCountdowns[Index] = Settings.UpdateInterval * FMath::Frac(static_cast<float>(Index) * 0.61803398875f);
+
+    AMCPShooterEnemy* Enemy = Enemies[Index];
+    if (UStaticMeshComponent* Mesh = Enemy->GetEnemyMeshComponent())
+    {
+        Mesh->SetCollisionEnabled(Settings.bEnableCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+        Mesh->SetCastShadow(Settings.bCastShadow);
+    }
+
+    // 可変ステップでは移動コンポーネント自体のティックも段階の間隔に合わせる
+    if (UFloatingPawnMovement* Movement = Enemy->GetMovementComponent())
+    {
+        Movement->SetComponentTickInterval(Settings.UpdateInterval);
+    }
+}
+
+SIZE_T UMCPShooterEnemyManager::CountEnemyBytes(AMCPShooterEnemy* Enemy)
+{
+    if (!Enemy)
+    {
+        return 0;
+    }
+
+    // UObjectのシリアライズで数えるため、UObject本体の大きさも含まれる
+    SIZE_T Bytes = FArchiveCountMem(Enemy).GetMax();
+    for (UActorComponent* Component : Enemy->GetComponents())
+    {
+        Bytes += FArchiveCountMem(Component).GetMax();
+    }
+    return Bytes;
+}
+
+void UMCPShooterEnemyManager::DumpEnemyMemory() const
+{
+    if (Enemies.Num() == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("敵のメモリ: 登録されている敵はいません"));
+        return;
+    }
+
+    SIZE_T TotalBytes = 0;
+    SIZE_T MaxBytes = 0;
+    for (AMCPShooterEnemy* Enemy : Enemies)
+    {
+        const SIZE_T Bytes = CountEnemyBytes(Enemy);
+        TotalBytes += Bytes;
+        MaxBytes = FMath::Max(MaxBytes, Bytes);
+    }
+
+    // 内訳は最初の敵で代表させる（同じクラスであれば構成は同じ）
+    AMCPShooterEnemy* Sample = Enemies[0];
+    UE_LOG(LogTemp, Log, TEXT("敵のメモリ: %d 体 / 合計 %.1f KB / 平均 %llu バイト / 最大 %llu バイト / コンポーネント %d 個"),
+           Enemies.Num(), TotalBytes / 1024.0, static_cast<uint64>(TotalBytes / Enemies.Num()), static_cast<uint64>(MaxBytes),
+           Sample->GetComponents().Num());
+    UE_LOG(LogTemp, Log, TEXT("  %s: %llu バイト"), *Sample->GetClass()->GetName(), static_cast<uint64>(FArchiveCountMem(Sample).GetMax()));
+    for (UActorComponent* Component : Sample->GetComponents())
+    {
+        UE_LOG(LogTemp, Log, TEXT("  %s (%s): %llu バイト"), *Component->GetName(), *Component->GetClass()->GetName(),
+               static_cast<uint64>(FArchiveCountMem(Component).GetMax()));
+    }
+
+    const int32 BudgetBytes = CVarEnemyByteBudget.GetValueOnGameThread();
+    if (BudgetBytes > 0 && MaxBytes > static_cast<SIZE_T>(BudgetBytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("敵1体あたりのメモリ（最大 %llu バイト）が予算 %d バイトを超えています"), static_cast<uint64>(MaxBytes), BudgetBytes);
+    }
+}
+
+double UMCPShooterEnemyManager::ComputeInitialFireTime(double CurrentTime, float FireInterval)
+{
+    // 黄金比による低食い違い列で最初の射撃を [0.5, 1.0) × 射撃間隔 に分散させる
+    const float Phase = FMath::Frac(static_cast<float>(FireStaggerCounter++) * 0.61803398875f);
+    return CurrentTime + FireInterval * (0.5f + 0.5f * Phase);
+}
@@ -0,0 +1,447 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MCPShooterSpatialHash.h"
+#include "MCPShooterEnemyManager.generated.h"
+
+class AMCPShooterEnemy;
+class AMCPShooterProjectile;
+class APawn;
+
+/**
+ * 敵の重要度の段階
+ *
+ * 重要度（プレイヤーからの距離と画面内かどうかで決まる0〜1の値）が
+ * MinSignificance 以上の敵がこの段階に入ります。段階は配列の先頭から順に判定し、
+ * MaxEnemies を超えた分は次の段階に回します。
+ */
+USTRUCT(BlueprintType)
+struct FMCPShooterSignificanceBucket
+{
+	GENERATED_BODY()
+
+	/** この段階に入る重要度の下限 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	float MinSignificance = 0.0f;
+
+	/** この段階に入れる敵の上限（0の場合は無制限） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	int32 MaxEnemies = 0;
+
+	/** 移動と向きを更新する間隔（秒、0の場合は毎フレーム） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	float UpdateInterval = 0.0f;
+
+	/** 射撃するかどうか */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	bool bCanFire = true;
+
+	/** メッシュの衝突を有効にするかどうか */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	bool bEnableCollision = true;
+
+	/** メッシュの影を描画するかどうか */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MCP|Shooter|Significance")
+	bool bCastShadow = true;
+};
+
+/**
+ * シューティングゲームの敵マネージャー
+ *
+ * 敵ごとのタイマーの代わりに、全ての敵の移動と射撃を1フレーム1回の
+ * まとめた処理で更新します。敵の状態は連続した配列（SoA）で保持し、
+ * プレイヤーの検索もフレームごとに1回だけ行います。
+ * また、敵と飛行中の弾丸の空間ハッシュを毎フレーム構築し、
+ * ワールド全体を走査せずに範囲検索できるようにします。
+ * 敵は重要度の段階に分けられ、遠くや画面外の敵は移動の更新間隔を延ばし、
+ * 衝突・影・射撃を止めて、画面に映っている分だけのコストで済むようにします。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API UMCPShooterEnemyManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	UMCPShooterEnemyManager();
+
+	/** ワールドから敵マネージャーを取得する */
+	static UMCPShooterEnemyManager* Get(const UObject* WorldContextObject);
+
+	/** USubsystemの実装 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObjectの実装 */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * 敵を登録する
+	 * @param Enemy 登録する敵
+	 */
+	void RegisterEnemy(AMCPShooterEnemy* Enemy);
+
+	/**
+	 * 敵の登録を解除する
+	 * 敵の更新中に呼ばれた場合は配列の要素をnullptrにしておき、更新の終わりにまとめて詰めます。
+	 * @param Enemy 登録を解除する敵
+	 */
+	void UnregisterEnemy(AMCPShooterEnemy* Enemy);
+
+	/** 敵が撃破された時のデリゲート（撃破された敵） */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyKilled, AMCPShooterEnemy* /*Enemy*/);
+
+	/**
+	 * 敵の撃破を通知する（撃破された敵から呼ばれる）
+	 * スポーンした敵ごとにデリゲートを登録する代わりに、ここで1回だけ購読します。
+	 * @param Enemy 撃破された敵
+	 */
+	void NotifyEnemyKilled(AMCPShooterEnemy* Enemy) { EnemyKilled.Broadcast(Enemy); }
+
+	/** 敵が撃破された時のデリゲート */
+	FOnEnemyKilled& OnEnemyKilled() { return EnemyKilled; }
+
+	/**
+	 * 敵の移動速度を更新する
+	 * @param Enemy 対象の敵
+	 * @param NewSpeed 新しい移動速度
+	 */
+	void SetEnemySpeed(AMCPShooterEnemy* Enemy, float NewSpeed);
+
+	/** 登録されている敵の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	int32 GetEnemyCount() const { return Enemies.Num(); }
+
+	/** 登録されている敵の一覧（敵の更新中は登録を解除した敵の分がnullptrになります） */
+	const TArray<AMCPShooterEnemy*>& GetEnemies() const { return Enemies; }
+
+	/**
+	 * 敵1体が使っているメモリを数える
+	 * アクターとコンポーネントのUObject本体の大きさに、それぞれが確保している配列などの大きさを加えたもの。
+	 * @param Enemy 対象の敵
+	 * @return バイト数
+	 */
+	static SIZE_T CountEnemyBytes(AMCPShooterEnemy* Enemy);
+
+	/**
+	 * 登録されている敵のメモリをログに出力する（MCP.Shooter.DumpEnemyMemory）
+	 * 1体あたりの大きさが MCP.Shooter.EnemyByteBudget を超えている場合は警告します。
+	 */
+	void DumpEnemyMemory() const;
+
+	/**
+	 * 固定ステップの長さ（秒）
+	 * MCP.Shooter.FixedStepHz が0の場合は可変ステップとして0を返します。
+	 */
+	static float GetFixedStepSeconds();
+
+	/** シミュレーションの現在時刻（固定ステップの場合はステップ数から求めた時刻） */
+	double GetSimulationTime() const;
+
+	/** 固定ステップで進めたステップの総数 */
+	uint64 GetSimulationStepCount() const { return SimulationStepCount; }
+
+	/**
+	 * 敵の重要度を取得する
+	 * @param Enemy 対象の敵
+	 * @return 直近の評価時点の重要度（0〜1、未登録の場合は0）
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Significance")
+	float GetEnemySignificance(const AMCPShooterEnemy* Enemy) const;
+
+	/**
+	 * 敵の重要度の段階を取得する
+	 * @param Enemy 対象の敵
+	 * @return SignificanceBuckets のインデックス（未登録の場合はINDEX_NONE）
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Significance")
+	int32 GetEnemySignificanceBucket(const AMCPShooterEnemy* Enemy) const;
+
+	/** 登録されている全ての敵を破棄する */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter")
+	void DestroyAllEnemies();
+
+	/**
+	 * 球の範囲内にいる敵を検索する
+	 * 位置は直近の敵マネージャー更新時点のものです。
+	 * @param Center 中心
+	 * @param Radius 半径
+	 * @param OutEnemies 見つかった敵
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Query")
+	void QueryEnemiesInRadius(const FVector& Center, float Radius, TArray<AMCPShooterEnemy*>& OutEnemies) const;
+
+	/**
+	 * ボックスの範囲内にいる敵を検索する
+	 * @param Box 検索範囲
+	 * @param OutEnemies 見つかった敵
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Query")
+	void QueryEnemiesInBox(const FBox& Box, TArray<AMCPShooterEnemy*>& OutEnemies) const;
+
+	/**
+	 * 最も近い敵を検索する
+	 * @param Center 検索の中心
+	 * @param MaxRadius 検索する最大距離
+	 * @return 見つかった敵（見つからない場合はnullptr）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Query")
+	AMCPShooterEnemy* FindNearestEnemy(const FVector& Center, float MaxRadius) const;
+
+	/**
+	 * 球の範囲内にある飛行中の弾丸を検索する
+	 * 対象はプール管理下の弾丸です。
+	 * @param Center 中心
+	 * @param Radius 半径
+	 * @param OutProjectiles 見つかった弾丸
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Query")
+	void QueryProjectilesInRadius(const FVector& Center, float Radius, TArray<AMCPShooterProjectile*>& OutProjectiles) const;
+
+	/**
+	 * ボックスの範囲内にある飛行中の弾丸を検索する
+	 * @param Box 検索範囲
+	 * @param OutProjectiles 見つかった弾丸
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Query")
+	void QueryProjectilesInBox(const FBox& Box, TArray<AMCPShooterProjectile*>& OutProjectiles) const;
+
+protected:
+	/** USubsystemの実装 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * 配列から敵を取り除く（末尾の要素と入れ替える）
+	 * @param Index 敵の配列インデックス
+	 */
+	void RemoveEnemyAt(int32 Index);
+
+	/** 敵の更新を始める（以降の登録解除は FlushPendingRemovals まで遅らせる） */
+	void BeginEnemyUpdate();
+
+	/** 敵の更新中に登録を解除された敵を配列から取り除く */
+	void FlushPendingRemovals();
+
+	/**
+	 * 全ての敵の位置を配列に読み込む
+	 * @param PlayerLocation プレイヤーの位置（相対座標の原点）
+	 */
+	void GatherPositions(const FVector& PlayerLocation);
+
+	/**
+	 * 移動の更新時期に達した敵を段階ごとに集める（DueIndicesByBucket）
+	 * @param DeltaTime 前フレームからの経過時間
+	 */
+	void CollectDueEnemies(float DeltaTime);
+
+	/**
+	 * 今回更新する敵の移動方向と向きを段階ごとにまとめて計算する
+	 * @param DeltaTime 前フレームからの経過時間
+	 */
+	void UpdateSteering(float DeltaTime);
+
+	/** 計算した移動方向を移動コンポーネントへの入力として反映する（可変ステップ） */
+	void ApplyMovementInput();
+
+	/** 計算した移動方向と向きで敵を直接移動させる（固定ステップ） */
+	void IntegrateMovement();
+
+	/**
+	 * 固定ステップで更新する弾丸を1ステップ進める
+	 * @param StepSeconds ステップの長さ（秒）
+	 */
+	void StepProjectiles(float StepSeconds);
+
+	/** 固定ステップで飛んでいる弾丸を全てプールに戻す（可変ステップへの切り替え時） */
+	void ReleaseFixedStepProjectiles();
+
+	/**
+	 * 固定ステップ1回分のシミュレーションを進める
+	 * @param PlayerPawn プレイヤー（いない場合は弾丸のみ進める）
+	 * @param StepSeconds ステップの長さ（秒）
+	 */
+	void StepSimulation(const APawn* PlayerPawn, float StepSeconds);
+
+	/**
+	 * 敵の移動コンポーネントのティックを固定ステップの設定に合わせる
+	 * 固定ステップの場合は敵マネージャーが直接移動させるため無効にします。
+	 */
+	void ApplyMovementMode(AMCPShooterEnemy* Enemy) const;
+
+	/**
+	 * 全ての敵の重要度を評価し、段階を割り当てる
+	 * @param PlayerPawn プレイヤー（視点の取得に使用）
+	 */
+	void UpdateSignificance(const APawn* PlayerPawn);
+
+	/**
+	 * 重要度の段階の設定を敵のコンポーネントに反映する
+	 * @param Index 敵の配列インデックス
+	 * @param NewBucket 新しい段階
+	 */
+	void ApplySignificanceBucket(int32 Index, int32 NewBucket);
+
+	/** 敵の段階の設定を取得する（段階が設定されていない場合は全ての処理を行う既定値） */
+	const FMCPShooterSignificanceBucket& GetBucketSettings(int32 Index) const;
+
+	/**
+	 * 移動の更新時期に達したかどうかを判定し、次の更新までの時間を進める
+	 * @param Index 敵の配列インデックス
+	 * @param DeltaTime 経過時間
+	 * @return 今回更新する場合はtrue
+	 */
+	bool ConsumeUpdateCountdown(int32 Index, float DeltaTime);
+
+	/**
+	 * 射撃時刻に達した敵に射撃させる
+	 * @param CurrentTime 現在のワールド時間
+	 */
+	void UpdateFiring(double CurrentTime);
+
+	/** 敵と弾丸の空間ハッシュを再構築する */
+	void RebuildSpatialHashes();
+
+	/** 検索結果のインデックスを有効な敵に変換する */
+	void ResolveEnemyHits(const TArray<int32>& Indices, TArray<AMCPShooterEnemy*>& OutEnemies) const;
+
+	/** 検索結果のインデックスを飛行中の弾丸に変換する */
+	void ResolveProjectileHits(const TArray<int32>& Indices, TArray<AMCPShooterProjectile*>& OutProjectiles) const;
+
+	/** 新しく登録された敵の最初の射撃時刻を決める（射撃タイミングを分散させる） */
+	double ComputeInitialFireTime(double CurrentTime, float FireInterval);
+
+	/** 向きの補間速度 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter")
+	float RotationInterpSpeed;
+
+	/** 登録されている敵（以下の配列と同じ順序） */
+	UPROPERTY()
+	TArray<AMCPShooterEnemy*> Enemies;
+
+	/** 敵の位置 */
+	TArray<FVector> Positions;
+
+	/** プレイヤーからの相対X座標（ステアリング計算用） */
+	TArray<float> RelativeX;
+
+	/** プレイヤーからの相対Y座標（ステアリング計算用） */
+	TArray<float> RelativeY;
+
+	/** 正規化された移動方向のX成分 */
+	TArray<float> DirectionX;
+
+	/** 正規化された移動方向のY成分 */
+	TArray<float> DirectionY;
+
+	/** 敵の向き（ヨー角、度） */
+	TArray<float> Headings;
+
+	/** 敵の移動速度 */
+	TArray<float> Speeds;
+
+	/** 敵の射撃間隔（秒） */
+	TArray<float> FireIntervals;
+
+	/** 敵の次の射撃時刻 */
+	TArray<double> NextFireTimes;
+
+	/** 射撃タイミング分散用のカウンター */
+	uint32 FireStaggerCounter;
+
+	/** 重要度の段階（重要度の高い順） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Significance")
+	TArray<FMCPShooterSignificanceBucket> SignificanceBuckets;
+
+	/** 重要度が0になるプレイヤーからの距離 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Significance")
+	float SignificanceMaxDistance;
+
+	/** 画面外の敵の重要度に掛ける係数 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Significance")
+	float OffScreenSignificanceScale;
+
+	/** 画面内の判定で視野角に加える余裕（度） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Significance")
+	float OnScreenMarginDegrees;
+
+	/** 重要度を評価し直す間隔（秒） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Significance")
+	float SignificanceUpdateInterval;
+
+	/** 敵の重要度（0〜1） */
+	TArray<float> Significances;
+
+	/** 敵の重要度の段階（SignificanceBuckets のインデックス、登録直後はMAX_uint8） */
+	TArray<uint8> BucketIndices;
+
+	/** 次に移動を更新するまでの時間（秒） */
+	TArray<float> UpdateCountdowns;
+
+	/** 固定ステップで移動を間引いている間に溜まった時間（秒） */
+	TArray<float> PendingMoveSeconds;
+
+	/** 今回移動を更新する敵のインデックス（段階ごと、末尾は段階が設定されていない敵） */
+	TArray<TArray<int32>> DueIndicesByBucket;
+
+	/** ステアリング計算用の作業配列（今回更新する敵の分だけ詰めたもの） */
+	TArray<float> SteerPosX;
+	TArray<float> SteerPosY;
+	TArray<float> SteerYaw;
+	TArray<float> SteerDirX;
+	TArray<float> SteerDirY;
+
+	/** 重要度を次に評価する時刻 */
+	double NextSignificanceTime;
+
+	/** 重要度の評価用の作業配列（重要度の高い順に並べた敵のインデックス） */
+	TArray<int32> SignificanceOrder;
+
+	/** 空間ハッシュのセルの一辺の長さ */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Query")
+	float SpatialCellSize;
+
+	/** 敵の空間ハッシュ */
+	FMCPShooterSpatialHash EnemyHash;
+
+	/** 空間ハッシュ構築時点の敵（EnemyHashのインデックスに対応） */
+	UPROPERTY()
+	TArray<AMCPShooterEnemy*> HashedEnemies;
+
+	/** 弾丸の空間ハッシュ */
+	FMCPShooterSpatialHash ProjectileHash;
+
+	/** 空間ハッシュ構築時点の弾丸（ProjectileHashのインデックスに対応） */
+	UPROPERTY()
+	TArray<AMCPShooterProjectile*> HashedProjectiles;
+
+	/** 弾丸の位置（空間ハッシュ構築用の作業配列） */
+	TArray<FVector> ProjectilePositions;
+
+	/** 固定ステップで更新する弾丸（ステップ中の作業配列） */
+	TArray<AMCPShooterProjectile*> SteppedProjectiles;
+
+	/** シミュレーションの現在時刻（固定ステップの場合） */
+	double SimulationTime;
+
+	/** まだステップとして消化していない経過時間 */
+	double StepAccumulator;
+
+	/** 固定ステップで進めたステップの総数 */
+	uint64 SimulationStepCount;
+
+	/** 敵の更新中かどうか（登録解除を遅らせる） */
+	bool bDeferRemovals;
+
+	/** 敵の更新中に登録を解除された敵のインデックス */
+	TArray<int32> PendingRemovals;
+
+	/** 直近の更新で固定ステップを使ったかどうか */
+	bool bFixedStepActive;
+
+	/** 敵が撃破された時のデリゲート */
+	FOnEnemyKilled EnemyKilled;
+};
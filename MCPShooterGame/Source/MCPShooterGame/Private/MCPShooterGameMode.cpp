@@ -7,6 +7,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Spawn"), STAT_MCPShooterEnemySpawn, STATGROUP_MCP);
 
 AMCPShooterGameMode::AMCPShooterGameMode()
     : EnemySpawnInterval(2.0f)
@@ -143,6 +146,9 @@ void AMCPShooterGameMode::SetEnemySpawnInterval(float NewInterval)
 
 void AMCPShooterGameMode::SpawnEnemy()
 {
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemySpawn);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AMCPShooterGameMode::SpawnEnemy);
+    
     if (!bGameStarted || bGameOver)
     {
         return;
@@ -231,83 +237,28 @@ void AMCPShooterGameMode::LoadBlenderAssets()
         return;
     }
     
-    // サーバー接続を確認
-    AssetManager->CheckServerConnection([this](bool bSuccess, const FString& Message) {
-        if (bSuccess)
-        {
-            UE_LOG(LogTemp, Log, TEXT("MCPサーバーに接続しました: %s"), *Message);
-            
-            // プレイヤーシップアセットをインポート
-            ImportPlayerShipAsset();
-            
-            // 敵シップアセットをインポート
-            ImportEnemyShipAsset();
-            
-            // プロジェクタイルアセットをインポート
-            ImportProjectileAsset();
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("MCPサーバーに接続できませんでした: %s"), *Message);
-        }
-    });
-}
-
-void AMCPShooterGameMode::ImportPlayerShipAsset()
-{
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
-    {
-        AssetManager->ImportBlenderModel("exports/PlayerShip.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
-                if (Result.bSuccess)
-                {
-                    UE_LOG(LogTemp, Log, TEXT("プレイヤーシップアセットのインポートに成功しました: %s"), *Result.AssetPath);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("プレイヤーシップアセットのインポートに失敗しました"));
-                }
-            });
-    }
-}
-
-void AMCPShooterGameMode::ImportEnemyShipAsset()
-{
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
-    {
-        AssetManager->ImportBlenderModel("exports/EnemyShip.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
-                if (Result.bSuccess)
-                {
-                    UE_LOG(LogTemp, Log, TEXT("敵シップアセットのインポートに成功しました: %s"), *Result.AssetPath);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("敵シップアセットのインポートに失敗しました"));
-                }
-            });
-    }
-}
-
-void AMCPShooterGameMode::ImportProjectileAsset()
-{
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
-    {
-        AssetManager->ImportBlenderModel("exports/Projectile.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
+    // プレイヤーシップ、敵シップ、プロジェクタイルを1回のリクエストでインポート
+    // （接続できない場合はバッチ自体が失敗するため、事前の接続確認は行わない）
+    const TArray<FString> ModelPaths = {
+        TEXT("exports/PlayerShip.fbx"),
+        TEXT("exports/EnemyShip.fbx"),
+        TEXT("exports/Projectile.fbx")
+    };
+    
+    AssetManager->ImportBlenderModels(ModelPaths, TEXT("/Game/BlenderAssets"), false,
+        [](const TArray<FMCPAssetImportResult>& Results) {
+            for (const FMCPAssetImportResult& Result : Results)
+            {
                 if (Result.bSuccess)
                 {
-                    UE_LOG(LogTemp, Log, TEXT("プロジェクタイルアセットのインポートに成功しました: %s"), *Result.AssetPath);
+                    UE_LOG(LogTemp, Log, TEXT("アセットのインポートに成功しました: %s"), *Result.AssetPath);
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("プロジェクタイルアセットのインポートに失敗しました"));
+                    UE_LOG(LogTemp, Warning, TEXT("%s"), *Result.ErrorMessage);
                 }
-            });
-    }
+            }
+        });
 }
 
 void AMCPShooterGameMode::OnEnemyDestroyed(AMCPShooterEnemy* DestroyedEnemy)
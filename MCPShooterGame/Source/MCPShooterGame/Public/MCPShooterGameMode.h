@@ -102,14 +102,4 @@ protected:
     /** 敵が倒された時のイベントハンドラ */
     UFUNCTION()
     void OnEnemyDestroyed(class AMCPShooterEnemy* DestroyedEnemy);
-    
-protected:
-    /** プレイヤーシップアセットをインポートする */
-    void ImportPlayerShipAsset();
-    
-    /** 敵シップアセットをインポートする */
-    void ImportEnemyShipAsset();
-    
-    /** プロジェクタイルアセットをインポートする */
-    void ImportProjectileAsset();
 }; 
@@ -1,8 +1,15 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPShooterGameMode.h"
+#include "MCPShooterGameState.h"
 #include "MCPShooterCharacter.h"
 #include "MCPShooterEnemy.h"
+#include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
+#include "MCPShooterProjectileVisualCache.h"
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterBulletSystem.h"
+#include "MCPShooterWaveData.h"
 #include "MCPAssetManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
@@ -10,32 +17,63 @@
 #include "MCPShooterPlayerController.h"
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/PlayerController.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Misc/CommandLine.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Enemy Spawn"), STAT_MCPShooterEnemySpawn, STATGROUP_MCP);
+DECLARE_CYCLE_STAT(TEXT("Shooter Wave Update"), STAT_MCPShooterWaveUpdate, STATGROUP_MCP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shooter Wave Spawns"), STAT_MCPShooterWaveSpawns, STATGROUP_MCP);
 
 AMCPShooterGameMode::AMCPShooterGameMode()
     : Super()
     , EnemySpawnInterval(3.0f)
     , MaxEnemies(10)
-    , CurrentEnemies(0)
     , bGameStarted(false)
     , bGameOver(false)
     , SpawnWidth(1000.0f)
     , SpawnHeight(500.0f)
     , SpawnDistance(1500.0f)
+    , PlayerProjectilePrewarmCount(32)
+    , EnemyProjectilePrewarmCount(64)
+    , RandomSeed(20240601)
+    , WaveData(nullptr)
+    , WaveSpawnBudgetMs(1.0f)
+    , MaxWaveSpawnsPerFrame(16)
+    , CurrentWaveIndex(INDEX_NONE)
+    , WaveSpawnedCount(0)
+    , WaveStartTime(0.0)
+    , LastWaveEndTime(0.0)
+    , WaveOrigin(FVector::ZeroVector)
+    , bWaveActive(false)
 {
     // デフォルトのポーンクラスを設定
     DefaultPawnClass = AMCPShooterCharacter::StaticClass();
     
-    // 初期スコアを設定
-    Score = 0;
+    // スコアと敵の数はゲームステートで管理し、クライアントへ複製する
+    GameStateClass = AMCPShooterGameState::StaticClass();
     
     // ゲームは毎フレーム更新
     PrimaryActorTick.bCanEverTick = true;
+    
+    // プールで使用するデフォルトの弾丸クラス
+    static ConstructorHelpers::FClassFinder<AMCPShooterProjectile> ProjectileClassFinder(TEXT("/Game/Blueprints/BP_MCPShooterProjectile"));
+    if (ProjectileClassFinder.Succeeded())
+    {
+        PooledProjectileClass = ProjectileClassFinder.Class;
+    }
 }
 
 void AMCPShooterGameMode::BeginPlay()
 {
     Super::BeginPlay();
     
+    // 撃破の通知は敵ごとではなく敵マネージャーで1回だけ購読する
+    if (UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this))
+    {
+        EnemyManager->OnEnemyKilled().AddUObject(this, &AMCPShooterGameMode::OnEnemyDestroyed);
+    }
+    
     // ゲーム開始の準備
     StartGame();
 }
@@ -43,20 +81,36 @@ void AMCPShooterGameMode::BeginPlay()
 void AMCPShooterGameMode::StartGame()
 {
     // ゲーム状態を初期化
-    Score = 0;
-    CurrentEnemies = 0;
     bGameStarted = true;
     bGameOver = false;
     
+    // スポーン位置の乱数を初期化（同じシードならリスタート後も同じ順序になる）
+    FParse::Value(FCommandLine::Get(), TEXT("MCPShooterSeed="), RandomSeed);
+    SpawnStream.Initialize(RandomSeed);
+    
     // Blenderアセットをロード
     LoadBlenderAssets();
     // スコアをリセット
-    CurrentScore = 0;
-    CurrentEnemyCount = 0;
+    if (AMCPShooterGameState* ShooterGameState = GetShooterGameState())
+    {
+        ShooterGameState->ResetScore();
+    }
     
     // プレイヤーキャラクターをスポーン
     SpawnPlayerCharacter();
     
+    // 発射時のスポーンを避けるため弾丸を事前生成
+    PrewarmProjectilePool();
+    
+    // ウェーブが設定されている場合は、タイマーの代わりに毎フレームのウェーブ更新でスポーンする
+    CurrentWaveIndex = INDEX_NONE;
+    bWaveActive = false;
+    LastWaveEndTime = GetWorld()->GetTimeSeconds();
+    if (WaveData && WaveData->Waves.Num() > 0)
+    {
+        return;
+    }
+    
     // 敵のスポーンを開始
     GetWorldTimerManager().SetTimer(
         EnemySpawnTimerHandle,
@@ -79,16 +133,19 @@ void AMCPShooterGameMode::GameOver()
     bGameOver = true;
     bGameStarted = false;
     
-    // 敵のスポーンタイマーを停止
+    // 敵のスポーンタイマーとウェーブを停止
     GetWorldTimerManager().ClearTimer(EnemySpawnTimerHandle);
+    bWaveActive = false;
     
     // 既存の敵を全て破棄（オプション）
-    TArray<AActor*> FoundEnemies;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMCPShooterEnemy::StaticClass(), FoundEnemies);
-    
-    for (AActor* Enemy : FoundEnemies)
+    // 敵マネージャーの登録一覧を使い、ワールド全体の走査を避ける
+    if (UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this))
     {
-        Enemy->Destroy();
+        EnemyManager->DestroyAllEnemies();
+    }
+    if (UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::Get(this))
+    {
+        BulletSystem->ClearBullets();
     }
     
     // ゲームオーバー画面の表示など
@@ -112,8 +169,22 @@ void AMCPShooterGameMode::RestartGame()
 
 void AMCPShooterGameMode::AddScore(int32 Points)
 {
-    Score += Points;
-    // スコア更新イベントがある場合はここで発火
+    // スコア更新イベントはゲームステートがフレームの最後にまとめて発火する
+    if (AMCPShooterGameState* ShooterGameState = GetShooterGameState())
+    {
+        ShooterGameState->AddScore(Points);
+    }
+}
+
+int32 AMCPShooterGameMode::GetScore() const
+{
+    const AMCPShooterGameState* ShooterGameState = GetShooterGameState();
+    return ShooterGameState ? ShooterGameState->GetScore() : 0;
+}
+
+AMCPShooterGameState* AMCPShooterGameMode::GetShooterGameState() const
+{
+    return GetGameState<AMCPShooterGameState>();
 }
 
 void AMCPShooterGameMode::SetEnemySpawnInterval(float NewInterval)
@@ -140,7 +211,99 @@ void AMCPShooterGameMode::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
     
-    // ゲームロジックの追加処理があればここに実装
+    UpdateWaves();
+}
+
+void AMCPShooterGameMode::UpdateWaves()
+{
+    if (!WaveData || WaveData->Waves.Num() == 0 || !bGameStarted || bGameOver)
+    {
+        return;
+    }
+    
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterWaveUpdate);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AMCPShooterGameMode::UpdateWaves);
+    
+    const double Now = GetWorld()->GetTimeSeconds();
+    const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    const int32 EnemyCount = EnemyManager ? EnemyManager->GetEnemyCount() : 0;
+    
+    if (!bWaveActive)
+    {
+        int32 NextWaveIndex = CurrentWaveIndex + 1;
+        if (!WaveData->Waves.IsValidIndex(NextWaveIndex))
+        {
+            if (!WaveData->bLoop)
+            {
+                return;
+            }
+            NextWaveIndex = 0;
+        }
+        
+        const FMCPShooterWaveDefinition& NextWave = WaveData->Waves[NextWaveIndex];
+        if (Now < LastWaveEndTime + NextWave.StartDelay || (NextWave.bWaitForClear && EnemyCount > 0))
+        {
+            return;
+        }
+        
+        BeginWave(NextWaveIndex);
+    }
+    
+    const FMCPShooterWaveDefinition& Wave = WaveData->Waves[CurrentWaveIndex];
+    UClass* SpawnClass = Wave.EnemyClass ? Wave.EnemyClass.Get() : EnemyClass.Get();
+    if (!SpawnClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ウェーブ %d の敵クラスが設定されていません"), CurrentWaveIndex);
+        bWaveActive = false;
+        LastWaveEndTime = Now;
+        return;
+    }
+    
+    // スポーン位置は重ならないように計算済みのため、重なりの判定をせずにスポーンする
+    // 1フレームの予算を超えた分は次のフレームに回す（時間がかかっても最低1体は進める）
+    const double BudgetEndTime = FPlatformTime::Seconds() + WaveSpawnBudgetMs / 1000.0;
+    const int32 SpawnLimit = FMath::Min(Wave.SpawnSlots.Num(), WaveSpawnedCount + MaxWaveSpawnsPerFrame);
+    const int32 FirstSpawnIndex = WaveSpawnedCount;
+    int32 AliveCount = EnemyCount;
+    while (WaveSpawnedCount < SpawnLimit && AliveCount < MaxEnemyCount)
+    {
+        if (Now < WaveStartTime + WaveSpawnedCount * Wave.SpawnInterval)
+        {
+            break;
+        }
+        if (WaveSpawnedCount > FirstSpawnIndex && FPlatformTime::Seconds() >= BudgetEndTime)
+        {
+            break;
+        }
+        
+        SpawnEnemy(SpawnClass, WaveOrigin + Wave.SpawnSlots[WaveSpawnedCount], ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        ++WaveSpawnedCount;
+        ++AliveCount;
+    }
+    SET_DWORD_STAT(STAT_MCPShooterWaveSpawns, WaveSpawnedCount - FirstSpawnIndex);
+    
+    if (WaveSpawnedCount >= Wave.SpawnSlots.Num())
+    {
+        bWaveActive = false;
+        LastWaveEndTime = Now;
+    }
+}
+
+void AMCPShooterGameMode::BeginWave(int32 WaveIndex)
+{
+    const FMCPShooterWaveDefinition& Wave = WaveData->Waves[WaveIndex];
+    
+    // 隊形の基準はウェーブ開始時のプレイヤーの位置で固定する（スポーン中に隊形が崩れないように）
+    const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+    const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+    
+    CurrentWaveIndex = WaveIndex;
+    WaveSpawnedCount = 0;
+    WaveStartTime = GetWorld()->GetTimeSeconds();
+    WaveOrigin = PlayerLocation + Wave.Offset;
+    bWaveActive = true;
+    
+    UE_LOG(LogTemp, Log, TEXT("ウェーブ %d を開始します: 敵 %d 体"), WaveIndex, Wave.SpawnSlots.Num());
 }
 
 void AMCPShooterGameMode::SpawnEnemyTimerHandler()
@@ -150,8 +313,9 @@ void AMCPShooterGameMode::SpawnEnemyTimerHandler()
         return;
     }
     
-    // 最大敵数をチェック
-    if (CurrentEnemyCount >= MaxEnemyCount)
+    // 最大敵数をチェック（敵マネージャーの登録一覧が唯一の正しい数）
+    const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    if (EnemyManager && EnemyManager->GetEnemyCount() >= MaxEnemyCount)
     {
         return;
     }
@@ -170,34 +334,35 @@ void AMCPShooterGameMode::SpawnEnemyTimerHandler()
         FVector PlayerLocation = PlayerPawn->GetActorLocation();
         
         // 生成位置をランダムに決定
-        float RandomX = FMath::FRandRange(-SpawnWidth/2, SpawnWidth/2);
-        float RandomY = FMath::FRandRange(-SpawnHeight/2, SpawnHeight/2);
+        float RandomX = SpawnStream.FRandRange(-SpawnWidth/2, SpawnWidth/2);
+        float RandomY = SpawnStream.FRandRange(-SpawnHeight/2, SpawnHeight/2);
         
         // プレイヤーの前方に敵を生成
         FVector SpawnLocation = PlayerLocation + FVector(SpawnDistance, RandomX, RandomY);
         
-        // 敵を生成
-        AMCPShooterEnemy* Enemy = SpawnEnemy(SpawnLocation);
-        if (Enemy)
-        {
-            CurrentEnemyCount++;
-            
-            // 敵が破壊された時のデリゲートを設定
-            Enemy->OnEnemyDestroyed.AddDynamic(this, &AMCPShooterGameMode::OnEnemyDestroyed);
-        }
+        // 敵を生成（撃破の通知は敵マネージャーから受け取る）
+        SpawnEnemy(SpawnLocation);
     }
 }
 
 AMCPShooterEnemy* AMCPShooterGameMode::SpawnEnemy(const FVector& SpawnLocation)
 {
+    return SpawnEnemy(EnemyClass, SpawnLocation, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+}
+
+AMCPShooterEnemy* AMCPShooterGameMode::SpawnEnemy(UClass* SpawnClass, const FVector& SpawnLocation, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterEnemySpawn);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AMCPShooterGameMode::SpawnEnemy);
+    
     // 敵を生成
     FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    SpawnParams.SpawnCollisionHandlingOverride = CollisionHandling;
     
     // 向きはプレイヤーの方向を向くように設定
     FRotator SpawnRotation = FRotator(0.0f, 180.0f, 0.0f);
     
-    return GetWorld()->SpawnActor<AMCPShooterEnemy>(EnemyClass, SpawnLocation, SpawnRotation, SpawnParams);
+    return GetWorld()->SpawnActor<AMCPShooterEnemy>(SpawnClass, SpawnLocation, SpawnRotation, SpawnParams);
 }
 
 AActor* AMCPShooterGameMode::SpawnPlayerCharacter()
@@ -232,106 +397,67 @@ AActor* AMCPShooterGameMode::SpawnPlayerCharacter()
     return nullptr;
 }
 
-void AMCPShooterGameMode::LoadBlenderAssets()
+void AMCPShooterGameMode::PrewarmProjectilePool()
 {
-    // MCPアセットマネージャーを取得
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (!AssetManager)
+    UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    if (!ProjectilePool || !PooledProjectileClass)
     {
-        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーを取得できませんでした"));
+        UE_LOG(LogTemp, Warning, TEXT("弾丸プールの事前生成をスキップしました"));
         return;
     }
     
-    // サーバー接続を確認
-    AssetManager->CheckServerConnection([this](bool bSuccess, const FString& Message) {
-        if (bSuccess)
-        {
-            UE_LOG(LogTemp, Log, TEXT("MCPサーバーに接続しました: %s"), *Message);
-            
-            // プレイヤーシップアセットをインポート
-            ImportPlayerShipAsset();
-            
-            // 敵シップアセットをインポート
-            ImportEnemyShipAsset();
-            
-            // プロジェクタイルアセットをインポート
-            ImportProjectileAsset();
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("MCPサーバーに接続できませんでした: %s"), *Message);
-        }
-    });
-}
-
-void AMCPShooterGameMode::ImportPlayerShipAsset()
-{
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
-    {
-        AssetManager->ImportBlenderModel("exports/PlayerShip.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
-                if (Result.bSuccess)
-                {
-                    UE_LOG(LogTemp, Log, TEXT("プレイヤーシップアセットのインポートに成功しました: %s"), *Result.AssetPath);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("プレイヤーシップアセットのインポートに失敗しました"));
-                }
-            });
-    }
+    ProjectilePool->Prewarm(PooledProjectileClass, false, PlayerProjectilePrewarmCount);
+    ProjectilePool->Prewarm(PooledProjectileClass, true, EnemyProjectilePrewarmCount);
 }
 
-void AMCPShooterGameMode::ImportEnemyShipAsset()
+void AMCPShooterGameMode::LoadBlenderAssets()
 {
+    // MCPアセットマネージャーを取得
     UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
+    if (!AssetManager)
     {
-        AssetManager->ImportBlenderModel("exports/EnemyShip.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
-                if (Result.bSuccess)
-                {
-                    UE_LOG(LogTemp, Log, TEXT("敵シップアセットのインポートに成功しました: %s"), *Result.AssetPath);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("敵シップアセットのインポートに失敗しました"));
-                }
-            });
+        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーを取得できませんでした"));
+        return;
     }
-}
-
-void AMCPShooterGameMode::ImportProjectileAsset()
-{
-    UMCPAssetManager* AssetManager = UMCPAssetManager::Get();
-    if (AssetManager)
-    {
-        AssetManager->ImportBlenderModel("exports/Projectile.fbx", "/Game/BlenderAssets", 
-            [](const FMCPAssetImportResult& Result) {
+    
+    // プレイヤーシップ、敵シップ、プロジェクタイルを1回のリクエストでインポート
+    // （接続できない場合はバッチ自体が失敗するため、事前の接続確認は行わない）
+    const TArray<FString> ModelPaths = {
+        TEXT("exports/PlayerShip.fbx"),
+        TEXT("exports/EnemyShip.fbx"),
+        TEXT("exports/Projectile.fbx")
+    };
+    
+    TWeakObjectPtr<AMCPShooterGameMode> WeakThis(this);
+    AssetManager->ImportBlenderModels(ModelPaths, TEXT("/Game/BlenderAssets"), false,
+        [WeakThis](const TArray<FMCPAssetImportResult>& Results) {
+            for (const FMCPAssetImportResult& Result : Results)
+            {
                 if (Result.bSuccess)
                 {
-                    UE_LOG(LogTemp, Log, TEXT("プロジェクタイルアセットのインポートに成功しました: %s"), *Result.AssetPath);
+                    UE_LOG(LogTemp, Log, TEXT("アセットのインポートに成功しました: %s"), *Result.AssetPath);
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("プロジェクタイルアセットのインポートに失敗しました"));
+                    UE_LOG(LogTemp, Warning, TEXT("%s"), *Result.ErrorMessage);
                 }
-            });
-    }
+            }
+            
+            // プールの事前生成時に弾丸メッシュが未インポートだった場合は、ここで見た目を解決し直す
+            UMCPShooterProjectileVisualCache* VisualCache = WeakThis.IsValid() ? UMCPShooterProjectileVisualCache::Get(WeakThis.Get()) : nullptr;
+            if (VisualCache)
+            {
+                VisualCache->RefreshVisuals();
+            }
+        });
 }
 
 void AMCPShooterGameMode::OnEnemyDestroyed(AMCPShooterEnemy* DestroyedEnemy)
 {
-    // 敵が倒されたときのカウント処理
-    if (CurrentEnemyCount > 0)
+    // 撃破とスコアをゲームステートに記録する（敵の数は敵マネージャーから反映される）
+    AMCPShooterGameState* ShooterGameState = GetShooterGameState();
+    if (ShooterGameState && DestroyedEnemy)
     {
-        CurrentEnemyCount--;
-        
-        // 破壊された敵のスコア値を追加
-        if (DestroyedEnemy)
-        {
-            AddScore(DestroyedEnemy->GetScoreValue());
-        }
+        ShooterGameState->RecordEnemyKill(DestroyedEnemy->GetScoreValue());
     }
 } 
@@ -4,9 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "Math/RandomStream.h"
 #include "MCPShooterGameMode.generated.h"
 
 class AMCPShooterEnemy;
+class AMCPShooterProjectile;
+class AMCPShooterGameState;
+class UMCPShooterWaveData;
 
 /**
  * MCPシューティングゲームモード
@@ -28,6 +32,7 @@ public:
 
 	/**
 	 * スコアを追加する関数
+	 * スコアはゲームステートが管理し、フレームの最後にまとめて反映されます。
 	 * @param Points 追加するスコアポイント
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game")
@@ -38,7 +43,10 @@ public:
 	 * @return 現在のスコア
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Game")
-	int32 GetScore() const { return Score; }
+	int32 GetScore() const;
+
+	/** シューティングゲームのゲームステートを取得する */
+	AMCPShooterGameState* GetShooterGameState() const;
 
 	/** 敵をスポーンする間隔を設定する */
 	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter")
@@ -50,7 +58,7 @@ public:
 
 	/** ゲームオーバー処理 */
 	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter")
-	void GameOver();
+	virtual void GameOver();
 
 	/** ゲームがスタートしたかどうか */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
@@ -60,6 +68,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
 	bool IsGameOver() const { return bGameOver; }
 
+	/** 現在（または直前）のウェーブの位置（ウェーブを使っていない場合はINDEX_NONE） */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Wave")
+	int32 GetCurrentWaveIndex() const { return CurrentWaveIndex; }
+
 protected:
 	/**
 	 * ゲーム開始時に呼び出される関数
@@ -92,6 +104,24 @@ protected:
 	 */
 	AMCPShooterEnemy* SpawnEnemy(const FVector& SpawnLocation);
 
+	/**
+	 * 敵を生成する関数
+	 * @param SpawnClass 敵のクラス
+	 * @param SpawnLocation 生成位置
+	 * @param CollisionHandling 生成位置が他と重なる場合の処理
+	 * @return 生成された敵
+	 */
+	AMCPShooterEnemy* SpawnEnemy(UClass* SpawnClass, const FVector& SpawnLocation, ESpawnActorCollisionHandlingMethod CollisionHandling);
+
+	/** ウェーブを進め、予算の範囲で敵をスポーンする（毎フレーム） */
+	void UpdateWaves();
+
+	/**
+	 * ウェーブを開始する
+	 * @param WaveIndex 開始するウェーブの位置
+	 */
+	void BeginWave(int32 WaveIndex);
+
 	/** 敵のスポーンタイマーハンドラ */
 	FTimerHandle EnemySpawnTimerHandle;
 
@@ -111,14 +141,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter")
 	FVector EnemySpawnLocation;
 
-	/** 現在のスコア */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP|Shooter")
-	int32 CurrentScore;
-
-	/** 現在スポーンされている敵の数 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP|Shooter")
-	int32 CurrentEnemyCount;
-
 	/** ゲームがスタートしたかどうか */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP|Shooter")
 	bool bGameStarted;
@@ -138,11 +160,59 @@ protected:
 	/** Blenderアセットをロードする */
 	void LoadBlenderAssets();
 
-private:
-	/** 現在のスコア */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game", meta = (AllowPrivateAccess = "true"))
-	int32 Score;
+	/** 弾丸プールを事前生成する */
+	void PrewarmProjectilePool();
 
+	/** プールで事前生成する弾丸のクラス */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Pool")
+	TSubclassOf<AMCPShooterProjectile> PooledProjectileClass;
+
+	/** プレイヤーの弾丸の事前生成数 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Pool")
+	int32 PlayerProjectilePrewarmCount;
+
+	/** 敵の弾丸の事前生成数 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Pool")
+	int32 EnemyProjectilePrewarmCount;
+
+	/** 敵のスポーン位置の乱数シード（-MCPShooterSeed= で上書きできます） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter")
+	int32 RandomSeed;
+
+	/** 敵のスポーン位置の乱数（同じシードなら同じ順序でスポーンする） */
+	FRandomStream SpawnStream;
+
+	/** ウェーブの定義（設定した場合はタイマーによるスポーンの代わりにウェーブでスポーンする） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Wave")
+	UMCPShooterWaveData* WaveData;
+
+	/** 1フレームでウェーブの敵のスポーンに使う時間の上限（ミリ秒、1フレームに最低1体はスポーンする） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "0.0"))
+	float WaveSpawnBudgetMs;
+
+	/** 1フレームにスポーンするウェーブの敵の上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "1"))
+	int32 MaxWaveSpawnsPerFrame;
+
+	/** 現在（または直前）のウェーブの位置 */
+	int32 CurrentWaveIndex;
+
+	/** 現在のウェーブでスポーンした敵の数 */
+	int32 WaveSpawnedCount;
+
+	/** 現在のウェーブの開始時刻（ゲーム時間） */
+	double WaveStartTime;
+
+	/** 直前のウェーブのスポーンが終わった時刻（ゲーム時間） */
+	double LastWaveEndTime;
+
+	/** 現在のウェーブの隊形の中心（開始時のプレイヤーの位置が基準） */
+	FVector WaveOrigin;
+
+	/** ウェーブのスポーン中かどうか */
+	bool bWaveActive;
+
+private:
 	/** 敵の生成間隔（秒） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Spawning", meta = (AllowPrivateAccess = "true"))
 	float EnemySpawnInterval;
@@ -151,10 +221,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Spawning", meta = (AllowPrivateAccess = "true"))
 	int32 MaxEnemies;
 
-	/** 現在存在する敵の数 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy Spawning", meta = (AllowPrivateAccess = "true"))
-	int32 CurrentEnemies;
-
 	/** 敵の生成クラス */
 	UPROPERTY(EditDefaultsOnly, Category = "Enemy Spawning")
 	TSubclassOf<AMCPShooterEnemy> EnemyClass;
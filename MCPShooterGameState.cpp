@@ -0,0 +1,146 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterGameState.h"
+#include "MCPShooterEnemyManager.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+AMCPShooterGameState::AMCPShooterGameState()
+    : PendingScore(0)
+    , PendingKills(0)
+    , MaxSpawnEventsPerBatch(64)
+{
+    // 敵の撃破や移動が終わった後、フレームの最後にまとめて反映する
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+}
+
+AMCPShooterGameState* AMCPShooterGameState::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetGameState<AMCPShooterGameState>() : nullptr;
+}
+
+void AMCPShooterGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AMCPShooterGameState, ScoreState);
+}
+
+void AMCPShooterGameState::AddScore(int32 Points)
+{
+    if (HasAuthority())
+    {
+        PendingScore += Points;
+    }
+}
+
+void AMCPShooterGameState::RecordEnemyKill(int32 Points)
+{
+    if (HasAuthority())
+    {
+        PendingScore += Points;
+        ++PendingKills;
+    }
+}
+
+void AMCPShooterGameState::ResetScore()
+{
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    PendingScore = 0;
+    PendingKills = 0;
+    ScoreState.Score = 0;
+    ScoreState.KillCount = 0;
+}
+
+void AMCPShooterGameState::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (HasAuthority())
+    {
+        FlushPendingScore();
+        FlushProjectileSpawns();
+    }
+}
+
+void AMCPShooterGameState::QueueProjectileSpawn(const FMCPShooterProjectileSpawnEvent& SpawnEvent)
+{
+    if (HasAuthority())
+    {
+        PendingProjectileSpawns.Add(SpawnEvent);
+    }
+}
+
+void AMCPShooterGameState::FlushProjectileSpawns()
+{
+    if (PendingProjectileSpawns.Num() == 0)
+    {
+        return;
+    }
+
+    // 1回のRPCが大きくなりすぎないように分割して送る
+    const int32 BatchSize = FMath::Max(1, MaxSpawnEventsPerBatch);
+    for (int32 Start = 0; Start < PendingProjectileSpawns.Num(); Start += BatchSize)
+    {
+        const int32 Count = FMath::Min(BatchSize, PendingProjectileSpawns.Num() - Start);
+        SpawnEventBatch.Reset();
+        SpawnEventBatch.Append(PendingProjectileSpawns.GetData() + Start, Count);
+        MulticastProjectileSpawns(SpawnEventBatch);
+    }
+    PendingProjectileSpawns.Reset();
+}
+
+void AMCPShooterGameState::MulticastProjectileSpawns_Implementation(const TArray<FMCPShooterProjectileSpawnEvent>& SpawnEvents)
+{
+    // サーバーでは発射時に弾丸を追加済み
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    UMCPShooterBulletSystem* BulletSystem = UMCPShooterBulletSystem::Get(this);
+    if (!BulletSystem)
+    {
+        return;
+    }
+
+    const float ServerTime = static_cast<float>(GetServerWorldTimeSeconds());
+    for (const FMCPShooterProjectileSpawnEvent& SpawnEvent : SpawnEvents)
+    {
+        BulletSystem->SpawnReplicatedBullet(SpawnEvent, ServerTime - SpawnEvent.FireTime);
+    }
+}
+
+void AMCPShooterGameState::FlushPendingScore()
+{
+    // 敵の数は敵マネージャーの登録一覧が正しい値を持つため、毎フレーム読み取るだけにする
+    const UMCPShooterEnemyManager* EnemyManager = UMCPShooterEnemyManager::Get(this);
+    ScoreState.Score += PendingScore;
+    ScoreState.KillCount += PendingKills;
+    ScoreState.EnemyCount = EnemyManager ? EnemyManager->GetEnemyCount() : 0;
+    PendingScore = 0;
+    PendingKills = 0;
+
+    // 変化がなければ通知しない（複製もプロパティが変わった時だけ行われる）
+    OnRep_ScoreState();
+}
+
+void AMCPShooterGameState::OnRep_ScoreState()
+{
+    const int32 ScoreDelta = ScoreState.Score - LastNotifiedState.Score;
+    const int32 KillDelta = ScoreState.KillCount - LastNotifiedState.KillCount;
+    if (ScoreDelta == 0 && KillDelta == 0 && ScoreState.EnemyCount == LastNotifiedState.EnemyCount)
+    {
+        return;
+    }
+
+    // クライアントでは複製の間隔ごとに、その間の変化がまとめて1回通知される
+    LastNotifiedState = ScoreState;
+    OnScoreChanged.Broadcast(ScoreState.Score, ScoreDelta, KillDelta, ScoreState.EnemyCount);
+}
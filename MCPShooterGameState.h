@@ -0,0 +1,144 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "MCPShooterBulletSystem.h"
+#include "MCPShooterGameState.generated.h"
+
+/** スコアや敵の数が変化したときのデリゲート（1フレームに最大1回） */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnShooterScoreChangedSignature, int32, NewScore, int32, ScoreDelta, int32, KillDelta, int32, NewEnemyCount);
+
+/**
+ * 複製されるスコアの状態
+ *
+ * スコア・撃破数・敵の数を1つの構造体にまとめて複製し、
+ * クライアントでは1回の更新で全ての値が揃って届くようにします。
+ */
+USTRUCT(BlueprintType)
+struct FMCPShooterScoreState
+{
+	GENERATED_BODY()
+
+	/** 現在のスコア */
+	UPROPERTY(BlueprintReadOnly, Category = "MCP|Shooter")
+	int32 Score = 0;
+
+	/** 撃破した敵の数 */
+	UPROPERTY(BlueprintReadOnly, Category = "MCP|Shooter")
+	int32 KillCount = 0;
+
+	/** 現在存在する敵の数 */
+	UPROPERTY(BlueprintReadOnly, Category = "MCP|Shooter")
+	int32 EnemyCount = 0;
+};
+
+/**
+ * シューティングゲームのゲームステート
+ *
+ * スコアと敵の数の唯一の管理場所です。サーバーでは撃破やスコアの加算を
+ * フレーム内で溜めておき、フレームの最後に1回だけ複製用の状態へ反映して
+ * OnScoreChanged を発行します。クライアントには通常のプロパティ複製で届くため、
+ * 撃破ごとのRPCは発生しません。
+ * 弾丸の発射も同様に、フレーム内の発射イベントをまとめた1回の
+ * マルチキャストで送り、クライアントが弾丸システムで再現します。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API AMCPShooterGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	AMCPShooterGameState();
+
+	/** ワールドからゲームステートを取得する */
+	static AMCPShooterGameState* Get(const UObject* WorldContextObject);
+
+	/**
+	 * スコアを加算する（サーバーのみ、フレームの最後にまとめて反映）
+	 * @param Points 加算するスコア
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "MCP|Shooter")
+	void AddScore(int32 Points);
+
+	/**
+	 * 敵の撃破を記録する（サーバーのみ、フレームの最後にまとめて反映）
+	 * @param Points 撃破で得られるスコア
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "MCP|Shooter")
+	void RecordEnemyKill(int32 Points);
+
+	/**
+	 * 弾丸の発射イベントをクライアントへ送る（サーバーのみ、フレームの最後にまとめて送信）
+	 * @param SpawnEvent 発射イベント
+	 */
+	void QueueProjectileSpawn(const FMCPShooterProjectileSpawnEvent& SpawnEvent);
+
+	/** スコアと撃破数を0に戻す（サーバーのみ） */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "MCP|Shooter")
+	void ResetScore();
+
+	/** 現在のスコア（反映前の加算分を含まない） */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	int32 GetScore() const { return ScoreState.Score; }
+
+	/** 撃破した敵の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	int32 GetKillCount() const { return ScoreState.KillCount; }
+
+	/** 現在存在する敵の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	int32 GetEnemyCount() const { return ScoreState.EnemyCount; }
+
+	/** スコアや敵の数が変化したときに呼ばれるデリゲート（HUDの更新用） */
+	UPROPERTY(BlueprintAssignable, Category = "MCP|Shooter")
+	FOnShooterScoreChangedSignature OnScoreChanged;
+
+	/** AActorの実装 */
+	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	/** 溜まった加算分を複製用の状態に反映する（サーバーのみ） */
+	void FlushPendingScore();
+
+	/** 溜まった発射イベントをクライアントへ送る（サーバーのみ） */
+	void FlushProjectileSpawns();
+
+	/**
+	 * 発射イベントをまとめて受け取る（クライアント）
+	 * 信頼性なしで送るため、失われた弾丸は見た目に表示されないだけです（判定はサーバーで行う）。
+	 * @param SpawnEvents 発射イベント
+	 */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileSpawns(const TArray<FMCPShooterProjectileSpawnEvent>& SpawnEvents);
+
+	/** 複製された状態を受け取ったときの処理（クライアント） */
+	UFUNCTION()
+	void OnRep_ScoreState();
+
+	/** 複製されるスコアの状態 */
+	UPROPERTY(ReplicatedUsing = OnRep_ScoreState, VisibleAnywhere, BlueprintReadOnly, Category = "MCP|Shooter")
+	FMCPShooterScoreState ScoreState;
+
+	/** 前回通知した状態（クライアントでの差分計算用） */
+	FMCPShooterScoreState LastNotifiedState;
+
+	/** このフレームで加算されたスコア */
+	int32 PendingScore;
+
+	/** このフレームで撃破された敵の数 */
+	int32 PendingKills;
+
+	/** 1回のマルチキャストで送る発射イベントの上限（超えた分は複数回に分ける） */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Network")
+	int32 MaxSpawnEventsPerBatch;
+
+	/** このフレームで発射された弾丸のイベント */
+	TArray<FMCPShooterProjectileSpawnEvent> PendingProjectileSpawns;
+
+	/** 送信用の作業配列 */
+	TArray<FMCPShooterProjectileSpawnEvent> SpawnEventBatch;
+};
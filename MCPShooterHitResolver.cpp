@@ -0,0 +1,214 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterHitResolver.h"
+#include "MCPShooterCharacter.h"
+#include "MCPShooterEnemy.h"
+#include "MCPShooterProjectile.h"
+#include "MCPShooterProjectilePool.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+#include "HAL/IConsoleManager.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Projectile Hit Resolve"), STAT_MCPShooterProjectileHitResolve, STATGROUP_MCP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shooter Projectile Traces"), STAT_MCPShooterProjectileTraces, STATGROUP_MCP);
+
+namespace
+{
+    /** プールの弾丸の衝突を非同期スイープで判定するかどうか */
+    TAutoConsoleVariable<bool> CVarAsyncProjectileHits(
+        TEXT("MCP.Shooter.AsyncProjectileHits"),
+        true,
+        TEXT("trueの場合、プールの弾丸の衝突をOnComponentHitではなく非同期スイープでまとめて判定します（発射時に反映）"));
+}
+
+UMCPShooterHitResolver::UMCPShooterHitResolver()
+    : MaxImpactEffectsPerFrame(32)
+    , ImpactEffectsThisFrame(0)
+{
+}
+
+UMCPShooterHitResolver* UMCPShooterHitResolver::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UMCPShooterHitResolver>() : nullptr;
+}
+
+bool UMCPShooterHitResolver::IsEnabled()
+{
+    return CVarAsyncProjectileHits.GetValueOnGameThread();
+}
+
+bool UMCPShooterHitResolver::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // ゲームとPIEのワールドでのみ使用する
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMCPShooterHitResolver::Deinitialize()
+{
+    PendingTraces.Empty();
+    Hits.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UMCPShooterHitResolver::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMCPShooterHitResolver, STATGROUP_Tickables);
+}
+
+void UMCPShooterHitResolver::ApplyProjectileDamage(AActor* HitActor, AActor* DamageCauser, float Damage, bool bEnemyProjectile)
+{
+    if (!HitActor)
+    {
+        return;
+    }
+
+    FDamageEvent DamageEvent;
+    if (bEnemyProjectile)
+    {
+        // 敵の弾丸はプレイヤーにのみダメージ
+        if (AMCPShooterCharacter* PlayerCharacter = Cast<AMCPShooterCharacter>(HitActor))
+        {
+            PlayerCharacter->TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
+        }
+    }
+    else
+    {
+        // プレイヤーの弾丸は敵にのみダメージ
+        if (AMCPShooterEnemy* Enemy = Cast<AMCPShooterEnemy>(HitActor))
+        {
+            Enemy->TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
+        }
+    }
+}
+
+void UMCPShooterHitResolver::EmitImpactEffects(const AMCPShooterProjectile* Projectile, const FVector& Location, const FRotator& Rotation)
+{
+    UParticleSystem* ImpactEffect = Projectile ? Projectile->GetImpactEffect() : nullptr;
+    USoundBase* ImpactSound = Projectile ? Projectile->GetImpactSound() : nullptr;
+    if ((!ImpactEffect && !ImpactSound) || ImpactEffectsThisFrame >= MaxImpactEffectsPerFrame)
+    {
+        return;
+    }
+    ++ImpactEffectsThisFrame;
+
+    UWorld* World = GetWorld();
+    if (ImpactEffect)
+    {
+        // 再生が終わったコンポーネントはワールドのプールに戻り、次の着弾で再利用される
+        UGameplayStatics::SpawnEmitterAtLocation(World, ImpactEffect, Location, Rotation, FVector::OneVector, true, EPSCPoolMethod::AutoRelease);
+    }
+    if (ImpactSound)
+    {
+        UGameplayStatics::PlaySoundAtLocation(World, ImpactSound, Location);
+    }
+}
+
+void UMCPShooterHitResolver::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPShooterProjectileHitResolve);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPShooterHitResolver::Tick);
+
+    ImpactEffectsThisFrame = 0;
+
+    GatherHits();
+    ApplyHits();
+    IssueTraces();
+
+    SET_DWORD_STAT(STAT_MCPShooterProjectileTraces, PendingTraces.Num());
+}
+
+void UMCPShooterHitResolver::GatherHits()
+{
+    UWorld* World = GetWorld();
+
+    Hits.Reset();
+    for (const FPendingProjectileTrace& Pending : PendingTraces)
+    {
+        FTraceDatum TraceDatum;
+        if (!World->QueryTraceData(Pending.Handle, TraceDatum))
+        {
+            continue;
+        }
+
+        const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+        if (BlockingHit)
+        {
+            FProjectileHit& ProjectileHit = Hits.AddDefaulted_GetRef();
+            ProjectileHit.Projectile = Pending.Projectile;
+            ProjectileHit.ActivationSerial = Pending.ActivationSerial;
+            ProjectileHit.Hit = *BlockingHit;
+        }
+    }
+    PendingTraces.Reset();
+}
+
+void UMCPShooterHitResolver::ApplyHits()
+{
+    for (const FProjectileHit& ProjectileHit : Hits)
+    {
+        // スイープの発行後にプールへ戻されて別の発射に使われた弾丸は対象外
+        AMCPShooterProjectile* Projectile = ProjectileHit.Projectile.Get();
+        if (!Projectile || !Projectile->IsAsyncHitDriven() || Projectile->ActivationSerial != ProjectileHit.ActivationSerial)
+        {
+            continue;
+        }
+
+        AActor* HitActor = ProjectileHit.Hit.GetActor();
+        if (HitActor == Projectile->GetOwner())
+        {
+            continue;
+        }
+
+        ApplyProjectileDamage(HitActor, Projectile, Projectile->GetDamage(), Projectile->IsEnemyProjectile());
+        EmitImpactEffects(Projectile, ProjectileHit.Hit.ImpactPoint, Projectile->GetActorRotation());
+        Projectile->ReturnToPool();
+    }
+    Hits.Reset();
+}
+
+void UMCPShooterHitResolver::IssueTraces()
+{
+    const UMCPShooterProjectilePool* ProjectilePool = UMCPShooterProjectilePool::Get(this);
+    if (!ProjectilePool)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    for (AMCPShooterProjectile* Projectile : ProjectilePool->GetActiveProjectiles())
+    {
+        if (!Projectile->IsAsyncHitDriven())
+        {
+            continue;
+        }
+
+        // 前回のスイープの終点から現在位置までの区間を判定する
+        const FVector Start = Projectile->AsyncTraceStart;
+        const FVector End = Projectile->GetActorLocation();
+        Projectile->AsyncTraceStart = End;
+        if (Start.Equals(End))
+        {
+            continue;
+        }
+
+        const USphereComponent* Collision = Projectile->CollisionComponent;
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MCPShooterProjectileHit), false, Projectile);
+        if (AActor* ProjectileOwner = Projectile->GetOwner())
+        {
+            QueryParams.AddIgnoredActor(ProjectileOwner);
+        }
+
+        FPendingProjectileTrace& Pending = PendingTraces.AddDefaulted_GetRef();
+        Pending.Projectile = Projectile;
+        Pending.ActivationSerial = Projectile->ActivationSerial;
+        Pending.Handle = World->AsyncSweepByProfile(EAsyncTraceType::Single, Start, End, FQuat::Identity,
+            Collision->GetCollisionProfileName(), FCollisionShape::MakeSphere(Collision->GetScaledSphereRadius()), QueryParams);
+    }
+}
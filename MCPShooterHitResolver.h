@@ -0,0 +1,104 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "MCPShooterHitResolver.generated.h"
+
+class AMCPShooterProjectile;
+
+/**
+ * シューティングゲームの弾丸の衝突判定
+ *
+ * プールの弾丸の移動で OnComponentHit を発生させる代わりに、毎フレーム
+ * 全ての飛行中の弾丸の移動区間を非同期スイープとして発行し、
+ * 次のフレームで結果をまとめて受け取ってダメージを1回の走査で適用します。
+ * 着弾エフェクトは弾丸クラスにアセットが設定されている場合だけ、
+ * エンジンのパーティクルプールを使って1フレームの上限まで再生します。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API UMCPShooterHitResolver : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	UMCPShooterHitResolver();
+
+	/** ワールドから衝突判定を取得する */
+	static UMCPShooterHitResolver* Get(const UObject* WorldContextObject);
+
+	/** プールの弾丸の衝突を非同期スイープで判定する設定かどうか（MCP.Shooter.AsyncProjectileHits） */
+	static bool IsEnabled();
+
+	/**
+	 * 弾丸が当たった相手にダメージを与える（陣営の判定を含む）
+	 * 敵の弾丸はプレイヤーにのみ、プレイヤーの弾丸は敵にのみダメージを与えます。
+	 * @param HitActor 当たった相手
+	 * @param DamageCauser ダメージを与えたアクター
+	 * @param Damage ダメージ量
+	 * @param bEnemyProjectile 敵の弾丸かどうか
+	 */
+	static void ApplyProjectileDamage(AActor* HitActor, AActor* DamageCauser, float Damage, bool bEnemyProjectile);
+
+	/**
+	 * 着弾エフェクトを再生する
+	 * 弾丸クラスにエフェクトもサウンドも設定されていない場合と、1フレームの上限に達した場合は何もしません。
+	 * @param Projectile 着弾した弾丸（またはそのクラスのデフォルトオブジェクト）
+	 * @param Location 着弾位置
+	 * @param Rotation 着弾時の向き
+	 */
+	void EmitImpactEffects(const AMCPShooterProjectile* Projectile, const FVector& Location, const FRotator& Rotation);
+
+	/** USubsystemの実装 */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObjectの実装 */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** 発行済みの弾丸のスイープ */
+	struct FPendingProjectileTrace
+	{
+		TWeakObjectPtr<AMCPShooterProjectile> Projectile;
+		uint32 ActivationSerial = 0;
+		FTraceHandle Handle;
+	};
+
+	/** 当たった弾丸 */
+	struct FProjectileHit
+	{
+		TWeakObjectPtr<AMCPShooterProjectile> Projectile;
+		uint32 ActivationSerial = 0;
+		FHitResult Hit;
+	};
+
+	/** USubsystemの実装 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** 前のフレームで発行したスイープの結果を受け取る */
+	void GatherHits();
+
+	/** 当たった弾丸のダメージ・エフェクト・プールへの返却をまとめて処理する */
+	void ApplyHits();
+
+	/** 飛行中の弾丸の移動区間のスイープを発行する */
+	void IssueTraces();
+
+	/** 1フレームに再生する着弾エフェクトの上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Effects")
+	int32 MaxImpactEffectsPerFrame;
+
+	/** 発行済みのスイープ */
+	TArray<FPendingProjectileTrace> PendingTraces;
+
+	/** 今回のフレームで当たった弾丸 */
+	TArray<FProjectileHit> Hits;
+
+	/** 今回のフレームで再生した着弾エフェクトの数 */
+	int32 ImpactEffectsThisFrame;
+};
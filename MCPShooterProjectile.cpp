@@ -1,21 +1,30 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPShooterProjectile.h"
-#include "MCPShooterCharacter.h"
-#include "MCPShooterEnemy.h"
+#include "MCPShooterProjectilePool.h"
+#include "MCPShooterEnemyManager.h"
+#include "MCPShooterProjectileVisualCache.h"
+#include "MCPShooterHitResolver.h"
 #include "MCPAssetManager.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Engine/StaticMesh.h"
-#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+#include "MCPStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Projectile Hit"), STAT_MCPShooterProjectileHit, STATGROUP_MCP);
 
 AMCPShooterProjectile::AMCPShooterProjectile()
 {
 	// このアクターが毎フレーム更新されるように設定
 	PrimaryActorTick.bCanEverTick = true;
 	
+	// プールの弾丸は各マシンのローカルなアクターで、複製しない
+	// （ネットワークゲームでは弾丸システムの発射イベントとして送る）
+	bReplicates = false;
+	
 	// 衝突コンポーネントをルートとして作成
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComponent"));
 	CollisionComponent->SetSphereRadius(13.0f);
@@ -48,6 +57,15 @@ AMCPShooterProjectile::AMCPShooterProjectile()
 	Damage = 10.0f;
 	Lifetime = 5.0f;
 	bIsEnemyProjectile = false;
+	bActiveInPool = false;
+	PoolActiveIndex = INDEX_NONE;
+	bFixedStepDriven = false;
+	FixedStepLifetimeRemaining = 0.0f;
+	bAsyncHitDriven = false;
+	ActivationSerial = 0;
+	AsyncTraceStart = FVector::ZeroVector;
+	ImpactEffect = nullptr;
+	ImpactSound = nullptr;
 	
 	// MCPコンポーネント設定
 	MCPComponent = CreateDefaultSubobject<UMCPGameplayComponent>(TEXT("MCPComponent"));
@@ -63,8 +81,11 @@ void AMCPShooterProjectile::BeginPlay()
 		CollisionComponent->OnComponentHit.AddDynamic(this, &AMCPShooterProjectile::OnHit);
 	}
 	
-	// 寿命を設定
-	SetLifeSpan(Lifetime);
+	// 寿命を設定（プール管理下の弾丸は取り出された時点で設定する）
+	if (!IsPooled())
+	{
+		GetWorldTimerManager().SetTimer(LifetimeTimerHandle, this, &AMCPShooterProjectile::ReturnToPool, Lifetime, false);
+	}
 	
 	// 見た目をセットアップ
 	SetupProjectileMesh();
@@ -77,81 +98,164 @@ void AMCPShooterProjectile::Tick(float DeltaTime)
 
 void AMCPShooterProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MCPShooterProjectileHit);
+	TRACE_CPUPROFILER_EVENT_SCOPE(AMCPShooterProjectile::OnHit);
+	
+	// 非同期スイープで判定する弾丸は衝突判定サブシステムがまとめて処理する
+	if (IsAsyncHitDriven())
+	{
+		return;
+	}
+	
 	// 自分自身や発射者との衝突は無視
 	AActor* MyOwner = GetOwner();
 	if (OtherActor && OtherActor != this && OtherActor != MyOwner)
 	{
-		// 敵のプロジェクタイルの場合はプレイヤーにのみダメージ
-		if (bIsEnemyProjectile)
-		{
-			AMCPShooterCharacter* PlayerCharacter = Cast<AMCPShooterCharacter>(OtherActor);
-			if (PlayerCharacter)
-			{
-				// ダメージ適用
-				FDamageEvent DamageEvent;
-				PlayerCharacter->TakeDamage(Damage, DamageEvent, nullptr, this);
-			}
-		}
-		// プレイヤーのプロジェクタイルの場合は敵にのみダメージ
-		else
+		// 陣営に合った相手にだけダメージを適用
+		UMCPShooterHitResolver::ApplyProjectileDamage(OtherActor, this, Damage, bIsEnemyProjectile);
+		
+		// エフェクトとサウンドは設定されている場合だけ再生
+		if (UMCPShooterHitResolver* HitResolver = UMCPShooterHitResolver::Get(this))
 		{
-			AMCPShooterEnemy* Enemy = Cast<AMCPShooterEnemy>(OtherActor);
-			if (Enemy)
-			{
-				// ダメージ適用
-				FDamageEvent DamageEvent;
-				Enemy->TakeDamage(Damage, DamageEvent, nullptr, this);
-			}
+			HitResolver->EmitImpactEffects(this, Hit.ImpactPoint, GetActorRotation());
 		}
 		
-		// エフェクト再生（必要に応じて）
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), nullptr, GetActorLocation(), GetActorRotation());
-		
-		// サウンド再生（必要に応じて）
-		UGameplayStatics::PlaySoundAtLocation(this, nullptr, GetActorLocation());
-		
-		// 弾を破壊
+		// 弾をプールに戻す
+		ReturnToPool();
+	}
+}
+
+void AMCPShooterProjectile::ReturnToPool()
+{
+	UMCPShooterProjectilePool* Pool = OwningPool.Get();
+	if (Pool)
+	{
+		Pool->ReleaseProjectile(this);
+	}
+	else
+	{
 		Destroy();
 	}
 }
 
-void AMCPShooterProjectile::SetupProjectileMesh()
+void AMCPShooterProjectile::ActivateFromPool(const FTransform& SpawnTransform, AActor* NewOwner, APawn* NewInstigator)
 {
-	// Blenderからインポートしたメッシュアセットを検索
-	FString MeshPath = TEXT("/Game/ShooterGame/Assets/Projectile");
-	UStaticMesh* ProjectileStaticMesh = LoadObject<UStaticMesh>(nullptr, *MeshPath);
+	SetOwner(NewOwner);
+	SetInstigator(NewInstigator);
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, nullptr, ETeleportType::ResetPhysics);
 	
-	// メッシュがロードできたら適用
-	if (ProjectileStaticMesh && ProjectileMesh)
+	// 表示・衝突・移動を有効化
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	
+	// プールに入った後にメッシュが解決された場合に備え、取り出すたびに見た目を確認する（変わっていなければ何もしない）
+	SetupProjectileMesh();
+	
+	// 非同期スイープで判定する場合は、移動自体はスイープせずに進める
+	bAsyncHitDriven = UMCPShooterHitResolver::IsEnabled();
+	++ActivationSerial;
+	AsyncTraceStart = SpawnTransform.GetLocation();
+	
+	if (ProjectileMovement)
 	{
-		ProjectileMesh->SetStaticMesh(ProjectileStaticMesh);
-		
-		// マテリアルを適用
-		FString MaterialPath = TEXT("/Game/ShooterGame/Assets/Materials/ProjectileMaterial");
-		UMaterialInterface* ProjectileMaterial = LoadObject<UMaterialInterface>(nullptr, *MaterialPath);
-		if (ProjectileMaterial)
+		// 衝突で停止した際に更新対象が外れるため、毎回設定し直す
+		ProjectileMovement->SetUpdatedComponent(CollisionComponent);
+		ProjectileMovement->bSweepCollision = !bAsyncHitDriven;
+		ProjectileMovement->Velocity = SpawnTransform.GetRotation().Vector() * ProjectileMovement->InitialSpeed;
+		ProjectileMovement->Activate(true);
+	}
+	
+	// 固定ステップの場合は移動と寿命を敵マネージャーが進めるため、コンポーネントのティックとタイマーは使わない
+	bFixedStepDriven = UMCPShooterEnemyManager::GetFixedStepSeconds() > 0.0f;
+	if (bFixedStepDriven)
+	{
+		if (ProjectileMovement)
 		{
-			ProjectileMesh->SetMaterial(0, ProjectileMaterial);
+			ProjectileMovement->SetComponentTickEnabled(false);
 		}
+		FixedStepLifetimeRemaining = Lifetime;
 	}
+	else
+	{
+		GetWorldTimerManager().SetTimer(LifetimeTimerHandle, this, &AMCPShooterProjectile::ReturnToPool, Lifetime, false);
+	}
+	bActiveInPool = true;
 }
 
-void AMCPShooterProjectile::SetIsEnemyProjectile(bool bNewIsEnemyProjectile)
+void AMCPShooterProjectile::StepSimulation(float StepSeconds)
 {
-	bIsEnemyProjectile = bNewIsEnemyProjectile;
+	if (ProjectileMovement && ProjectileMovement->IsActive())
+	{
+		ProjectileMovement->TickComponent(StepSeconds, LEVELTICK_All, nullptr);
+	}
 	
-	// 敵の弾の場合は色を変更
-	if (bIsEnemyProjectile)
+	// 移動中の衝突でプールに戻っている場合がある
+	if (!bActiveInPool)
 	{
-		// 敵の弾は赤色に
-		if (ProjectileMesh && ProjectileMesh->GetMaterial(0))
-		{
-			UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(ProjectileMesh->GetMaterial(0), this);
-			if (Material)
-			{
-				Material->SetVectorParameterValue(TEXT("Color"), FLinearColor::Red);
-				ProjectileMesh->SetMaterial(0, Material);
-			}
-		}
+		return;
+	}
+	
+	FixedStepLifetimeRemaining -= StepSeconds;
+	if (FixedStepLifetimeRemaining <= 0.0f)
+	{
+		ReturnToPool();
+	}
+}
+
+void AMCPShooterProjectile::DeactivateToPool()
+{
+	GetWorldTimerManager().ClearTimer(LifetimeTimerHandle);
+	
+	// 移動を停止
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+	
+	// 表示・衝突・ティックを無効化
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	
+	SetOwner(nullptr);
+	SetInstigator(nullptr);
+	bActiveInPool = false;
+	bFixedStepDriven = false;
+	bAsyncHitDriven = false;
+}
+
+void AMCPShooterProjectile::SetupProjectileMesh()
+{
+	if (!ProjectileMesh)
+	{
+		return;
 	}
-} 
+	
+	// 共有キャッシュから陣営に合った見た目を取得（発射時にアセット検索やオブジェクト生成は行わない）
+	UMCPShooterProjectileVisualCache* VisualCache = UMCPShooterProjectileVisualCache::Get(this);
+	if (!VisualCache)
+	{
+		return;
+	}
+	
+	const FMCPProjectileVisuals& Visuals = VisualCache->GetVisuals(bIsEnemyProjectile);
+	if (Visuals.Mesh && ProjectileMesh->GetStaticMesh() != Visuals.Mesh)
+	{
+		ProjectileMesh->SetStaticMesh(Visuals.Mesh);
+	}
+	
+	if (Visuals.Material && ProjectileMesh->GetMaterial(0) != Visuals.Material)
+	{
+		ProjectileMesh->SetMaterial(0, Visuals.Material);
+	}
+}
+
+void AMCPShooterProjectile::SetIsEnemyProjectile(bool bNewIsEnemyProjectile)
+{
+	bIsEnemyProjectile = bNewIsEnemyProjectile;
+	
+	// 陣営に合わせて見た目を切り替え（敵の弾は赤色）
+	SetupProjectileMesh();
+}
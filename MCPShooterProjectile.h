@@ -10,6 +10,9 @@
 
 class UStaticMeshComponent;
 class USphereComponent;
+class UMCPShooterProjectilePool;
+class UParticleSystem;
+class USoundBase;
 
 /**
  * シューティングゲームの弾丸クラス
@@ -43,6 +46,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Shooting")
 	void SetDamage(float NewDamage) { Damage = NewDamage; }
 
+	/** 弾丸の寿命（秒）の取得 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Shooting")
+	float GetLifetime() const { return Lifetime; }
+
 	/** プロジェクタイルが敵のものかを設定 */
 	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter")
 	void SetIsEnemyProjectile(bool bNewIsEnemyProjectile);
@@ -68,13 +75,61 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/**
+	 * 弾丸の役目を終える
+	 * プール管理下の弾丸はプールに戻し、それ以外は破棄します。
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter")
+	void ReturnToPool();
+
+	/** プール管理下の弾丸かどうか */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	bool IsPooled() const { return OwningPool.IsValid(); }
+
+	/** 発射されて飛行中かどうか（プールで待機中の場合はfalse） */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter")
+	bool IsInFlight() const { return bActiveInPool || !IsPooled(); }
+
+	/** 着弾エフェクト（未設定の場合は再生しない） */
+	UParticleSystem* GetImpactEffect() const { return ImpactEffect; }
+
+	/** 着弾サウンド（未設定の場合は再生しない） */
+	USoundBase* GetImpactSound() const { return ImpactSound; }
+
+	/** 衝突を衝突判定サブシステムの非同期スイープで判定する弾丸かどうか */
+	bool IsAsyncHitDriven() const { return bAsyncHitDriven && bActiveInPool; }
+
+	/** 固定ステップのシミュレーションで移動・寿命を更新する弾丸かどうか */
+	bool IsFixedStepDriven() const { return bFixedStepDriven && bActiveInPool; }
+
+	/**
+	 * 固定ステップ1回分の移動と寿命を進める
+	 * 敵マネージャーの固定ステップ更新から呼ばれます。
+	 * @param StepSeconds ステップの長さ（秒）
+	 */
+	void StepSimulation(float StepSeconds);
+
 protected:
+	friend class UMCPShooterProjectilePool;
+	friend class UMCPShooterHitResolver;
+
+	/**
+	 * プールから取り出された際に発射状態にする
+	 * @param SpawnTransform 発射位置と向き
+	 * @param NewOwner 発射者
+	 * @param NewInstigator ダメージの発生元となるポーン
+	 */
+	void ActivateFromPool(const FTransform& SpawnTransform, AActor* NewOwner, APawn* NewInstigator);
+
+	/** プールに戻す際に衝突・移動・表示を無効化する */
+	void DeactivateToPool();
+
 	/**
 	 * ゲーム開始時に呼び出される関数
 	 */
 	virtual void BeginPlay() override;
 
-	/** プロジェクタイルの見た目をBlenderアセットで設定 */
+	/** プロジェクタイルの見た目を共有キャッシュから陣営に合わせて設定 */
 	void SetupProjectileMesh();
 
 	/** MCPゲームプレイコンポーネント */
@@ -105,6 +160,41 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
 	bool bIsEnemyProjectile;
 
+	/** 着弾時に再生するエフェクト */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
+	UParticleSystem* ImpactEffect;
+
+	/** 着弾時に再生するサウンド */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
+	USoundBase* ImpactSound;
+
+	/** プールから取り出されて使用中かどうか */
+	bool bActiveInPool;
+
+	/** プールの使用中一覧内のインデックス */
+	int32 PoolActiveIndex;
+
+	/** この弾丸を管理するプール（プール外で生成された場合は無効） */
+	TWeakObjectPtr<UMCPShooterProjectilePool> OwningPool;
+
+	/** 寿命タイマーハンドル */
+	FTimerHandle LifetimeTimerHandle;
+
+	/** 固定ステップで更新するかどうか（発射時の設定で決まる） */
+	bool bFixedStepDriven;
+
+	/** 固定ステップで更新する場合の残りの寿命（秒） */
+	float FixedStepLifetimeRemaining;
+
+	/** 非同期スイープで衝突を判定するかどうか（発射時の設定で決まる） */
+	bool bAsyncHitDriven;
+
+	/** プールから取り出されるたびに増える番号（古いスイープの結果を無視するため） */
+	uint32 ActivationSerial;
+
+	/** 次の非同期スイープの始点（前回のスイープの終点） */
+	FVector AsyncTraceStart;
+
 public:
 	/** コンポーネントのゲッター */
 	FORCEINLINE UStaticMeshComponent* GetProjectileMesh() const { return ProjectileMesh; }
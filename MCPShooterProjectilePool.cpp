@@ -0,0 +1,235 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterProjectilePool.h"
+#include "MCPShooterProjectile.h"
+#include "Engine/World.h"
+
+namespace
+{
+    /** 待機中の弾丸を置いておく位置（プレイ領域外） */
+    const FVector PoolParkingLocation(0.0f, 0.0f, -100000.0f);
+}
+
+UMCPShooterProjectilePool::UMCPShooterProjectilePool()
+    : MaxFreePerBucket(512)
+    , ActiveCount(0)
+    , HighWaterMark(0)
+{
+}
+
+UMCPShooterProjectilePool* UMCPShooterProjectilePool::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UMCPShooterProjectilePool>() : nullptr;
+}
+
+bool UMCPShooterProjectilePool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // ゲームとPIEのワールドでのみ使用する
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMCPShooterProjectilePool::Deinitialize()
+{
+    // ワールドの破棄と一緒に弾丸も破棄されるため、参照のみ解放する
+    Buckets.Empty();
+    ActiveProjectiles.Empty();
+    ActiveCount = 0;
+
+    Super::Deinitialize();
+}
+
+void UMCPShooterProjectilePool::Prewarm(TSubclassOf<AMCPShooterProjectile> ProjectileClass, bool bEnemyProjectile, int32 Count)
+{
+    if (!ProjectileClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("プロジェクタイルプール: 事前生成する弾丸クラスが指定されていません"));
+        return;
+    }
+
+    FMCPProjectilePoolBucket& Bucket = FindOrAddBucket(ProjectileClass, bEnemyProjectile);
+    const int32 TargetCount = FMath::Min(Count, MaxFreePerBucket);
+
+    Bucket.FreeProjectiles.Reserve(TargetCount);
+    while (Bucket.FreeProjectiles.Num() < TargetCount)
+    {
+        AMCPShooterProjectile* Projectile = SpawnPooledProjectile(Bucket);
+        if (!Projectile)
+        {
+            break;
+        }
+
+        Bucket.FreeProjectiles.Add(Projectile);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("プロジェクタイルプール: %s (%s) を %d 個事前生成しました"),
+        *ProjectileClass->GetName(), bEnemyProjectile ? TEXT("敵") : TEXT("プレイヤー"), Bucket.FreeProjectiles.Num());
+}
+
+AMCPShooterProjectile* UMCPShooterProjectilePool::AcquireProjectile(TSubclassOf<AMCPShooterProjectile> ProjectileClass, const FTransform& SpawnTransform,
+    AActor* NewOwner, APawn* NewInstigator, bool bEnemyProjectile)
+{
+    if (!ProjectileClass)
+    {
+        return nullptr;
+    }
+
+    FMCPProjectilePoolBucket& Bucket = FindOrAddBucket(ProjectileClass, bEnemyProjectile);
+
+    AMCPShooterProjectile* Projectile = nullptr;
+    while (!Projectile && Bucket.FreeProjectiles.Num() > 0)
+    {
+        // レベル遷移などで外部から破棄された弾丸は読み飛ばす
+        AMCPShooterProjectile* Candidate = Bucket.FreeProjectiles.Pop(false);
+        if (IsValid(Candidate))
+        {
+            Projectile = Candidate;
+        }
+        else
+        {
+            Bucket.TotalCount--;
+        }
+    }
+
+    if (!Projectile)
+    {
+        Bucket.MissCount++;
+        Projectile = SpawnPooledProjectile(Bucket);
+        if (!Projectile)
+        {
+            return nullptr;
+        }
+    }
+
+    Bucket.ActiveCount++;
+    Bucket.HighWaterMark = FMath::Max(Bucket.HighWaterMark, Bucket.ActiveCount);
+    ActiveCount++;
+    HighWaterMark = FMath::Max(HighWaterMark, ActiveCount);
+
+    Projectile->PoolActiveIndex = ActiveProjectiles.Add(Projectile);
+    Projectile->ActivateFromPool(SpawnTransform, NewOwner, NewInstigator);
+    return Projectile;
+}
+
+void UMCPShooterProjectilePool::ReleaseProjectile(AMCPShooterProjectile* Projectile)
+{
+    if (!IsValid(Projectile) || !Projectile->bActiveInPool)
+    {
+        return;
+    }
+
+    Projectile->DeactivateToPool();
+
+    // 使用中の一覧から末尾と入れ替えて削除する
+    const int32 ActiveIndex = Projectile->PoolActiveIndex;
+    if (ActiveProjectiles.IsValidIndex(ActiveIndex) && ActiveProjectiles[ActiveIndex] == Projectile)
+    {
+        ActiveProjectiles.RemoveAtSwap(ActiveIndex, 1, false);
+        if (ActiveProjectiles.IsValidIndex(ActiveIndex))
+        {
+            ActiveProjectiles[ActiveIndex]->PoolActiveIndex = ActiveIndex;
+        }
+    }
+    Projectile->PoolActiveIndex = INDEX_NONE;
+
+    FMCPProjectilePoolBucket& Bucket = FindOrAddBucket(Projectile->GetClass(), Projectile->IsEnemyProjectile());
+    Bucket.ActiveCount = FMath::Max(0, Bucket.ActiveCount - 1);
+    ActiveCount = FMath::Max(0, ActiveCount - 1);
+
+    if (Bucket.FreeProjectiles.Num() >= MaxFreePerBucket)
+    {
+        // 上限を超えた分は破棄する
+        Bucket.TotalCount--;
+        Projectile->OwningPool.Reset();
+        Projectile->Destroy();
+        return;
+    }
+
+    Bucket.FreeProjectiles.Add(Projectile);
+}
+
+int32 UMCPShooterProjectilePool::GetPoolSize() const
+{
+    int32 Total = 0;
+    for (const FMCPProjectilePoolBucket& Bucket : Buckets)
+    {
+        Total += Bucket.TotalCount;
+    }
+    return Total;
+}
+
+int32 UMCPShooterProjectilePool::GetFreeCount() const
+{
+    int32 Total = 0;
+    for (const FMCPProjectilePoolBucket& Bucket : Buckets)
+    {
+        Total += Bucket.FreeProjectiles.Num();
+    }
+    return Total;
+}
+
+int32 UMCPShooterProjectilePool::GetActiveCount() const
+{
+    return ActiveCount;
+}
+
+int32 UMCPShooterProjectilePool::GetHighWaterMark() const
+{
+    return HighWaterMark;
+}
+
+int32 UMCPShooterProjectilePool::GetMissCount() const
+{
+    int32 Total = 0;
+    for (const FMCPProjectilePoolBucket& Bucket : Buckets)
+    {
+        Total += Bucket.MissCount;
+    }
+    return Total;
+}
+
+FMCPProjectilePoolBucket& UMCPShooterProjectilePool::FindOrAddBucket(UClass* ProjectileClass, bool bEnemyProjectile)
+{
+    // バケット数は弾丸クラス×陣営程度なので線形探索で十分
+    for (FMCPProjectilePoolBucket& Bucket : Buckets)
+    {
+        if (Bucket.ProjectileClass == ProjectileClass && Bucket.bEnemyProjectile == bEnemyProjectile)
+        {
+            return Bucket;
+        }
+    }
+
+    FMCPProjectilePoolBucket& NewBucket = Buckets.AddDefaulted_GetRef();
+    NewBucket.ProjectileClass = ProjectileClass;
+    NewBucket.bEnemyProjectile = bEnemyProjectile;
+    return NewBucket;
+}
+
+AMCPShooterProjectile* UMCPShooterProjectilePool::SpawnPooledProjectile(FMCPProjectilePoolBucket& Bucket)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // BeginPlay前にプール管理下であることを設定するため、遅延スポーンを使う
+    const FTransform ParkingTransform(FRotator::ZeroRotator, PoolParkingLocation);
+    AMCPShooterProjectile* Projectile = World->SpawnActorDeferred<AMCPShooterProjectile>(
+        Bucket.ProjectileClass, ParkingTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Projectile)
+    {
+        UE_LOG(LogTemp, Error, TEXT("プロジェクタイルプール: 弾丸の生成に失敗しました"));
+        return nullptr;
+    }
+
+    Projectile->OwningPool = this;
+    Projectile->FinishSpawning(ParkingTransform);
+
+    // 陣営は生成時に一度だけ設定する（見た目の切り替えを再利用時に行わないため）
+    Projectile->SetIsEnemyProjectile(Bucket.bEnemyProjectile);
+    Projectile->DeactivateToPool();
+
+    Bucket.TotalCount++;
+    return Projectile;
+}
@@ -0,0 +1,152 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MCPShooterProjectilePool.generated.h"
+
+class AMCPShooterProjectile;
+
+/**
+ * プロジェクタイルプールのバケット
+ *
+ * 弾丸クラスと陣営（プレイヤー/敵）の組み合わせごとに1つ作成されます。
+ * 陣営ごとに分けることで、再利用時に見た目の切り替えが発生しないようにしています。
+ */
+USTRUCT()
+struct FMCPProjectilePoolBucket
+{
+	GENERATED_BODY()
+
+	/** このバケットが管理する弾丸クラス */
+	UPROPERTY()
+	UClass* ProjectileClass = nullptr;
+
+	/** 敵の弾丸用バケットかどうか */
+	UPROPERTY()
+	bool bEnemyProjectile = false;
+
+	/** 待機中（非アクティブ）の弾丸 */
+	UPROPERTY()
+	TArray<AMCPShooterProjectile*> FreeProjectiles;
+
+	/** バケットが生成した弾丸の総数 */
+	int32 TotalCount = 0;
+
+	/** 現在使用中の弾丸の数 */
+	int32 ActiveCount = 0;
+
+	/** このバケットでの同時使用数の最大値 */
+	int32 HighWaterMark = 0;
+
+	/** 待機中の弾丸がなく新規生成が必要になった回数 */
+	int32 MissCount = 0;
+};
+
+/**
+ * シューティングゲームの弾丸プール
+ *
+ * 発射のたびにSpawnActor/Destroyを行う代わりに、事前に生成した弾丸を
+ * 非アクティブ化して使い回します。衝突時や寿命切れの際は破壊せずにプールへ戻します。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API UMCPShooterProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	UMCPShooterProjectilePool();
+
+	/** ワールドからプールを取得する */
+	static UMCPShooterProjectilePool* Get(const UObject* WorldContextObject);
+
+	/** USubsystemの実装 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * 弾丸を事前に生成してプールに蓄える
+	 * @param ProjectileClass 生成する弾丸クラス
+	 * @param bEnemyProjectile 敵の弾丸として生成するかどうか
+	 * @param Count 待機中の弾丸がこの数になるまで生成する
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Pool")
+	void Prewarm(TSubclassOf<AMCPShooterProjectile> ProjectileClass, bool bEnemyProjectile, int32 Count);
+
+	/**
+	 * プールから弾丸を取得して発射状態にする
+	 * 待機中の弾丸がない場合は新しく生成します（ミスとして記録されます）。
+	 * @param ProjectileClass 弾丸クラス
+	 * @param SpawnTransform 発射位置と向き
+	 * @param NewOwner 発射者
+	 * @param NewInstigator ダメージの発生元となるポーン
+	 * @param bEnemyProjectile 敵の弾丸かどうか
+	 * @return 発射された弾丸（生成に失敗した場合はnullptr）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Pool")
+	AMCPShooterProjectile* AcquireProjectile(TSubclassOf<AMCPShooterProjectile> ProjectileClass, const FTransform& SpawnTransform,
+		AActor* NewOwner, APawn* NewInstigator, bool bEnemyProjectile);
+
+	/**
+	 * 弾丸をプールに戻す
+	 * バケットが上限に達している場合は破棄します。
+	 * @param Projectile 戻す弾丸
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MCP|Shooter|Pool")
+	void ReleaseProjectile(AMCPShooterProjectile* Projectile);
+
+	/** プールが生成した弾丸の総数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Pool")
+	int32 GetPoolSize() const;
+
+	/** 待機中の弾丸の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Pool")
+	int32 GetFreeCount() const;
+
+	/** 使用中の弾丸の数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Pool")
+	int32 GetActiveCount() const;
+
+	/** プール全体での同時使用数の最大値 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Pool")
+	int32 GetHighWaterMark() const;
+
+	/** プールに待機中の弾丸がなかった回数 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "MCP|Shooter|Pool")
+	int32 GetMissCount() const;
+
+	/** 使用中の弾丸の一覧 */
+	const TArray<AMCPShooterProjectile*>& GetActiveProjectiles() const { return ActiveProjectiles; }
+
+protected:
+	/** USubsystemの実装 */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** バケットを検索し、なければ作成する */
+	FMCPProjectilePoolBucket& FindOrAddBucket(UClass* ProjectileClass, bool bEnemyProjectile);
+
+	/** プール管理下の弾丸を新しく生成する（非アクティブ状態で返す） */
+	AMCPShooterProjectile* SpawnPooledProjectile(FMCPProjectilePoolBucket& Bucket);
+
+	/** 1バケットあたりに保持する待機中の弾丸の上限 */
+	UPROPERTY(EditDefaultsOnly, Category = "MCP|Shooter|Pool")
+	int32 MaxFreePerBucket;
+
+	/** 弾丸クラス・陣営ごとのバケット */
+	UPROPERTY()
+	TArray<FMCPProjectilePoolBucket> Buckets;
+
+	/** 使用中の弾丸（空間検索用） */
+	UPROPERTY()
+	TArray<AMCPShooterProjectile*> ActiveProjectiles;
+
+	/** プール全体で現在使用中の弾丸の数 */
+	int32 ActiveCount;
+
+	/**
+	 * プール全体での同時使用数の最大値
+	 * バケットごとの最大値は別の時点で記録されるため、合計すると実際の同時使用数より大きくなります。
+	 */
+	int32 HighWaterMark;
+};
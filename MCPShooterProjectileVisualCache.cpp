@@ -0,0 +1,115 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterProjectileVisualCache.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+namespace
+{
+    /** Blenderからインポートした弾丸メッシュ */
+    const TCHAR* ProjectileMeshPath = TEXT("/Game/ShooterGame/Assets/Projectile");
+
+    /** 弾丸のマテリアル */
+    const TCHAR* ProjectileMaterialPath = TEXT("/Game/ShooterGame/Assets/Materials/ProjectileMaterial");
+}
+
+UMCPShooterProjectileVisualCache* UMCPShooterProjectileVisualCache::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    return GameInstance ? GameInstance->GetSubsystem<UMCPShooterProjectileVisualCache>() : nullptr;
+}
+
+void UMCPShooterProjectileVisualCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // ゲーム中にインポートされたメッシュを拾うため、アセットの追加を監視する
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.OnAssetAdded().AddUObject(this, &UMCPShooterProjectileVisualCache::HandleAssetAdded);
+}
+
+void UMCPShooterProjectileVisualCache::Deinitialize()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        AssetRegistryModule->Get().OnAssetAdded().RemoveAll(this);
+    }
+    VisualsChanged.Clear();
+
+    Super::Deinitialize();
+}
+
+const FMCPProjectileVisuals& UMCPShooterProjectileVisualCache::GetVisuals(bool bEnemyProjectile)
+{
+    // 失敗した場合は発射のたびに検索しないよう、アセットが追加されるまで待つ
+    if (!bResolved && !bResolveFailed)
+    {
+        ResolveVisuals();
+    }
+
+    return bEnemyProjectile ? EnemyVisuals : PlayerVisuals;
+}
+
+void UMCPShooterProjectileVisualCache::RefreshVisuals()
+{
+    if (bResolved)
+    {
+        return;
+    }
+
+    bResolveFailed = false;
+    ResolveVisuals();
+    if (bResolved)
+    {
+        VisualsChanged.Broadcast();
+    }
+}
+
+void UMCPShooterProjectileVisualCache::HandleAssetAdded(const FAssetData& AssetData)
+{
+    if (!bResolved && AssetData.PackageName == FName(ProjectileMeshPath))
+    {
+        RefreshVisuals();
+    }
+}
+
+void UMCPShooterProjectileVisualCache::ResolveVisuals()
+{
+    UStaticMesh* ProjectileStaticMesh = LoadObject<UStaticMesh>(nullptr, ProjectileMeshPath);
+    if (!ProjectileStaticMesh)
+    {
+        bResolveFailed = true;
+        UE_LOG(LogTemp, Warning, TEXT("弾丸メッシュが見つかりませんでした（インポート後に解決し直します）: %s"), ProjectileMeshPath);
+        return;
+    }
+    bResolved = true;
+
+    // マテリアルが見つからない場合はメッシュのマテリアルを使う
+    UMaterialInterface* BaseMaterial = LoadObject<UMaterialInterface>(nullptr, ProjectileMaterialPath);
+    if (!BaseMaterial)
+    {
+        BaseMaterial = ProjectileStaticMesh->GetMaterial(0);
+    }
+
+    PlayerVisuals.Mesh = ProjectileStaticMesh;
+    PlayerVisuals.Material = BaseMaterial;
+
+    // 敵の弾は赤色にする（全ての敵の弾で1つのインスタンスを共有）
+    EnemyVisuals.Mesh = ProjectileStaticMesh;
+    EnemyVisuals.Material = BaseMaterial;
+    if (BaseMaterial)
+    {
+        UMaterialInstanceDynamic* EnemyMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+        if (EnemyMaterial)
+        {
+            EnemyMaterial->SetVectorParameterValue(TEXT("Color"), FLinearColor::Red);
+            EnemyVisuals.Material = EnemyMaterial;
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("弾丸の見た目キャッシュを作成しました"));
+}
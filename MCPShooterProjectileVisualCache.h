@@ -0,0 +1,88 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "MCPShooterProjectileVisualCache.generated.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+struct FAssetData;
+
+/**
+ * 陣営ごとの弾丸の見た目
+ */
+USTRUCT()
+struct FMCPProjectileVisuals
+{
+	GENERATED_BODY()
+
+	/** 弾丸のメッシュ */
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	/** 弾丸のマテリアル */
+	UPROPERTY()
+	UMaterialInterface* Material = nullptr;
+};
+
+/**
+ * 弾丸の見た目キャッシュ
+ *
+ * 弾丸のメッシュ・マテリアルと、敵の弾丸用の赤いマテリアルインスタンスを
+ * 最初の使用時に一度だけ解決し、全ての弾丸で共有します。
+ * 発射時にはアセットの検索やオブジェクトの生成を行いません。
+ * メッシュがまだインポートされていない場合は、アセットが追加されるか
+ * RefreshVisuals が呼ばれた時に解決し直し、OnVisualsChanged で通知します。
+ */
+UCLASS()
+class SPACESHOOTERGAME_API UMCPShooterProjectileVisualCache : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** ワールドコンテキストからキャッシュを取得する */
+	static UMCPShooterProjectileVisualCache* Get(const UObject* WorldContextObject);
+
+	/**
+	 * 陣営に対応する見た目を取得する
+	 * @param bEnemyProjectile 敵の弾丸かどうか
+	 * @return 共有の見た目（未解決の場合はこの呼び出しで解決されます）
+	 */
+	const FMCPProjectileVisuals& GetVisuals(bool bEnemyProjectile);
+
+	/** 未解決の場合にアセットを解決し直す（インポートの完了後に呼ぶ） */
+	void RefreshVisuals();
+
+	/** 見た目が後から解決された時のデリゲート */
+	FSimpleMulticastDelegate& OnVisualsChanged() { return VisualsChanged; }
+
+	/** USubsystemの実装 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+	/** アセットを解決する */
+	void ResolveVisuals();
+
+	/** アセットレジストリにアセットが追加された時の処理 */
+	void HandleAssetAdded(const FAssetData& AssetData);
+
+	/** プレイヤーの弾丸の見た目 */
+	UPROPERTY()
+	FMCPProjectileVisuals PlayerVisuals;
+
+	/** 敵の弾丸の見た目 */
+	UPROPERTY()
+	FMCPProjectileVisuals EnemyVisuals;
+
+	/** 見た目が後から解決された時のデリゲート */
+	FSimpleMulticastDelegate VisualsChanged;
+
+	/** 解決済みかどうか（メッシュが見つかった場合のみtrue） */
+	bool bResolved = false;
+
+	/** 解決に失敗したかどうか（アセットが追加されるまで解決し直さない） */
+	bool bResolveFailed = false;
+};
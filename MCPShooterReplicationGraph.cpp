@@ -0,0 +1,147 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterReplicationGraph.h"
+#include "MCPShooterCharacter.h"
+#include "MCPShooterEnemy.h"
+#include "MCPShooterProjectile.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/LevelScriptActor.h"
+
+UMCPShooterReplicationGraph::UMCPShooterReplicationGraph()
+    : SpatialCellSize(10000.0f)
+    , SpatialBias(-150000.0f, -150000.0f)
+    , EnemyCullDistance(15000.0f)
+    , EnemyNetUpdateFrequency(10.0f)
+    , GridNode(nullptr)
+    , AlwaysRelevantNode(nullptr)
+    , PlayerStateNode(nullptr)
+{
+}
+
+EMCPShooterRepNodeMapping UMCPShooterReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+    if (const EMCPShooterRepNodeMapping* Found = ClassMappings.Get(Class))
+    {
+        return *Found;
+    }
+
+    EMCPShooterRepNodeMapping Mapping = EMCPShooterRepNodeMapping::Spatialize_Dynamic;
+    const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+
+    if (Class->IsChildOf(AMCPShooterProjectile::StaticClass()) || Class->IsChildOf(APlayerState::StaticClass())
+        || Class->IsChildOf(ALevelScriptActor::StaticClass()))
+    {
+        // 弾丸は発射イベントで再現し、プレイヤーステートは頻度制限ノードがゲームステートから集める
+        Mapping = EMCPShooterRepNodeMapping::NotRouted;
+    }
+    else if (Class->IsChildOf(AMCPShooterCharacter::StaticClass()) || Class->IsChildOf(AGameStateBase::StaticClass()))
+    {
+        // 32人分の機体は常に全員に見える前提で、空間分割しない
+        Mapping = EMCPShooterRepNodeMapping::AlwaysRelevant;
+    }
+    else if (Class->IsChildOf(AMCPShooterEnemy::StaticClass()))
+    {
+        Mapping = EMCPShooterRepNodeMapping::Spatialize_Dynamic;
+    }
+    else if (ActorCDO && ActorCDO->bOnlyRelevantToOwner)
+    {
+        Mapping = EMCPShooterRepNodeMapping::RelevantToOwner;
+    }
+    else if (ActorCDO && ActorCDO->bAlwaysRelevant)
+    {
+        Mapping = EMCPShooterRepNodeMapping::AlwaysRelevant;
+    }
+    else if (ActorCDO && !ActorCDO->IsReplicatingMovement())
+    {
+        Mapping = EMCPShooterRepNodeMapping::Spatialize_Static;
+    }
+
+    ClassMappings.Set(Class, Mapping);
+    return Mapping;
+}
+
+void UMCPShooterReplicationGraph::InitGlobalActorClassSettings()
+{
+    Super::InitGlobalActorClassSettings();
+
+    // 敵は近くの接続にだけ、低めの頻度で送る（位置と向きは敵側で量子化済み）
+    FClassReplicationInfo EnemyInfo;
+    EnemyInfo.SetCullDistanceSquared(FMath::Square(EnemyCullDistance));
+    EnemyInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(EnemyNetUpdateFrequency);
+    GlobalActorReplicationInfoMap.SetClassInfo(AMCPShooterEnemy::StaticClass(), EnemyInfo);
+
+    // プレイヤーの機体は操作の反応を保つため、アクターの設定どおりの頻度で送る
+    const AMCPShooterCharacter* CharacterCDO = GetDefault<AMCPShooterCharacter>();
+    FClassReplicationInfo CharacterInfo;
+    CharacterInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(CharacterCDO->GetNetUpdateFrequency());
+    GlobalActorReplicationInfoMap.SetClassInfo(AMCPShooterCharacter::StaticClass(), CharacterInfo);
+}
+
+void UMCPShooterReplicationGraph::InitGlobalGraphNodes()
+{
+    // 敵などの移動するアクター
+    GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+    GridNode->CellSize = SpatialCellSize;
+    GridNode->SpatialBias = SpatialBias;
+    AddGlobalGraphNode(GridNode);
+
+    // プレイヤーの機体とゲームステート
+    AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+    AddGlobalGraphNode(AlwaysRelevantNode);
+
+    // プレイヤーステート（32人分を毎フレーム全て送らないように頻度を制限する）
+    PlayerStateNode = CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>();
+    AddGlobalGraphNode(PlayerStateNode);
+}
+
+void UMCPShooterReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+    Super::InitConnectionGraphNodes(RepGraphConnection);
+
+    // 接続ごとのプレイヤーコントローラー・所有するポーン・視点のアクター
+    UReplicationGraphNode_AlwaysRelevant_ForConnection* ConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+    AddConnectionGraphNode(ConnectionNode, RepGraphConnection);
+}
+
+void UMCPShooterReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    switch (GetMappingPolicy(ActorInfo.Class))
+    {
+    case EMCPShooterRepNodeMapping::AlwaysRelevant:
+        AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+
+    case EMCPShooterRepNodeMapping::Spatialize_Dynamic:
+        GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+        break;
+
+    case EMCPShooterRepNodeMapping::Spatialize_Static:
+        GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void UMCPShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+    switch (GetMappingPolicy(ActorInfo.Class))
+    {
+    case EMCPShooterRepNodeMapping::AlwaysRelevant:
+        AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+        break;
+
+    case EMCPShooterRepNodeMapping::Spatialize_Dynamic:
+        GridNode->RemoveActor_Dynamic(ActorInfo);
+        break;
+
+    case EMCPShooterRepNodeMapping::Spatialize_Static:
+        GridNode->RemoveActor_Static(ActorInfo);
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "MCPShooterReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_PlayerStateFrequencyLimiter;
+
+/** アクタークラスをどのノードで複製するか */
+enum class EMCPShooterRepNodeMapping : uint8
+{
+	/** 複製しない（弾丸など、ローカルで再現するもの） */
+	NotRouted,
+
+	/** 全ての接続に常に複製する */
+	AlwaysRelevant,
+
+	/** 所有者の接続にのみ複製する（接続ごとのノードが扱う） */
+	RelevantToOwner,
+
+	/** グリッドで空間分割し、移動するアクターとして扱う */
+	Spatialize_Dynamic,
+
+	/** グリッドで空間分割し、移動しないアクターとして扱う */
+	Spatialize_Static,
+};
+
+/**
+ * シューティングゲームのレプリケーショングラフ
+ *
+ * 敵は2Dグリッドで空間分割して近くの接続にだけ送り、プレイヤーの機体と
+ * ゲームステートは全ての接続に常に送ります。弾丸はアクターとして複製せず、
+ * ゲームステートの発射イベントでクライアントが再現します。
+ * 32人・数百体の敵で1接続あたりの帯域を抑えるための構成です。
+ *
+ * DefaultEngine.ini で有効にします:
+ *   [/Script/OnlineSubsystemUtils.IpNetDriver]
+ *   ReplicationDriverClassName="/Script/SpaceShooterGame.MCPShooterReplicationGraph"
+ */
+UCLASS(Transient, Config = Engine)
+class SPACESHOOTERGAME_API UMCPShooterReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** コンストラクタ */
+	UMCPShooterReplicationGraph();
+
+	/** UReplicationGraphの実装 */
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/** 空間分割のセルの一辺の長さ */
+	UPROPERTY(Config)
+	float SpatialCellSize;
+
+	/** 空間分割のグリッドの原点（マップの最小座標） */
+	UPROPERTY(Config)
+	FVector2D SpatialBias;
+
+	/** 敵を複製する最大距離 */
+	UPROPERTY(Config)
+	float EnemyCullDistance;
+
+	/** 敵の複製頻度（Hz） */
+	UPROPERTY(Config)
+	float EnemyNetUpdateFrequency;
+
+protected:
+	/**
+	 * アクタークラスの複製先のノードを決める
+	 * @param Class アクタークラス
+	 * @return 複製先
+	 */
+	EMCPShooterRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	/** 敵などの空間分割ノード */
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	/** 全ての接続に送るアクターのノード */
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+
+	/** プレイヤーステートの頻度を制限するノード */
+	UPROPERTY()
+	UReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode;
+
+	/** アクタークラスごとの複製先（初回の判定結果を保持） */
+	TClassMap<EMCPShooterRepNodeMapping> ClassMappings;
+};
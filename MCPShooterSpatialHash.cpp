@@ -0,0 +1,187 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterSpatialHash.h"
+
+FMCPShooterSpatialHash::FMCPShooterSpatialHash(float InCellSize, int32 InBucketCount)
+{
+    SetCellSize(InCellSize);
+
+    const uint32 BucketCount = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InBucketCount, 16)));
+    BucketMask = BucketCount - 1;
+    BucketStart.SetNumZeroed(BucketCount + 1);
+}
+
+void FMCPShooterSpatialHash::SetCellSize(float InCellSize)
+{
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    InvCellSize = 1.0f / CellSize;
+}
+
+FIntVector FMCPShooterSpatialHash::ToCell(const FVector& Position) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Position.X * InvCellSize),
+        FMath::FloorToInt(Position.Y * InvCellSize),
+        FMath::FloorToInt(Position.Z * InvCellSize));
+}
+
+uint32 FMCPShooterSpatialHash::HashCell(const FIntVector& Cell) const
+{
+    // 大きな素数による空間ハッシュ（Teschnerら）
+    const uint32 Hash = (static_cast<uint32>(Cell.X) * 73856093u) ^ (static_cast<uint32>(Cell.Y) * 19349663u) ^ (static_cast<uint32>(Cell.Z) * 83492791u);
+    return Hash & BucketMask;
+}
+
+void FMCPShooterSpatialHash::Reset()
+{
+    Points.Reset();
+    PointCells.Reset();
+    SortedIndices.Reset();
+    FMemory::Memzero(BucketStart.GetData(), BucketStart.Num() * sizeof(int32));
+}
+
+void FMCPShooterSpatialHash::Build(TArrayView<const FVector> Positions)
+{
+    const int32 Count = Positions.Num();
+
+    Points.SetNumUninitialized(Count, false);
+    PointCells.SetNumUninitialized(Count, false);
+    SortedIndices.SetNumUninitialized(Count, false);
+    FMemory::Memzero(BucketStart.GetData(), BucketStart.Num() * sizeof(int32));
+
+    // 各バケットの要素数を数える
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Points[Index] = Positions[Index];
+        PointCells[Index] = ToCell(Positions[Index]);
+        BucketStart[HashCell(PointCells[Index]) + 1]++;
+    }
+
+    // 累積和で開始位置を求める
+    const int32 BucketCount = BucketStart.Num() - 1;
+    for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+    {
+        BucketStart[Bucket + 1] += BucketStart[Bucket];
+    }
+
+    // バケット順に並べる（安定な計数ソート）
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const uint32 Bucket = HashCell(PointCells[Index]);
+        SortedIndices[BucketStart[Bucket]++] = Index;
+    }
+
+    // 並べる際に進めた開始位置を元に戻す
+    for (int32 Bucket = BucketCount; Bucket > 0; --Bucket)
+    {
+        BucketStart[Bucket] = BucketStart[Bucket - 1];
+    }
+    BucketStart[0] = 0;
+}
+
+template <typename VisitorType>
+void FMCPShooterSpatialHash::ForEachInCells(const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor) const
+{
+    const int64 CellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+    if (CellCount > Points.Num())
+    {
+        // 範囲が要素数より多くのセルにまたがる場合は全件走査の方が速い
+        for (int32 Index = 0; Index < Points.Num(); ++Index)
+        {
+            const FIntVector& Cell = PointCells[Index];
+            if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y && Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+            {
+                Visitor(Index);
+            }
+        }
+        return;
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                const FIntVector Cell(X, Y, Z);
+                const uint32 Bucket = HashCell(Cell);
+                for (int32 Slot = BucketStart[Bucket]; Slot < BucketStart[Bucket + 1]; ++Slot)
+                {
+                    // 別のセルが同じバケットに入っている場合は除外する
+                    const int32 Index = SortedIndices[Slot];
+                    if (PointCells[Index] == Cell)
+                    {
+                        Visitor(Index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FMCPShooterSpatialHash::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIndices) const
+{
+    if (Points.Num() == 0 || Radius < 0.0f)
+    {
+        return;
+    }
+
+    const FVector Extent(Radius);
+    const double RadiusSquared = double(Radius) * Radius;
+    ForEachInCells(ToCell(Center - Extent), ToCell(Center + Extent), [&](int32 Index)
+    {
+        if (FVector::DistSquared(Points[Index], Center) <= RadiusSquared)
+        {
+            OutIndices.Add(Index);
+        }
+    });
+}
+
+void FMCPShooterSpatialHash::QueryBox(const FBox& Box, TArray<int32>& OutIndices) const
+{
+    if (Points.Num() == 0 || !Box.IsValid)
+    {
+        return;
+    }
+
+    ForEachInCells(ToCell(Box.Min), ToCell(Box.Max), [&](int32 Index)
+    {
+        if (Box.IsInsideOrOn(Points[Index]))
+        {
+            OutIndices.Add(Index);
+        }
+    });
+}
+
+int32 FMCPShooterSpatialHash::FindNearest(const FVector& Center, float MaxRadius) const
+{
+    if (Points.Num() == 0 || MaxRadius < 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    // 近い範囲から徐々に広げて検索する
+    int32 BestIndex = INDEX_NONE;
+    float SearchRadius = FMath::Min(CellSize, MaxRadius);
+    while (true)
+    {
+        double BestDistanceSquared = double(SearchRadius) * SearchRadius;
+        const FVector Extent(SearchRadius);
+        ForEachInCells(ToCell(Center - Extent), ToCell(Center + Extent), [&](int32 Index)
+        {
+            const double DistanceSquared = FVector::DistSquared(Points[Index], Center);
+            if (DistanceSquared <= BestDistanceSquared)
+            {
+                BestDistanceSquared = DistanceSquared;
+                BestIndex = Index;
+            }
+        });
+
+        if (BestIndex != INDEX_NONE || SearchRadius >= MaxRadius)
+        {
+            return BestIndex;
+        }
+
+        SearchRadius = FMath::Min(SearchRadius * 2.0f, MaxRadius);
+    }
+}
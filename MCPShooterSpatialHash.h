@@ -0,0 +1,102 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 一様グリッドによる空間ハッシュ
+ *
+ * 位置の配列からフレームごとに再構築し、球・ボックスによる範囲検索と
+ * 最近傍検索を行います。セルはハッシュ表のバケットに割り当て、計数ソートで
+ * 連続した配列に並べるため、容量が確保された後は再構築でメモリ確保が発生しません。
+ * 検索結果は Build に渡した配列のインデックスで返します。
+ */
+class SPACESHOOTERGAME_API FMCPShooterSpatialHash
+{
+public:
+	/**
+	 * コンストラクタ
+	 * @param InCellSize セルの一辺の長さ
+	 * @param InBucketCount ハッシュ表のバケット数（2の累乗に切り上げられます）
+	 */
+	explicit FMCPShooterSpatialHash(float InCellSize = 500.0f, int32 InBucketCount = 4096);
+
+	/** セルの一辺の長さを設定する（次のBuildから有効） */
+	void SetCellSize(float InCellSize);
+
+	/** セルの一辺の長さを取得する */
+	float GetCellSize() const { return CellSize; }
+
+	/**
+	 * 位置の配列からグリッドを再構築する
+	 * @param Positions 登録する位置
+	 */
+	void Build(TArrayView<const FVector> Positions);
+
+	/** 登録されている要素をすべて消去する */
+	void Reset();
+
+	/** 登録されている要素の数 */
+	int32 Num() const { return Points.Num(); }
+
+	/**
+	 * 球の範囲内にある要素を検索する
+	 * @param Center 中心
+	 * @param Radius 半径
+	 * @param OutIndices 見つかった要素のインデックス（追加されます）
+	 */
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIndices) const;
+
+	/**
+	 * ボックスの範囲内にある要素を検索する
+	 * @param Box 検索範囲
+	 * @param OutIndices 見つかった要素のインデックス（追加されます）
+	 */
+	void QueryBox(const FBox& Box, TArray<int32>& OutIndices) const;
+
+	/**
+	 * 最も近い要素を検索する
+	 * @param Center 検索の中心
+	 * @param MaxRadius 検索する最大距離
+	 * @return 見つかった要素のインデックス（見つからない場合はINDEX_NONE）
+	 */
+	int32 FindNearest(const FVector& Center, float MaxRadius) const;
+
+private:
+	/** 位置からセル座標を計算する */
+	FIntVector ToCell(const FVector& Position) const;
+
+	/** セル座標からバケット番号を計算する */
+	uint32 HashCell(const FIntVector& Cell) const;
+
+	/**
+	 * セル範囲内の要素を列挙する
+	 * @param MinCell 最小セル
+	 * @param MaxCell 最大セル
+	 * @param Visitor 要素ごとに呼ばれる関数
+	 */
+	template <typename VisitorType>
+	void ForEachInCells(const FIntVector& MinCell, const FIntVector& MaxCell, VisitorType&& Visitor) const;
+
+	/** セルの一辺の長さ */
+	float CellSize;
+
+	/** セルの一辺の長さの逆数 */
+	float InvCellSize;
+
+	/** バケット番号のマスク（バケット数 - 1） */
+	uint32 BucketMask;
+
+	/** 登録された位置 */
+	TArray<FVector> Points;
+
+	/** 各要素のセル座標 */
+	TArray<FIntVector> PointCells;
+
+	/** バケットごとの開始位置（SortedIndices内、要素数はバケット数 + 1） */
+	TArray<int32> BucketStart;
+
+	/** バケット順に並べた要素のインデックス */
+	TArray<int32> SortedIndices;
+};
@@ -0,0 +1,257 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterSteering.h"
+#include "Math/VectorRegister.h"
+#include "Math/RandomStream.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+namespace MCPShooterSteering
+{
+    namespace
+    {
+        /** 角度を [-180, 180) に正規化する */
+        FORCEINLINE float WrapDegrees(float Degrees)
+        {
+            return Degrees - 360.0f * FMath::FloorToFloat((Degrees + 180.0f) / 360.0f);
+        }
+
+        /** 補間係数を計算する（FMath::RInterpToと同じ規則） */
+        FORCEINLINE float ComputeAlpha(float DeltaTime, float InterpSpeed)
+        {
+            return InterpSpeed <= 0.0f ? 1.0f : FMath::Clamp(DeltaTime * InterpSpeed, 0.0f, 1.0f);
+        }
+
+        /** 1要素分のステアリング計算 */
+        FORCEINLINE void SteerOne(const FSteeringBatch& Batch, int32 Index, float TargetX, float TargetY, float Alpha)
+        {
+            float DirX = TargetX - Batch.PosX[Index];
+            float DirY = TargetY - Batch.PosY[Index];
+            const float LengthSquared = DirX * DirX + DirY * DirY;
+
+            if (LengthSquared <= 0.0f)
+            {
+                // 目標と重なっている場合は移動しない
+                Batch.OutDirX[Index] = 0.0f;
+                Batch.OutDirY[Index] = 0.0f;
+                return;
+            }
+
+            const float InvLength = 1.0f / FMath::Sqrt(LengthSquared);
+            DirX *= InvLength;
+            DirY *= InvLength;
+
+            const float TargetYaw = FMath::RadiansToDegrees(FMath::Atan2(DirY, DirX));
+            const float CurrentYaw = Batch.Yaw[Index];
+            const float DeltaYaw = WrapDegrees(TargetYaw - CurrentYaw);
+
+            Batch.Yaw[Index] = WrapDegrees(CurrentYaw + DeltaYaw * Alpha);
+            Batch.OutDirX[Index] = DirX;
+            Batch.OutDirY[Index] = DirY;
+        }
+    }
+
+    void SteerScalar(const FSteeringBatch& Batch, float TargetX, float TargetY, float DeltaTime, float InterpSpeed)
+    {
+        const float Alpha = ComputeAlpha(DeltaTime, InterpSpeed);
+        for (int32 Index = 0; Index < Batch.Count; ++Index)
+        {
+            SteerOne(Batch, Index, TargetX, TargetY, Alpha);
+        }
+    }
+
+    void SteerVectorized(const FSteeringBatch& Batch, float TargetX, float TargetY, float DeltaTime, float InterpSpeed)
+    {
+        const float Alpha = ComputeAlpha(DeltaTime, InterpSpeed);
+
+        const VectorRegister4Float VTargetX = VectorSetFloat1(TargetX);
+        const VectorRegister4Float VTargetY = VectorSetFloat1(TargetY);
+        const VectorRegister4Float VAlpha = VectorSetFloat1(Alpha);
+        const VectorRegister4Float VZero = VectorZeroFloat();
+        const VectorRegister4Float VHalfTurn = VectorSetFloat1(180.0f);
+        const VectorRegister4Float VFullTurn = VectorSetFloat1(360.0f);
+        const VectorRegister4Float VInvFullTurn = VectorSetFloat1(1.0f / 360.0f);
+        const VectorRegister4Float VRadToDeg = VectorSetFloat1(180.0f / UE_PI);
+
+        // [-180, 180) への正規化: D - 360 * floor((D + 180) / 360)
+        auto WrapDegreesVector = [&](const VectorRegister4Float& Degrees)
+        {
+            const VectorRegister4Float Turns = VectorFloor(VectorMultiply(VectorAdd(Degrees, VHalfTurn), VInvFullTurn));
+            return VectorNegateMultiplyAdd(Turns, VFullTurn, Degrees);
+        };
+
+        const int32 VectorCount = Batch.Count & ~3;
+        for (int32 Index = 0; Index < VectorCount; Index += 4)
+        {
+            const VectorRegister4Float PosX = VectorLoad(Batch.PosX + Index);
+            const VectorRegister4Float PosY = VectorLoad(Batch.PosY + Index);
+            const VectorRegister4Float CurrentYaw = VectorLoad(Batch.Yaw + Index);
+
+            VectorRegister4Float DirX = VectorSubtract(VTargetX, PosX);
+            VectorRegister4Float DirY = VectorSubtract(VTargetY, PosY);
+            const VectorRegister4Float LengthSquared = VectorMultiplyAdd(DirX, DirX, VectorMultiply(DirY, DirY));
+
+            // 目標と重なっている要素はマスクで除外する
+            const VectorRegister4Float ValidMask = VectorCompareGT(LengthSquared, VZero);
+            const VectorRegister4Float InvLength = VectorReciprocalSqrtAccurate(VectorSelect(ValidMask, LengthSquared, VectorOneFloat()));
+            DirX = VectorSelect(ValidMask, VectorMultiply(DirX, InvLength), VZero);
+            DirY = VectorSelect(ValidMask, VectorMultiply(DirY, InvLength), VZero);
+
+            const VectorRegister4Float TargetYaw = VectorMultiply(VectorATan2(DirY, DirX), VRadToDeg);
+            const VectorRegister4Float DeltaYaw = WrapDegreesVector(VectorSubtract(TargetYaw, CurrentYaw));
+            const VectorRegister4Float NewYaw = WrapDegreesVector(VectorMultiplyAdd(DeltaYaw, VAlpha, CurrentYaw));
+
+            VectorStore(VectorSelect(ValidMask, NewYaw, CurrentYaw), Batch.Yaw + Index);
+            VectorStore(DirX, Batch.OutDirX + Index);
+            VectorStore(DirY, Batch.OutDirY + Index);
+        }
+
+        // 端数はスカラーで処理する
+        for (int32 Index = VectorCount; Index < Batch.Count; ++Index)
+        {
+            SteerOne(Batch, Index, TargetX, TargetY, Alpha);
+        }
+    }
+
+    namespace
+    {
+        /**
+         * 与えられた入力に対してベクトル版とスカラー版の結果を比較する
+         * @return 許容誤差を超えた要素数
+         */
+        int32 CompareVectorizedAgainstScalar(const TArray<float>& PosX, const TArray<float>& PosY, const TArray<float>& Yaw,
+                                             float TargetX, float TargetY, float Tolerance)
+        {
+            const int32 Count = PosX.Num();
+
+            TArray<float> ScalarYaw = Yaw;
+            TArray<float> VectorYaw = Yaw;
+            TArray<float> ScalarDirX, ScalarDirY, VectorDirX, VectorDirY;
+            ScalarDirX.SetNumZeroed(Count);
+            ScalarDirY.SetNumZeroed(Count);
+            VectorDirX.SetNumZeroed(Count);
+            VectorDirY.SetNumZeroed(Count);
+
+            FSteeringBatch ScalarBatch;
+            ScalarBatch.PosX = PosX.GetData();
+            ScalarBatch.PosY = PosY.GetData();
+            ScalarBatch.Yaw = ScalarYaw.GetData();
+            ScalarBatch.OutDirX = ScalarDirX.GetData();
+            ScalarBatch.OutDirY = ScalarDirY.GetData();
+            ScalarBatch.Count = Count;
+
+            FSteeringBatch VectorBatch = ScalarBatch;
+            VectorBatch.Yaw = VectorYaw.GetData();
+            VectorBatch.OutDirX = VectorDirX.GetData();
+            VectorBatch.OutDirY = VectorDirY.GetData();
+
+            const float DeltaTime = 1.0f / 60.0f;
+            const float InterpSpeed = 2.0f;
+            SteerScalar(ScalarBatch, TargetX, TargetY, DeltaTime, InterpSpeed);
+            SteerVectorized(VectorBatch, TargetX, TargetY, DeltaTime, InterpSpeed);
+
+            int32 MismatchCount = 0;
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                const float YawError = FMath::Abs(WrapDegrees(ScalarYaw[Index] - VectorYaw[Index]));
+                const float DirError = FMath::Max(FMath::Abs(ScalarDirX[Index] - VectorDirX[Index]), FMath::Abs(ScalarDirY[Index] - VectorDirY[Index]));
+                if (YawError > Tolerance || DirError > Tolerance)
+                {
+                    if (MismatchCount++ < 8)
+                    {
+                        UE_LOG(LogTemp, Warning, TEXT("ステアリング検証: 要素 %d が一致しません (ヨー誤差: %f, 方向誤差: %f)"), Index, YawError, DirError);
+                    }
+                }
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("ステアリング検証: %d 要素中 %d 要素が不一致でした"), Count, MismatchCount);
+            return MismatchCount;
+        }
+    }
+
+    bool ValidateVectorizedAgainstScalar(int32 Count, int32 Seed, float Tolerance)
+    {
+        FRandomStream Random(Seed);
+
+        TArray<float> PosX, PosY, Yaw;
+        PosX.SetNumUninitialized(Count);
+        PosY.SetNumUninitialized(Count);
+        Yaw.SetNumUninitialized(Count);
+
+        const float TargetX = Random.FRandRange(-1000.0f, 1000.0f);
+        const float TargetY = Random.FRandRange(-1000.0f, 1000.0f);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            PosX[Index] = Random.FRandRange(-5000.0f, 5000.0f);
+            PosY[Index] = Random.FRandRange(-5000.0f, 5000.0f);
+            Yaw[Index] = Random.FRandRange(-180.0f, 180.0f);
+        }
+
+        // 目標と重なるケースも含める
+        if (Count > 0)
+        {
+            PosX[0] = TargetX;
+            PosY[0] = TargetY;
+        }
+
+        return CompareVectorizedAgainstScalar(PosX, PosY, Yaw, TargetX, TargetY, Tolerance) == 0;
+    }
+
+    /** コンソールコマンド: MCP.Shooter.ValidateSteering [要素数] [シード] */
+    static FAutoConsoleCommand ValidateSteeringCommand(
+        TEXT("MCP.Shooter.ValidateSteering"),
+        TEXT("ベクトル版のステアリング計算をスカラー版と比較します。引数: [要素数] [シード]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1021;
+            const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+            ValidateVectorizedAgainstScalar(FMath::Max(Count, 0), Seed);
+        }));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+    IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPShooterSteeringMatchesScalarTest, "MCP.Shooter.Steering.VectorMatchesScalar",
+                                     EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+    bool FMCPShooterSteeringMatchesScalarTest::RunTest(const FString& Parameters)
+    {
+        // 端数の処理（4要素未満・4の倍数・4の倍数+1・大きな端数付き）を全て通す
+        const int32 Counts[] = { 0, 1, 3, 4, 5, 517 };
+        for (const int32 Count : Counts)
+        {
+            for (int32 Seed = 1; Seed <= 4; ++Seed)
+            {
+                TestTrue(FString::Printf(TEXT("ランダムな入力 (要素数 %d, シード %d)"), Count, Seed),
+                         ValidateVectorizedAgainstScalar(Count, Seed));
+            }
+        }
+
+        // 目標の方向が ±180° 付近になる配置で、現在のヨー角も境界の反対側に置く
+        TArray<float> PosX, PosY, Yaw;
+        const float Offsets[] = { 0.0f, 0.01f, -0.01f, 1.0f, -1.0f };
+        const float CurrentYaws[] = { 180.0f, -180.0f, 179.99f, -179.99f, 179.0f, -179.0f, 0.0f };
+        for (const float Offset : Offsets)
+        {
+            for (const float CurrentYaw : CurrentYaws)
+            {
+                PosX.Add(1000.0f);
+                PosY.Add(Offset);
+                Yaw.Add(CurrentYaw);
+            }
+        }
+
+        // 要素数を変えてベクトル部分と端数部分の両方に境界のケースを割り当てる
+        for (int32 Count = 1; Count <= PosX.Num(); ++Count)
+        {
+            const TArray<float> SubPosX(PosX.GetData(), Count);
+            const TArray<float> SubPosY(PosY.GetData(), Count);
+            const TArray<float> SubYaw(Yaw.GetData(), Count);
+            TestTrue(FString::Printf(TEXT("ヨー角の ±180° 付近 (要素数 %d)"), Count),
+                     CompareVectorizedAgainstScalar(SubPosX, SubPosY, SubYaw, 0.0f, 0.0f, 1.0e-3f) == 0);
+        }
+
+        return true;
+    }
+
+#endif
+}
@@ -0,0 +1,65 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 敵の一括ステアリング計算
+ *
+ * 敵の位置（XY平面）から目標への正規化方向と、補間後のヨー角を
+ * 連続したfloat配列に対してまとめて計算します。
+ * ベクトル版はUEのVectorRegister（SSE/NEON）を使い、スカラー版は検証用の参照実装です。
+ */
+namespace MCPShooterSteering
+{
+	/**
+	 * 一括ステアリングの入出力
+	 * 全ての配列はCount要素以上の長さが必要です。
+	 */
+	struct FSteeringBatch
+	{
+		/** 敵のX座標 */
+		const float* PosX = nullptr;
+
+		/** 敵のY座標 */
+		const float* PosY = nullptr;
+
+		/** 敵のヨー角（度）。入力として現在値を受け取り、補間後の値で上書きされます */
+		float* Yaw = nullptr;
+
+		/** 正規化された移動方向のX成分（目標と重なっている場合は0） */
+		float* OutDirX = nullptr;
+
+		/** 正規化された移動方向のY成分（目標と重なっている場合は0） */
+		float* OutDirY = nullptr;
+
+		/** 要素数 */
+		int32 Count = 0;
+	};
+
+	/**
+	 * スカラー版（参照実装）
+	 * @param Batch 入出力配列
+	 * @param TargetX 目標のX座標
+	 * @param TargetY 目標のY座標
+	 * @param DeltaTime 経過時間
+	 * @param InterpSpeed ヨー角の補間速度（0以下の場合は即座に目標を向く）
+	 */
+	SPACESHOOTERGAME_API void SteerScalar(const FSteeringBatch& Batch, float TargetX, float TargetY, float DeltaTime, float InterpSpeed);
+
+	/**
+	 * ベクトル版（4要素ずつ処理し、端数はスカラー版で処理）
+	 * 引数はSteerScalarと同じです。
+	 */
+	SPACESHOOTERGAME_API void SteerVectorized(const FSteeringBatch& Batch, float TargetX, float TargetY, float DeltaTime, float InterpSpeed);
+
+	/**
+	 * ランダムな入力に対してベクトル版とスカラー版の結果を比較する
+	 * @param Count 検証する要素数
+	 * @param Seed 乱数シード
+	 * @param Tolerance 許容誤差（方向は成分の差、ヨー角は度）
+	 * @return 全ての要素が許容誤差内で一致した場合はtrue
+	 */
+	SPACESHOOTERGAME_API bool ValidateVectorizedAgainstScalar(int32 Count, int32 Seed, float Tolerance = 1.0e-3f);
+}
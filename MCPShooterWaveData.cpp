@@ -0,0 +1,132 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPShooterWaveData.h"
+#include "MCPShooterEnemy.h"
+#include "Math/RandomStream.h"
+
+void UMCPShooterWaveData::PostLoad()
+{
+    Super::PostLoad();
+
+    // 保存時に計算済みであれば何もしない（定義が変わった古いアセットのみ計算し直す）
+    for (const FMCPShooterWaveDefinition& Wave : Waves)
+    {
+        if (Wave.SpawnSlots.Num() != Wave.Count)
+        {
+            BuildSpawnSlots();
+            break;
+        }
+    }
+}
+
+#if WITH_EDITOR
+void UMCPShooterWaveData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    BuildSpawnSlots();
+}
+#endif
+
+void UMCPShooterWaveData::BuildSpawnSlots()
+{
+    for (int32 WaveIndex = 0; WaveIndex < Waves.Num(); ++WaveIndex)
+    {
+        BuildWaveSlots(Waves[WaveIndex], WaveIndex);
+    }
+}
+
+void UMCPShooterWaveData::BuildWaveSlots(FMCPShooterWaveDefinition& Wave, int32 WaveIndex) const
+{
+    // X はプレイヤーから離れる方向、Y は左右、Z は上下
+    const int32 Count = FMath::Max(Wave.Count, 1);
+    const float Spacing = FMath::Max(Wave.Spacing, EnemyRadius * 2.0f);
+
+    TArray<FVector>& Slots = Wave.SpawnSlots;
+    Slots.Reset(Count);
+
+    switch (Wave.Formation)
+    {
+    case EMCPShooterWaveFormation::Line:
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Slots.Emplace(0.0f, (Index - (Count - 1) * 0.5f) * Spacing, 0.0f);
+        }
+        break;
+
+    case EMCPShooterWaveFormation::Grid:
+    {
+        const int32 Columns = Wave.Columns > 0 ? Wave.Columns : FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+        const int32 Rows = FMath::DivideAndRoundUp(Count, Columns);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const int32 Column = Index % Columns;
+            const int32 Row = Index / Columns;
+            Slots.Emplace(0.0f, (Column - (Columns - 1) * 0.5f) * Spacing, ((Rows - 1) * 0.5f - Row) * Spacing);
+        }
+        break;
+    }
+
+    case EMCPShooterWaveFormation::Circle:
+    {
+        // 隣り合う敵の弦の長さが間隔以上になる半径
+        const float Radius = Count > 1 ? Spacing / (2.0f * FMath::Sin(PI / Count)) : 0.0f;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const float Angle = 2.0f * PI * Index / Count;
+            Slots.Emplace(0.0f, FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius);
+        }
+        break;
+    }
+
+    case EMCPShooterWaveFormation::VShape:
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            // 先頭を頂点に、左右交互に後ろへ広げる
+            const int32 Rank = (Index + 1) / 2;
+            const float Side = (Index % 2 == 1) ? -1.0f : 1.0f;
+            Slots.Emplace(Rank * Spacing * 0.5f, Side * Rank * Spacing, 0.0f);
+        }
+        break;
+
+    case EMCPShooterWaveFormation::Scatter:
+    {
+        // 既に置いた位置から間隔以上離れた位置が見つかるまで試す
+        FRandomStream Stream(ScatterSeed + WaveIndex);
+        const float MinDistanceSquared = FMath::Square(Spacing);
+        const int32 MaxAttempts = 30;
+        int32 OverflowCount = 0;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            bool bPlaced = false;
+            for (int32 Attempt = 0; Attempt < MaxAttempts && !bPlaced; ++Attempt)
+            {
+                const FVector Candidate(0.0f,
+                    Stream.FRandRange(-Wave.ScatterExtent.X, Wave.ScatterExtent.X),
+                    Stream.FRandRange(-Wave.ScatterExtent.Y, Wave.ScatterExtent.Y));
+
+                bPlaced = !Slots.ContainsByPredicate([&Candidate, MinDistanceSquared](const FVector& Slot)
+                {
+                    return FVector::DistSquared(Slot, Candidate) < MinDistanceSquared;
+                });
+                if (bPlaced)
+                {
+                    Slots.Add(Candidate);
+                }
+            }
+
+            if (!bPlaced)
+            {
+                // 範囲に入りきらない分は後ろに並べる
+                Slots.Emplace(++OverflowCount * Spacing, 0.0f, 0.0f);
+            }
+        }
+
+        if (OverflowCount > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ウェーブ %d の %d 体は範囲に入りきらないため後方に配置しました（範囲か間隔を見直してください）"), WaveIndex, OverflowCount);
+        }
+        break;
+    }
+    }
+}
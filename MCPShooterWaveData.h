@@ -0,0 +1,133 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MCPShooterWaveData.generated.h"
+
+class AMCPShooterEnemy;
+
+/** ウェーブの隊形 */
+UENUM(BlueprintType)
+enum class EMCPShooterWaveFormation : uint8
+{
+	/** 横一列 */
+	Line,
+
+	/** 格子状（プレイヤーから見た上下左右に並べる） */
+	Grid,
+
+	/** 円形 */
+	Circle,
+
+	/** 先頭の1体を頂点としたV字 */
+	VShape,
+
+	/** 範囲内に重ならないようにばらまく（シードで決まる） */
+	Scatter,
+};
+
+/**
+ * 1つのウェーブの定義
+ *
+ * スポーン位置（SpawnSlots）は隊形と間隔からエディタで事前に計算して保存されます。
+ * 間隔は敵の半径の2倍以上に補正されるため、同じウェーブの敵同士は重なりません。
+ */
+USTRUCT(BlueprintType)
+struct FMCPShooterWaveDefinition
+{
+	GENERATED_BODY()
+
+	/** 敵のクラス（未設定の場合はゲームモードの敵クラス） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	TSubclassOf<AMCPShooterEnemy> EnemyClass;
+
+	/** 敵の数 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "1"))
+	int32 Count = 10;
+
+	/** 隊形 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	EMCPShooterWaveFormation Formation = EMCPShooterWaveFormation::Line;
+
+	/** 敵同士の間隔 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "0.0"))
+	float Spacing = 200.0f;
+
+	/** 格子状の場合の列の数（0の場合は正方形に近くなるように決める） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "0", EditCondition = "Formation == EMCPShooterWaveFormation::Grid"))
+	int32 Columns = 0;
+
+	/** ばらまく場合の範囲（プレイヤーから見た左右・上下の半分の大きさ） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (EditCondition = "Formation == EMCPShooterWaveFormation::Scatter"))
+	FVector2D ScatterExtent = FVector2D(1000.0f, 500.0f);
+
+	/** 隊形の中心のプレイヤーからの位置（スポーン開始時のプレイヤーの位置が基準） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	FVector Offset = FVector(1500.0f, 0.0f, 0.0f);
+
+	/** 前のウェーブのスポーンが終わってからこのウェーブを始めるまでの時間（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "0.0"))
+	float StartDelay = 2.0f;
+
+	/** 1体ずつスポーンする間隔（秒、0の場合はスポーンの予算の範囲でまとめてスポーンする） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "0.0"))
+	float SpawnInterval = 0.0f;
+
+	/** 前のウェーブの敵が全て倒されるまで始めないかどうか */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	bool bWaitForClear = false;
+
+	/** 事前に計算したスポーン位置（隊形の中心からの位置） */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	TArray<FVector> SpawnSlots;
+};
+
+/**
+ * シューティングゲームのウェーブのデータアセット
+ *
+ * ウェーブごとの敵の数・隊形・タイミングを定義します。ゲームモードに設定すると、
+ * タイマーで1体ずつスポーンする代わりに、このアセットのウェーブを順に
+ * 1フレームあたりのスポーン時間の予算内で少しずつスポーンします。
+ * スポーン位置は保存時に計算済みのため、実行時には位置の計算も重なりの判定も行いません。
+ */
+UCLASS(BlueprintType)
+class SPACESHOOTERGAME_API UMCPShooterWaveData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** ウェーブの一覧（先頭から順に進む） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	TArray<FMCPShooterWaveDefinition> Waves;
+
+	/** 最後のウェーブの後に先頭に戻るかどうか */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	bool bLoop = true;
+
+	/** 敵の衝突の半径（スポーン位置の間隔の下限は、この2倍） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave", meta = (ClampMin = "1.0"))
+	float EnemyRadius = 60.0f;
+
+	/** ばらまく隊形の乱数シード */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MCP|Shooter|Wave")
+	int32 ScatterSeed = 1;
+
+	/** 全てのウェーブのスポーン位置を計算し直す */
+	void BuildSpawnSlots();
+
+	/** UObjectの実装 */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	/**
+	 * 1つのウェーブのスポーン位置を計算する
+	 * @param Wave 対象のウェーブ
+	 * @param WaveIndex ウェーブの位置（ばらまく隊形の乱数に使う）
+	 */
+	void BuildWaveSlots(FMCPShooterWaveDefinition& Wave, int32 WaveIndex) const;
+};
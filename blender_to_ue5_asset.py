@@ -9,10 +9,13 @@ BlenderからUE5へのアセット転送スクリプト
 そのアセットをUE5にインポートするまでの手順を処理します。
 
 使用方法:
-python blender_to_ue5_asset.py [--model MODEL_NAME] [--format FBX|OBJ|GLB]
+python blender_to_ue5_asset.py [--model MODEL_NAME] [--format FBX|OBJ|GLB|BUFFER]
 
 例:
 python blender_to_ue5_asset.py --model Sword --format fbx
+
+--format buffer を指定すると、ファイルに書き出さずにメッシュのバッファを
+MCPサーバーに直接送信します（UE5側はUMCPAssetManager::ImportBlenderMeshBufferで受け取ります）。
 """
 
 import os
@@ -189,6 +192,78 @@ print(f"エクスポート完了: {export_path}")
         logger.exception(f"Blenderスクリプト実行中にエラーが発生しました: {str(e)}")
         return False
 
+def send_mesh_buffer_from_blender(settings, model_name):
+    """
+    Blenderのメッシュをバイナリのバッファとしてサーバーに送信する
+
+    FBXの書き出し・読み込みと解析を省略し、頂点・インデックス・UVを直接送ります。
+
+    引数:
+        settings (dict): 設定内容
+        model_name (str): モデル名
+
+    戻り値:
+        bool: 成功したかどうか
+    """
+    try:
+        blender_path = settings.get("blender", {}).get("path", "")
+        if not blender_path or not os.path.exists(blender_path):
+            logger.error(f"Blenderパスが無効です: {blender_path}")
+            return False
+        
+        host = settings.get("server", {}).get("host", "127.0.0.1")
+        port = settings.get("server", {}).get("port", 8000)
+        mesh_url = f"http://{host}:{port}/api/blender/mesh/{model_name}"
+        
+        script_dir = settings.get("blender", {}).get("script_dir", "./blender_scripts")
+        os.makedirs(script_dir, exist_ok=True)
+        
+        # Blender内でバッファを作成して送信するスクリプト
+        temp_script_path = os.path.join(script_dir, "send_mesh_buffer.py")
+        with open(temp_script_path, "w", encoding="utf-8") as f:
+            f.write("""
+import bpy
+import sys
+import urllib.request
+
+args = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+mesh_url = args[0]
+sys.path.append(args[1])
+
+from mcp_mesh_buffer import mesh_buffer_from_blender_objects
+
+objects = bpy.context.selected_objects or list(bpy.context.scene.objects)
+buffer = mesh_buffer_from_blender_objects(objects, bpy.context.evaluated_depsgraph_get())
+
+request = urllib.request.Request(mesh_url, data=buffer, method="POST",
+                                 headers={"Content-Type": "application/octet-stream"})
+with urllib.request.urlopen(request, timeout=30) as response:
+    print(f"メッシュバッファを送信しました: {len(buffer)} バイト ({response.status})")
+            """)
+        
+        cmd = [
+            blender_path,
+            "--background",
+            "--python", temp_script_path,
+            "--", mesh_url, os.path.dirname(os.path.abspath(__file__))
+        ]
+        
+        logger.info(f"Blenderコマンドを実行: {' '.join(cmd)}")
+        
+        process = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+        stdout, stderr = process.communicate()
+        
+        if process.returncode == 0:
+            logger.info(f"メッシュバッファの送信に成功しました: {stdout}")
+            return True
+        else:
+            logger.error(f"メッシュバッファの送信に失敗しました: {stderr}")
+            return False
+        
+    except Exception as e:
+        logger.exception(f"メッシュバッファ送信中にエラーが発生しました: {str(e)}")
+        return False
+
 def import_to_ue5(settings, model_name, export_format):
     """
     UE5にモデルをインポートする
@@ -451,7 +526,7 @@ def main():
     parser.add_argument("--model", default="GameAsset", help="モデル名")
     parser.add_argument("--type", default="cube", choices=["cube", "sphere", "cylinder", "cone", "torus", "sword"], 
                         help="作成するモデルタイプ（指定した場合、Blenderでモデルを作成します）")
-    parser.add_argument("--format", default="fbx", choices=["fbx", "obj", "glb"], help="エクスポート形式")
+    parser.add_argument("--format", default="fbx", choices=["fbx", "obj", "glb", "buffer"], help="エクスポート形式")
     parser.add_argument("--create", action="store_true", help="新しいモデルを作成する（既存モデルを使用しない）")
     
     args = parser.parse_args()
@@ -472,6 +547,18 @@ def main():
     print(f"モデル名: {args.model}")
     print(f"形式: {args.format}")
     
+    # バッファ形式の場合はファイルを経由せずに送信する
+    if args.format == "buffer":
+        print("\n1. Blenderからメッシュバッファを送信中...")
+        if not send_mesh_buffer_from_blender(settings, args.model):
+            logger.error("メッシュバッファの送信に失敗しました")
+            return 1
+        
+        print("\n✓ 完了！")
+        print(f"{args.model}のメッシュバッファをMCPサーバーに登録しました。")
+        print("UE5ではUMCPAssetManager::ImportBlenderMeshBufferで受け取れます。")
+        return 0
+    
     # 作成フラグがあるか、typeが指定されている場合はBlenderでモデルを作成
     if args.create or args.type != "cube":
         print(f"モデルタイプ: {args.type}")
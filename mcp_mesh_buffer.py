@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""
+MCPメッシュバッファ
+
+プロシージャルに生成したメッシュを、FBXファイルを経由せずにUE5へ転送するための
+バイナリ形式を扱います。UE5プラグインのFMCPMeshBufferViewと同じ形式です。
+
+形式（リトルエンディアン、各セクションは4バイト境界）:
+    ヘッダー    : b"MCPM"、版、全体のバイト数、頂点数、インデックス数、フラグ（各uint32）
+    位置        : float32 x 3 x 頂点数
+    法線        : float32 x 3 x 頂点数（FLAG_NORMALSの場合）
+    UV          : float32 x 2 x 頂点数（FLAG_UVSの場合）
+    インデックス: uint32 x インデックス数（3つで1つの三角形）
+
+座標はUE5の座標系（センチメートル、Z軸が上、左手系）で格納します。
+Blenderのメッシュから作成する場合は mesh_buffer_from_blender_objects を使用してください。
+"""
+
+import struct
+from array import array
+
+MAGIC = b"MCPM"
+FORMAT_VERSION = 1
+FLAG_NORMALS = 1 << 0
+FLAG_UVS = 1 << 1
+
+_HEADER = struct.Struct("<4sIIIII")
+
+def pack_mesh_buffer(positions, indices, normals=None, uvs=None):
+    """
+    メッシュをバイナリのバッファにまとめる
+
+    引数:
+        positions (list): 頂点の位置（x, y, zを並べた平坦なリスト）
+        indices (list): 三角形のインデックス
+        normals (list): 頂点の法線（x, y, zを並べた平坦なリスト、省略可）
+        uvs (list): 頂点のUV（u, vを並べた平坦なリスト、省略可）
+
+    戻り値:
+        bytes: メッシュバッファ
+    """
+    if len(positions) % 3 != 0 or len(indices) % 3 != 0:
+        raise ValueError("頂点の位置とインデックスの数は3の倍数である必要があります")
+
+    vertex_count = len(positions) // 3
+    flags = 0
+    sections = [array("f", positions)]
+
+    if normals:
+        if len(normals) != vertex_count * 3:
+            raise ValueError("法線の数が頂点数と一致しません")
+        flags |= FLAG_NORMALS
+        sections.append(array("f", normals))
+
+    if uvs:
+        if len(uvs) != vertex_count * 2:
+            raise ValueError("UVの数が頂点数と一致しません")
+        flags |= FLAG_UVS
+        sections.append(array("f", uvs))
+
+    sections.append(array("I", indices))
+
+    # 各セクションはビッグエンディアンの環境でもリトルエンディアンで格納する
+    if struct.pack("=I", 1) != struct.pack("<I", 1):
+        for section in sections:
+            section.byteswap()
+
+    payload = b"".join(section.tobytes() for section in sections)
+    total_bytes = _HEADER.size + len(payload)
+    header = _HEADER.pack(MAGIC, FORMAT_VERSION, total_bytes, vertex_count, len(indices), flags)
+    return header + payload
+
+def read_mesh_buffer_header(buffer):
+    """
+    メッシュバッファのヘッダーを検証して読み取る
+
+    引数:
+        buffer (bytes): メッシュバッファ
+
+    戻り値:
+        dict: 頂点数・インデックス数・フラグ（不正な場合はValueError）
+    """
+    if len(buffer) < _HEADER.size:
+        raise ValueError("メッシュバッファのサイズが不足しています")
+
+    magic, version, total_bytes, vertex_count, index_count, flags = _HEADER.unpack_from(buffer)
+    if magic != MAGIC:
+        raise ValueError("メッシュバッファの形式が不正です")
+    if version != FORMAT_VERSION:
+        raise ValueError(f"メッシュバッファの版に対応していません: {version}")
+    if total_bytes != len(buffer):
+        raise ValueError(f"メッシュバッファのサイズが一致しません: {total_bytes} / {len(buffer)}")
+    if vertex_count == 0 or index_count == 0 or index_count % 3 != 0:
+        raise ValueError("メッシュバッファの頂点数またはインデックス数が不正です")
+
+    floats_per_vertex = 3
+    if flags & FLAG_NORMALS:
+        floats_per_vertex += 3
+    if flags & FLAG_UVS:
+        floats_per_vertex += 2
+    expected_bytes = _HEADER.size + vertex_count * floats_per_vertex * 4 + index_count * 4
+    if expected_bytes != total_bytes:
+        raise ValueError("メッシュバッファのセクションのサイズが一致しません")
+
+    return {
+        "vertex_count": vertex_count,
+        "index_count": index_count,
+        "flags": flags
+    }
+
+def mesh_buffer_from_blender_objects(objects, depsgraph, unit_scale=100.0):
+    """
+    Blenderのメッシュオブジェクトからメッシュバッファを作成する（Blender内で実行）
+
+    モディファイアを適用した状態で三角形分割し、ワールド座標に変換したうえで
+    UE5の座標系（Y軸を反転した左手系、センチメートル）に変換します。
+    頂点はループ単位で出力するため、法線とUVの境界はそのまま保たれます。
+
+    引数:
+        objects (list): メッシュオブジェクト
+        depsgraph: 評価済みの依存グラフ
+        unit_scale (float): Blenderの単位からセンチメートルへの倍率
+
+    戻り値:
+        bytes: メッシュバッファ
+    """
+    positions = array("f")
+    normals = array("f")
+    uvs = array("f")
+    indices = array("I")
+    has_uvs = True
+
+    for obj in objects:
+        if obj.type != "MESH":
+            continue
+
+        evaluated = obj.evaluated_get(depsgraph)
+        mesh = evaluated.to_mesh()
+        try:
+            mesh.calc_loop_triangles()
+            if hasattr(mesh, "calc_normals_split"):
+                mesh.calc_normals_split()
+
+            matrix = obj.matrix_world
+            normal_matrix = matrix.to_3x3().inverted_safe().transposed()
+            uv_layer = mesh.uv_layers.active.data if mesh.uv_layers.active else None
+            has_uvs = has_uvs and uv_layer is not None
+
+            for triangle in mesh.loop_triangles:
+                base = len(positions) // 3
+                for loop_index in triangle.loops:
+                    loop = mesh.loops[loop_index]
+                    co = matrix @ mesh.vertices[loop.vertex_index].co
+                    normal = (normal_matrix @ loop.normal).normalized()
+                    positions.extend((co.x * unit_scale, -co.y * unit_scale, co.z * unit_scale))
+                    normals.extend((normal.x, -normal.y, normal.z))
+                    if uv_layer is not None:
+                        uv = uv_layer[loop_index].uv
+                        uvs.extend((uv.x, 1.0 - uv.y))
+
+                # Y軸の反転で向きが逆になるため、三角形の巻き順も逆にする
+                indices.extend((base, base + 2, base + 1))
+        finally:
+            evaluated.to_mesh_clear()
+
+    return pack_mesh_buffer(positions, indices, normals, uvs if has_uvs else None)
@@ -15,9 +15,13 @@ import time
 import logging
 import platform
 import importlib
-from flask import Flask, request, jsonify
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from flask import Flask, request, jsonify, Response
 from flask_cors import CORS
+from werkzeug.serving import WSGIRequestHandler
 from dotenv import load_dotenv
+from mcp_mesh_buffer import pack_mesh_buffer, read_mesh_buffer_header
 
 # 環境変数の読み込み
 load_dotenv()
@@ -43,6 +47,25 @@ MOCK_MODE = os.getenv("MOCK_MODE", "false").lower() == "true"
 app = Flask(__name__)
 CORS(app)
 
+# ストリーミング（WebSocket）の設定
+try:
+    from flask_sock import Sock
+    sock = Sock(app)
+except ImportError:
+    sock = None
+    logger.warning("flask-sockがインストールされていません。ストリーミング接続は無効化されます。")
+
+# ストリーミング接続中のクライアント（接続ごとに送信用のロックを持つ）
+stream_clients = {}
+stream_clients_lock = threading.Lock()
+
+# ストリーミングで受け取ったコマンドの実行用（長いコマンドが他の応答を止めないようにする）
+stream_executor = ThreadPoolExecutor(max_workers=int(os.getenv("MCP_STREAM_WORKERS", "8")))
+
+# 登録されたメッシュバッファ（メッシュ名ごと、UE5から取得されるまで保持する）
+mesh_buffers = {}
+mesh_buffers_lock = threading.Lock()
+
 # AIサービスの設定
 AI_PROVIDER = os.getenv("AI_PROVIDER", "openai")
 AI_MODEL = os.getenv("AI_MODEL", "gpt-4-turbo")
@@ -107,9 +130,16 @@ def execute_blender_command():
     
     logger.info(f"Blenderコマンド受信: {command}, パラメータ: {params}")
     
+    response = build_blender_command_response(command, params)
+    notify_command_events("blender", command, params, response)
+    return jsonify(response)
+
+# Blenderコマンドのレスポンス作成
+def build_blender_command_response(command, params):
+    """Blenderコマンドを実行し、レスポンスを作成する（HTTP・ストリーミング共通）"""
     # ここでBlenderモジュールと通信するコードを実装
     # 実装例: モック応答
-    response = {
+    return {
         "status": "success",
         "command": command,
         "result": {
@@ -117,21 +147,10 @@ def execute_blender_command():
             "data": params
         }
     }
-    
-    return jsonify(response)
 
-# UE5コマンド実行エンドポイント
-@app.route("/unreal/command", methods=["POST"])
-@app.route("/api/unreal/command", methods=["POST"])
-@app.route("/api/unreal/execute", methods=["POST"])
-def execute_unreal_command():
-    """UE5コマンドを実行する"""
-    data = request.json
-    command = data.get("command")
-    params = data.get("params", {})
-    
-    logger.info(f"UE5コマンド受信: {command}, パラメータ: {params}")
-    
+# UE5コマンドのレスポンス作成
+def build_unreal_command_response(command, params):
+    """UE5コマンドを実行し、レスポンスを作成する（単体・バッチ共通）"""
     # モックレスポンスを詳細化
     mock_responses = {
         "import_asset": {
@@ -184,6 +203,21 @@ def execute_unreal_command():
                 }
             }
         },
+        "place_assets_batch": {
+            "status": "success",
+            "command": command,
+            "result": {
+                "message": f"{len(params.get('placements', []))} 種類のアセットを一括配置しました",
+                "data": params,
+                "placement_info": [
+                    {
+                        "asset": placement.get("asset", ""),
+                        "instance_count": len(placement.get("transforms", []))
+                    }
+                    for placement in params.get("placements", [])
+                ]
+            }
+        },
         "set_game_mode": {
             "status": "success",
             "command": command,
@@ -203,7 +237,7 @@ def execute_unreal_command():
     }
     
     # コマンドに対応するモックレスポンスを返す
-    response = mock_responses.get(command, {
+    return mock_responses.get(command, {
         "status": "success",
         "command": command,
         "result": {
@@ -211,9 +245,227 @@ def execute_unreal_command():
             "data": params
         }
     })
+
+# UE5コマンド実行エンドポイント
+@app.route("/unreal/command", methods=["POST"])
+@app.route("/api/unreal/command", methods=["POST"])
+@app.route("/api/unreal/execute", methods=["POST"])
+def execute_unreal_command():
+    """UE5コマンドを実行する"""
+    data = request.json
+    command = data.get("command")
+    params = data.get("params", {})
+    
+    logger.info(f"UE5コマンド受信: {command}, パラメータ: {params}")
     
+    response = build_unreal_command_response(command, params)
+    notify_command_events("unreal", command, params, response)
     return jsonify(response)
 
+# UE5バッチコマンド実行エンドポイント
+@app.route("/unreal/batch", methods=["POST"])
+@app.route("/api/unreal/batch", methods=["POST"])
+def execute_unreal_batch():
+    """複数のUE5コマンドを順に実行し、コマンドごとの結果をまとめて返す"""
+    data = request.json or {}
+    commands = data.get("commands", [])
+    stop_on_error = data.get("stop_on_error", False)
+    
+    logger.info(f"UE5バッチコマンド受信: {len(commands)} 件")
+    
+    results = []
+    for entry in commands:
+        command = entry.get("command")
+        params = entry.get("params", {})
+        logger.debug(f"UE5コマンド実行: {command}, パラメータ: {params}")
+        
+        try:
+            result = build_unreal_command_response(command, params)
+        except Exception as e:
+            logger.error(f"UE5コマンド実行エラー: {command}: {str(e)}")
+            result = {
+                "status": "error",
+                "command": command,
+                "message": f"コマンド実行エラー: {str(e)}"
+            }
+        
+        notify_command_events("unreal", command, params, result)
+        results.append(result)
+        if stop_on_error and result.get("status") != "success":
+            break
+    
+    succeeded = sum(1 for result in results if result.get("status") == "success")
+    return jsonify({
+        "status": "success" if succeeded == len(commands) else "partial",
+        "count": len(commands),
+        "succeeded": succeeded,
+        "results": results
+    })
+
+# サーバーイベントの配信
+def publish_event(event, data):
+    """ストリーミング接続中の全クライアントにイベントを送信する"""
+    message = json.dumps({"type": "event", "event": event, "data": data}, ensure_ascii=False)
+    
+    with stream_clients_lock:
+        clients = list(stream_clients.items())
+    
+    delivered = 0
+    for ws, send_lock in clients:
+        try:
+            with send_lock:
+                ws.send(message)
+            delivered += 1
+        except Exception as e:
+            logger.debug(f"イベントの送信に失敗しました: {str(e)}")
+    
+    return delivered
+
+def notify_command_events(target, command, params, response):
+    """コマンドの完了に応じたイベントを配信する（クライアントが完了を問い合わせる必要をなくす）"""
+    if not stream_clients or response.get("status") != "success":
+        return
+    
+    result = response.get("result", {})
+    if target == "unreal" and command == "import_asset":
+        publish_event("asset_ready", result.get("asset_info", {}))
+    elif target == "blender" and command.startswith("export"):
+        publish_event("export_complete", {"command": command, "data": params})
+
+# メッシュバッファのエンドポイント
+@app.route("/api/blender/mesh/<name>", methods=["POST", "PUT"])
+def put_mesh_buffer(name):
+    """
+    メッシュバッファを登録する
+
+    application/octet-streamの場合はバイナリをそのまま検証して保持し、
+    JSONの場合は positions / indices / normals / uvs からバッファを作成する。
+    """
+    try:
+        if request.mimetype == "application/json":
+            data = request.json or {}
+            buffer = pack_mesh_buffer(
+                data.get("positions", []),
+                data.get("indices", []),
+                data.get("normals"),
+                data.get("uvs")
+            )
+        else:
+            buffer = request.get_data(cache=False)
+        header = read_mesh_buffer_header(buffer)
+    except ValueError as e:
+        return jsonify({"status": "error", "message": str(e)}), 400
+    
+    with mesh_buffers_lock:
+        mesh_buffers[name] = buffer
+    
+    logger.info(f"メッシュバッファを登録しました: {name} ({len(buffer)} バイト, 頂点 {header['vertex_count']})")
+    
+    info = {"name": name, "bytes": len(buffer), **header}
+    publish_event("mesh_ready", info)
+    return jsonify({"status": "success", "result": info})
+
+@app.route("/api/blender/mesh/<name>", methods=["GET"])
+def get_mesh_buffer(name):
+    """登録されたメッシュバッファをバイナリのまま返す"""
+    with mesh_buffers_lock:
+        buffer = mesh_buffers.get(name)
+    
+    if buffer is None:
+        return jsonify({"status": "error", "message": f"メッシュバッファが見つかりません: {name}"}), 404
+    
+    return Response(buffer, mimetype="application/octet-stream")
+
+@app.route("/api/blender/mesh/<name>", methods=["DELETE"])
+def delete_mesh_buffer(name):
+    """登録されたメッシュバッファを削除する"""
+    with mesh_buffers_lock:
+        removed = mesh_buffers.pop(name, None) is not None
+    
+    return jsonify({"status": "success" if removed else "error", "name": name})
+
+# 外部プロセス（Blenderのエクスポート処理など）からのイベント受付エンドポイント
+@app.route("/api/events", methods=["POST"])
+def post_event():
+    """イベントを受け取り、ストリーミング接続中のクライアントに配信する"""
+    data = request.json or {}
+    event = data.get("event")
+    if not event:
+        return jsonify({"status": "error", "message": "イベント名が指定されていません"}), 400
+    
+    delivered = publish_event(event, data.get("data", {}))
+    logger.info(f"イベントを配信しました: {event} ({delivered} クライアント)")
+    return jsonify({"status": "success", "event": event, "delivered": delivered})
+
+def handle_stream_command(ws, send_lock, message):
+    """ストリーミングで受け取ったコマンドを実行し、相関IDを付けて応答する"""
+    correlation_id = message.get("id")
+    target = message.get("target", "unreal")
+    command = message.get("command")
+    params = message.get("params", {})
+    
+    try:
+        if target == "blender":
+            response = build_blender_command_response(command, params)
+        else:
+            response = build_unreal_command_response(command, params)
+    except Exception as e:
+        logger.error(f"ストリーミングコマンド実行エラー: {command}: {str(e)}")
+        response = {
+            "status": "error",
+            "command": command,
+            "message": f"コマンド実行エラー: {str(e)}"
+        }
+    
+    reply = dict(response)
+    reply["type"] = "response"
+    reply["id"] = correlation_id
+    
+    try:
+        with send_lock:
+            ws.send(json.dumps(reply, ensure_ascii=False))
+    except Exception as e:
+        logger.debug(f"応答の送信に失敗しました: {str(e)}")
+    
+    notify_command_events(target, command, params, response)
+
+def stream_channel(ws):
+    """ストリーミング接続を処理する（コマンドは相関IDで多重化される）"""
+    send_lock = threading.Lock()
+    with stream_clients_lock:
+        stream_clients[ws] = send_lock
+    logger.info(f"ストリーミングクライアントが接続しました ({len(stream_clients)} 接続)")
+    
+    try:
+        while True:
+            raw = ws.receive()
+            if raw is None:
+                break
+            
+            try:
+                message = json.loads(raw)
+            except ValueError:
+                logger.warning(f"不正なストリーミングメッセージを受信しました: {raw[:200]}")
+                continue
+            
+            message_type = message.get("type")
+            if message_type == "command":
+                stream_executor.submit(handle_stream_command, ws, send_lock, message)
+            elif message_type == "ping":
+                with send_lock:
+                    ws.send(json.dumps({"type": "pong", "id": message.get("id")}))
+    except Exception as e:
+        logger.info(f"ストリーミング接続が終了しました: {str(e)}")
+    finally:
+        with stream_clients_lock:
+            stream_clients.pop(ws, None)
+        logger.info(f"ストリーミングクライアントが切断しました ({len(stream_clients)} 接続)")
+
+# ストリーミングエンドポイント
+if sock is not None:
+    sock.route("/ws")(stream_channel)
+    sock.route("/api/stream")(stream_channel)
+
 # AI生成エンドポイント
 @app.route("/api/ai/generate", methods=["POST"])
 def generate_ai_content():
@@ -314,5 +566,8 @@ if __name__ == "__main__":
     server_port = 8080  # 直接8080ポートを使用
     debug_mode = DEBUG_MODE
     
+    # HTTP/1.1で応答し、クライアントがKeep-Alive接続を使い回せるようにする
+    WSGIRequestHandler.protocol_version = "HTTP/1.1"
+    
     logger.info(f"MCPサーバーを起動します: {server_host}:{server_port}")
-    app.run(host=server_host, port=server_port, debug=debug_mode) 
+    app.run(host=server_host, port=server_port, debug=debug_mode, threaded=True) 
@@ -0,0 +1,156 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""
+シューティングゲームのベンチマーク実行スクリプト
+
+AMCPShooterBenchmarkGameModeでUE5を無人起動し、書き出されたCSVを読み取って
+各段階の結果を予算（フレーム時間などの上限）と比較します。
+予算を超えた段階がある場合は終了コード1を返すため、リリース判定に使用できます。
+
+使用方法：
+python run_shooter_benchmark.py [--map /Game/Maps/ShooterMap] [--levels 100,500,2000]
+                                [--duration 20] [--budgets shooter_benchmark_budgets.json]
+
+UE5の実行ファイルとプロジェクトは mcp_settings.json の unreal.path / unreal.project_path を使用します。
+--csv を指定した場合は起動せず、既存のCSVだけを判定します。
+"""
+
+import os
+import sys
+import csv
+import json
+import time
+import logging
+import argparse
+import subprocess
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+GAME_MODE = "/Script/SpaceShooterGame.MCPShooterBenchmarkGameMode"
+
+# 敵の数ごとの既定の予算（ミリ秒、MB）
+DEFAULT_BUDGETS = {
+    "100": {"frame_ms_p99": 16.7, "game_thread_ms_avg": 8.0, "spawn_ms_avg": 0.5, "enemy_bytes_avg": 8192},
+    "500": {"frame_ms_p99": 16.7, "game_thread_ms_avg": 10.0, "spawn_ms_avg": 0.5, "enemy_bytes_avg": 8192},
+    "2000": {"frame_ms_p99": 33.3, "game_thread_ms_avg": 20.0, "spawn_ms_avg": 1.0, "enemy_bytes_avg": 8192}
+}
+
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("shooter_benchmark")
+
+def load_settings():
+    """設定ファイルを読み込む"""
+    settings_path = os.path.join(SCRIPT_DIR, "mcp_settings.json")
+    try:
+        with open(settings_path, "r", encoding="utf-8") as f:
+            return json.load(f)
+    except Exception as e:
+        logger.error(f"設定ファイルの読み込みエラー: {str(e)}")
+        return {}
+
+def load_budgets(path):
+    """予算を読み込む（指定がない場合は既定値）"""
+    if not path:
+        return DEFAULT_BUDGETS
+    with open(path, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+def run_benchmark(args, csv_path):
+    """UE5を無人起動してベンチマークを実行する"""
+    settings = load_settings().get("unreal", {})
+    editor_path = args.editor or settings.get("path")
+    project_path = args.project or settings.get("project_path")
+    if not editor_path or not project_path:
+        logger.error("UE5の実行ファイルまたはプロジェクトのパスが設定されていません")
+        return False
+
+    command = [
+        editor_path,
+        project_path,
+        f"{args.map}?game={GAME_MODE}",
+        "-game",
+        "-unattended",
+        "-nosound",
+        "-benchmark",
+        f"-fps={args.fps}",
+        f"-MCPFixedStepHz={args.fps}",
+        f"-MCPBenchmarkLevels={args.levels}",
+        f"-MCPBenchmarkDuration={args.duration}",
+        f"-MCPBenchmarkSeed={args.seed}",
+        f"-MCPBenchmarkOutput={csv_path}",
+        "-log"
+    ]
+    if args.windowed:
+        command += ["-windowed", "-ResX=1280", "-ResY=720"]
+
+    logger.info(f"ベンチマークを起動します: {' '.join(command)}")
+    start_time = time.time()
+    try:
+        result = subprocess.run(command, timeout=args.timeout)
+    except subprocess.TimeoutExpired:
+        logger.error(f"ベンチマークが{args.timeout}秒以内に終了しませんでした")
+        return False
+
+    logger.info(f"ベンチマークが終了しました（{time.time() - start_time:.1f}秒、終了コード {result.returncode}）")
+    return os.path.exists(csv_path)
+
+def evaluate(csv_path, budgets):
+    """CSVの各段階を予算と比較する"""
+    with open(csv_path, "r", encoding="utf-8") as f:
+        rows = list(csv.DictReader(f))
+
+    if not rows:
+        logger.error(f"ベンチマークの結果が空です: {csv_path}")
+        return False
+
+    passed = True
+    for row in rows:
+        enemies = row["enemies"]
+        logger.info(
+            f"敵 {enemies}体 / 弾丸 {row['projectiles']}発: "
+            f"フレーム p50 {row['frame_ms_p50']}ms p99 {row['frame_ms_p99']}ms, "
+            f"ゲームスレッド {row['game_thread_ms_avg']}ms, スポーン {row['spawn_ms_avg']}ms, "
+            f"メモリ {row['used_physical_mb']}MB, 敵1体 {row.get('enemy_bytes_avg', '-')}バイト")
+
+        for metric, limit in budgets.get(enemies, {}).items():
+            value = float(row[metric])
+            if value > float(limit):
+                logger.error(f"予算超過: 敵 {enemies}体の {metric} = {value} (上限 {limit})")
+                passed = False
+
+    return passed
+
+def main():
+    parser = argparse.ArgumentParser(description='シューティングゲームのベンチマーク実行スクリプト')
+    parser.add_argument('--editor', help='UE5の実行ファイル（省略時は設定ファイル）')
+    parser.add_argument('--project', help='uprojectファイル（省略時は設定ファイル）')
+    parser.add_argument('--map', default='/Game/Maps/ShooterMap', help='ベンチマークに使用するマップ')
+    parser.add_argument('--levels', default='100,500,2000', help='敵の数の段階（カンマ区切り）')
+    parser.add_argument('--duration', type=float, default=20.0, help='各段階の計測時間（秒）')
+    parser.add_argument('--seed', type=int, default=20240601, help='スポーン位置の乱数シード')
+    parser.add_argument('--fps', type=int, default=60, help='固定タイムステップのフレームレート')
+    parser.add_argument('--timeout', type=int, default=900, help='ベンチマーク全体の制限時間（秒）')
+    parser.add_argument('--budgets', help='予算のJSONファイル（敵の数ごとの上限）')
+    parser.add_argument('--output', default=os.path.join(SCRIPT_DIR, 'benchmarks'), help='CSVの出力ディレクトリ')
+    parser.add_argument('--csv', help='既存のCSVを判定する（起動しない）')
+    parser.add_argument('--windowed', action='store_true', help='ウィンドウモードで起動する')
+    args = parser.parse_args()
+
+    budgets = load_budgets(args.budgets)
+
+    csv_path = args.csv
+    if not csv_path:
+        os.makedirs(args.output, exist_ok=True)
+        csv_path = os.path.abspath(os.path.join(args.output, f"ShooterBenchmark-{time.strftime('%Y%m%d-%H%M%S')}.csv"))
+        if not run_benchmark(args, csv_path):
+            logger.error("ベンチマークの結果を取得できませんでした")
+            return 1
+
+    if not evaluate(csv_path, budgets):
+        return 1
+
+    logger.info(f"全ての段階が予算内でした: {csv_path}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
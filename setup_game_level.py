@@ -78,6 +78,44 @@ def execute_unreal_python(script):
         logger.exception(f"UE5スクリプト実行中にエラーが発生しました: {str(e)}")
         return False, {"status": "error", "message": str(e)}
 
+def place_assets_batch(placements):
+    """
+    同じアセットをまとめてUE5のレベルに配置する
+    
+    1アセットにつき1つのインスタンスメッシュとして配置されるため、
+    大量の小物を配置する場合もアクター数が増えません。
+    
+    Args:
+        placements: {"asset": アセットパス, "transforms": [{"location": [x, y, z],
+                    "rotation": [pitch, yaw, roll], "scale": [x, y, z]}, ...]} のリスト
+    """
+    try:
+        data = {
+            "command": "place_assets_batch",
+            "params": {
+                "placements": placements
+            }
+        }
+        
+        response = requests.post(UNREAL_ENDPOINT, json=data)
+        
+        if response.status_code == 200:
+            result = response.json()
+            if result.get("status") == "success":
+                instance_count = sum(len(placement.get("transforms", [])) for placement in placements)
+                logger.info(f"{len(placements)} 種類のアセットを合計 {instance_count} 個配置しました")
+                return True, result
+            else:
+                logger.error(f"アセットの一括配置が失敗しました: {result.get('message')}")
+                return False, result
+        else:
+            logger.error(f"UE5への接続に失敗しました: {response.status_code}")
+            return False, {"status": "error", "message": f"HTTP error: {response.status_code}"}
+            
+    except Exception as e:
+        logger.exception(f"アセットの一括配置中にエラーが発生しました: {str(e)}")
+        return False, {"status": "error", "message": str(e)}
+
 def create_game_level():
     """UE5エディタ内にゲームレベルを作成する"""
     logger.info("UE5エディタ内にゲームレベルを作成しています...")
@@ -30,6 +30,7 @@ public class MCPCpp : ModuleRules
 				"HTTP",
 				"Json",
 				"JsonUtilities",
+				"WebSockets",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -37,17 +38,21 @@ public class MCPCpp : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Slate",
-				"SlateCore",
-				"EditorStyle",
-				"UnrealEd",
-				"LevelEditor",
 				"AssetRegistry",
 				"Projects",
+				"TraceLog",
+				"MeshDescription",
+				"StaticMeshDescription",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
+		// Only needed to place actors in the editor world (WITH_EDITOR); menus and other editor features live in MCPCppEditor
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
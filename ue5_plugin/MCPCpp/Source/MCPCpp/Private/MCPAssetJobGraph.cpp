@@ -0,0 +1,485 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPAssetJobGraph.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+FMCPAssetJobStep FMCPAssetJobStep::MakeBlenderCommand(FName Name, const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                                                      const TArray<FName>& Dependencies)
+{
+    FMCPAssetJobStep Step;
+    Step.Name = Name;
+    Step.Type = EMCPAssetJobStepType::BlenderCommand;
+    Step.Command = Command;
+    Step.Params = Params;
+    Step.Dependencies = Dependencies;
+    return Step;
+}
+
+FMCPAssetJobStep FMCPAssetJobStep::MakeImport(FName Name, const FString& ModelPath, const FString& DestinationPath,
+                                              const TArray<FName>& Dependencies)
+{
+    FMCPAssetJobStep Step;
+    Step.Name = Name;
+    Step.Type = EMCPAssetJobStepType::ImportModel;
+    Step.ModelPath = ModelPath;
+    Step.DestinationPath = DestinationPath;
+    Step.Dependencies = Dependencies;
+    return Step;
+}
+
+FMCPAssetJobStep FMCPAssetJobStep::MakePostProcess(FName Name, TFunction<bool(FString& OutError)> PostProcess,
+                                                   const TArray<FName>& Dependencies)
+{
+    FMCPAssetJobStep Step;
+    Step.Name = Name;
+    Step.Type = EMCPAssetJobStepType::PostProcess;
+    Step.PostProcess = MoveTemp(PostProcess);
+    Step.Dependencies = Dependencies;
+    return Step;
+}
+
+TSharedRef<FMCPAssetJobGraph> FMCPAssetJobGraph::Start(UMCPAssetManager* AssetManager, const TArray<FMCPAssetJobStep>& Steps,
+                                                       int32 MaxBlenderWorkers, FOnStepComplete OnStepComplete, FOnComplete OnComplete)
+{
+    TSharedRef<FMCPAssetJobGraph> Graph = MakeShareable(new FMCPAssetJobGraph(
+        AssetManager, Steps, MaxBlenderWorkers, MoveTemp(OnStepComplete), MoveTemp(OnComplete)));
+
+    FString Error;
+    if (!Graph->BuildGraph(Error))
+    {
+        // 不正なグラフは1つも実行せずに全て失敗とする
+        UE_LOG(LogTemp, Error, TEXT("アセットジョブを開始できませんでした: %s"), *Error);
+        for (FMCPAssetJobStepResult& Result : Graph->Results)
+        {
+            Result.Status = EMCPAssetJobStepStatus::Failed;
+            Result.ErrorMessage = Error;
+        }
+        Graph->CompletedCount = Graph->Results.Num();
+        Graph->NotifyIfComplete();
+        return Graph;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("アセットジョブを開始します: %d ステップ (Blenderのワーカー %d / クリティカルパスの見積もり %.1f秒)"),
+           Graph->GetTotalCount(), Graph->BlenderWorkersBusy.Num(), Graph->CriticalPathSeconds);
+
+    Graph->Pump();
+    Graph->NotifyIfComplete();
+    return Graph;
+}
+
+FMCPAssetJobGraph::FMCPAssetJobGraph(UMCPAssetManager* InAssetManager, const TArray<FMCPAssetJobStep>& InSteps, int32 InMaxBlenderWorkers,
+                                     FOnStepComplete InOnStepComplete, FOnComplete InOnComplete)
+    : AssetManager(InAssetManager)
+    , Steps(InSteps)
+    , OnStepComplete(MoveTemp(InOnStepComplete))
+    , OnComplete(MoveTemp(InOnComplete))
+    , CriticalPathSeconds(0.0)
+    , RetryDelaySeconds(1.0f)
+    , StartSeconds(FPlatformTime::Seconds())
+    , RunningCount(0)
+    , CompletedCount(0)
+    , bCancelled(false)
+    , bCompleteNotified(false)
+    , bPumping(false)
+{
+    Results.SetNum(Steps.Num());
+    for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+    {
+        Results[StepIndex].Name = Steps[StepIndex].Name;
+    }
+
+    BlenderWorkersBusy.Init(false, FMath::Max(InMaxBlenderWorkers, 1));
+}
+
+FMCPAssetJobGraph::~FMCPAssetJobGraph()
+{
+    for (const TPair<int32, FTSTicker::FDelegateHandle>& Pair : RetryHandles)
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(Pair.Value);
+    }
+}
+
+bool FMCPAssetJobGraph::BuildGraph(FString& OutError)
+{
+    const int32 NumSteps = Steps.Num();
+
+    TMap<FName, int32> StepIndices;
+    StepIndices.Reserve(NumSteps);
+    for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+    {
+        if (StepIndices.Contains(Steps[StepIndex].Name))
+        {
+            OutError = FString::Printf(TEXT("ステップ名 '%s' が重複しています"), *Steps[StepIndex].Name.ToString());
+            return false;
+        }
+        StepIndices.Add(Steps[StepIndex].Name, StepIndex);
+    }
+
+    Dependents.SetNum(NumSteps);
+    RemainingDependencies.Init(0, NumSteps);
+    for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+    {
+        for (const FName& Dependency : Steps[StepIndex].Dependencies)
+        {
+            const int32* DependencyIndex = StepIndices.Find(Dependency);
+            if (!DependencyIndex)
+            {
+                OutError = FString::Printf(TEXT("ステップ '%s' の依存 '%s' が見つかりません"), *Steps[StepIndex].Name.ToString(), *Dependency.ToString());
+                return false;
+            }
+            Dependents[*DependencyIndex].Add(StepIndex);
+            RemainingDependencies[StepIndex]++;
+        }
+    }
+
+    // 依存のないステップから順に並べ、全てのステップを並べられなければ循環している
+    TArray<int32> Order;
+    TArray<int32> InDegrees = RemainingDependencies;
+    Order.Reserve(NumSteps);
+    for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+    {
+        if (InDegrees[StepIndex] == 0)
+        {
+            Order.Add(StepIndex);
+        }
+    }
+    for (int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex)
+    {
+        for (int32 Dependent : Dependents[Order[OrderIndex]])
+        {
+            if (--InDegrees[Dependent] == 0)
+            {
+                Order.Add(Dependent);
+            }
+        }
+    }
+    if (Order.Num() != NumSteps)
+    {
+        OutError = TEXT("ステップの依存が循環しています");
+        return false;
+    }
+
+    // 後ろから順に、そのステップから最後までの所要時間の見積もりを求める
+    Priorities.Init(0.0, NumSteps);
+    for (int32 OrderIndex = NumSteps - 1; OrderIndex >= 0; --OrderIndex)
+    {
+        const int32 StepIndex = Order[OrderIndex];
+        double LongestDependent = 0.0;
+        for (int32 Dependent : Dependents[StepIndex])
+        {
+            LongestDependent = FMath::Max(LongestDependent, Priorities[Dependent]);
+        }
+        Priorities[StepIndex] = FMath::Max(Steps[StepIndex].EstimatedSeconds, 0.0f) + LongestDependent;
+        CriticalPathSeconds = FMath::Max(CriticalPathSeconds, Priorities[StepIndex]);
+    }
+
+    StartTimes.Init(0.0, NumSteps);
+    for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+    {
+        if (RemainingDependencies[StepIndex] == 0)
+        {
+            ReadySteps.Add(StepIndex);
+        }
+    }
+    return true;
+}
+
+void FMCPAssetJobGraph::Cancel()
+{
+    if (bCancelled || bCompleteNotified)
+    {
+        return;
+    }
+
+    bCancelled = true;
+    ReadySteps.Empty();
+
+    // 実行中のステップは完了を待ち、それ以外の未実行のステップを取り消しとして集計する
+    for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+    {
+        if (Results[StepIndex].Status == EMCPAssetJobStepStatus::Pending)
+        {
+            if (FTSTicker::FDelegateHandle* RetryHandle = RetryHandles.Find(StepIndex))
+            {
+                FTSTicker::GetCoreTicker().RemoveTicker(*RetryHandle);
+                RetryHandles.Remove(StepIndex);
+            }
+
+            Results[StepIndex].ErrorMessage = TEXT("アセットジョブは取り消されました");
+            CompleteStep(StepIndex, EMCPAssetJobStepStatus::Cancelled);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("アセットジョブを取り消しました (実行中 %d ステップ)"), RunningCount);
+
+    NotifyIfComplete();
+}
+
+EMCPAssetJobStepStatus FMCPAssetJobGraph::GetStepStatus(FName StepName) const
+{
+    const FMCPAssetJobStepResult* Result = Results.FindByPredicate([StepName](const FMCPAssetJobStepResult& Candidate)
+    {
+        return Candidate.Name == StepName;
+    });
+    return Result ? Result->Status : EMCPAssetJobStepStatus::Failed;
+}
+
+int32 FMCPAssetJobGraph::FindFreeBlenderWorker() const
+{
+    return BlenderWorkersBusy.IndexOfByKey(false);
+}
+
+void FMCPAssetJobGraph::Pump()
+{
+    if (bPumping)
+    {
+        return;
+    }
+
+    TGuardValue<bool> PumpGuard(bPumping, true);
+
+    // キャッシュの利用などで同期的に完了したステップにより、新しく実行可能になったステップも続けて開始する
+    bool bDispatched = true;
+    while (bDispatched && !bCancelled)
+    {
+        bDispatched = false;
+
+        // 残りの所要時間が長いステップから開始する
+        ReadySteps.StableSort([this](int32 A, int32 B) { return Priorities[A] > Priorities[B]; });
+
+        int32 ReadyIndex = 0;
+        while (ReadyIndex < ReadySteps.Num() && !bCancelled)
+        {
+            const int32 StepIndex = ReadySteps[ReadyIndex];
+            int32 WorkerIndex = INDEX_NONE;
+            if (Steps[StepIndex].Type == EMCPAssetJobStepType::BlenderCommand)
+            {
+                WorkerIndex = FindFreeBlenderWorker();
+                if (WorkerIndex == INDEX_NONE)
+                {
+                    ++ReadyIndex;
+                    continue;
+                }
+            }
+
+            ReadySteps.RemoveAt(ReadyIndex);
+            Dispatch(StepIndex, WorkerIndex);
+            bDispatched = true;
+        }
+    }
+}
+
+void FMCPAssetJobGraph::Dispatch(int32 StepIndex, int32 WorkerIndex)
+{
+    FMCPAssetJobStepResult& Result = Results[StepIndex];
+    Result.Status = EMCPAssetJobStepStatus::Running;
+    Result.Attempts++;
+    StartTimes[StepIndex] = FPlatformTime::Seconds();
+    RunningCount++;
+
+    if (!AssetManager.IsValid() && Steps[StepIndex].Type != EMCPAssetJobStepType::PostProcess)
+    {
+        HandleStepFinished(StepIndex, false, TEXT("MCPアセットマネージャーが破棄されました"));
+        return;
+    }
+
+    switch (Steps[StepIndex].Type)
+    {
+    case EMCPAssetJobStepType::BlenderCommand:
+        RunBlenderCommand(StepIndex, WorkerIndex);
+        break;
+
+    case EMCPAssetJobStepType::ImportModel:
+        RunImport(StepIndex);
+        break;
+
+    case EMCPAssetJobStepType::PostProcess:
+        RunPostProcess(StepIndex);
+        break;
+    }
+}
+
+void FMCPAssetJobGraph::RunBlenderCommand(int32 StepIndex, int32 WorkerIndex)
+{
+    const FMCPAssetJobStep& Step = Steps[StepIndex];
+
+    // 同時に送る他のコマンドと別のBlenderで処理されるように、ワーカーの番号を付ける
+    TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+    if (Step.Params.IsValid())
+    {
+        Params->Values = Step.Params->Values;
+    }
+    Params->SetNumberField(TEXT("worker"), WorkerIndex);
+    BlenderWorkersBusy[WorkerIndex] = true;
+
+    // 完了コールバックがジョブを保持するため、全ステップ完了まで破棄されない
+    TSharedRef<FMCPAssetJobGraph> Self = AsShared();
+    AssetManager->ExecuteBlenderCommand(Step.Command, Params,
+        [Self, StepIndex, WorkerIndex](bool bSuccess, const TSharedPtr<FJsonObject>& Response)
+        {
+            Self->BlenderWorkersBusy[WorkerIndex] = false;
+            Self->Results[StepIndex].Response = Response;
+
+            FString ErrorMessage;
+            if (!bSuccess)
+            {
+                if (!Response.IsValid() || !Response->TryGetStringField(TEXT("message"), ErrorMessage))
+                {
+                    ErrorMessage = FString::Printf(TEXT("Blenderのコマンド '%s' が失敗しました"), *Self->Steps[StepIndex].Command);
+                }
+            }
+            Self->HandleStepFinished(StepIndex, bSuccess, ErrorMessage);
+        });
+}
+
+void FMCPAssetJobGraph::RunImport(int32 StepIndex)
+{
+    const FMCPAssetJobStep& Step = Steps[StepIndex];
+
+    TSharedRef<FMCPAssetJobGraph> Self = AsShared();
+    AssetManager->ImportBlenderModel(Step.ModelPath, Step.DestinationPath,
+        [Self, StepIndex](const FMCPAssetImportResult& ImportResult)
+        {
+            Self->Results[StepIndex].ImportResult = ImportResult;
+            Self->HandleStepFinished(StepIndex, ImportResult.bSuccess, ImportResult.ErrorMessage);
+        });
+}
+
+void FMCPAssetJobGraph::RunPostProcess(int32 StepIndex)
+{
+    if (!Steps[StepIndex].PostProcess)
+    {
+        HandleStepFinished(StepIndex, true, FString());
+        return;
+    }
+
+    // ワーカースレッドで実行し、結果はゲームスレッドで受け取る
+    TSharedRef<FMCPAssetJobGraph> Self = AsShared();
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Self, StepIndex]() mutable
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(FMCPAssetJobGraph::PostProcess);
+
+        FString ErrorMessage;
+        const bool bSuccess = Self->Steps[StepIndex].PostProcess(ErrorMessage);
+
+        AsyncTask(ENamedThreads::GameThread, [Self = MoveTemp(Self), StepIndex, bSuccess, ErrorMessage = MoveTemp(ErrorMessage)]()
+        {
+            Self->HandleStepFinished(StepIndex, bSuccess, ErrorMessage);
+        });
+    });
+}
+
+void FMCPAssetJobGraph::HandleStepFinished(int32 StepIndex, bool bSuccess, const FString& ErrorMessage)
+{
+    check(IsInGameThread());
+
+    RunningCount--;
+    Results[StepIndex].DurationSeconds = FPlatformTime::Seconds() - StartTimes[StepIndex];
+    Results[StepIndex].ErrorMessage = bSuccess ? FString() : ErrorMessage;
+
+    if (bSuccess)
+    {
+        CompleteStep(StepIndex, EMCPAssetJobStepStatus::Succeeded);
+    }
+    else if (!bCancelled && Results[StepIndex].Attempts <= Steps[StepIndex].MaxRetries)
+    {
+        ScheduleRetry(StepIndex);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("アセットジョブのステップ '%s' が失敗しました (%d 回実行): %s"),
+               *Steps[StepIndex].Name.ToString(), Results[StepIndex].Attempts, *ErrorMessage);
+        CompleteStep(StepIndex, EMCPAssetJobStepStatus::Failed);
+    }
+
+    Pump();
+    NotifyIfComplete();
+}
+
+void FMCPAssetJobGraph::ScheduleRetry(int32 StepIndex)
+{
+    FMCPAssetJobStepResult& Result = Results[StepIndex];
+    Result.Status = EMCPAssetJobStepStatus::Pending;
+
+    const float Delay = RetryDelaySeconds * static_cast<float>(1 << FMath::Min(Result.Attempts - 1, 10));
+    UE_LOG(LogTemp, Warning, TEXT("アセットジョブのステップ '%s' を %.1f 秒後に再試行します (%d / %d): %s"),
+           *Steps[StepIndex].Name.ToString(), Delay, Result.Attempts, Steps[StepIndex].MaxRetries, *Result.ErrorMessage);
+
+    TWeakPtr<FMCPAssetJobGraph> WeakThis = AsShared();
+    RetryHandles.Add(StepIndex, FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakThis, StepIndex](float DeltaTime)
+        {
+            if (TSharedPtr<FMCPAssetJobGraph> This = WeakThis.Pin())
+            {
+                This->RetryHandles.Remove(StepIndex);
+                if (!This->bCancelled && This->Results[StepIndex].Status == EMCPAssetJobStepStatus::Pending)
+                {
+                    This->ReadySteps.Add(StepIndex);
+                    This->Pump();
+                    This->NotifyIfComplete();
+                }
+            }
+            return false;
+        }), Delay));
+}
+
+void FMCPAssetJobGraph::CompleteStep(int32 StepIndex, EMCPAssetJobStepStatus Status)
+{
+    FMCPAssetJobStepResult& Result = Results[StepIndex];
+    Result.Status = Status;
+    CompletedCount++;
+
+    if (OnStepComplete)
+    {
+        OnStepComplete(CompletedCount, Steps.Num(), Result);
+    }
+
+    if (Status == EMCPAssetJobStepStatus::Succeeded)
+    {
+        // 全ての依存が成功したステップを実行可能にする
+        for (int32 Dependent : Dependents[StepIndex])
+        {
+            if (--RemainingDependencies[Dependent] == 0 && !bCancelled && Results[Dependent].Status == EMCPAssetJobStepStatus::Pending)
+            {
+                ReadySteps.Add(Dependent);
+            }
+        }
+    }
+    else if (Status != EMCPAssetJobStepStatus::Cancelled)
+    {
+        // 失敗したステップに依存するステップは、間接的な依存も含めて省略する
+        for (int32 Dependent : Dependents[StepIndex])
+        {
+            if (Results[Dependent].Status == EMCPAssetJobStepStatus::Pending)
+            {
+                Results[Dependent].ErrorMessage = FString::Printf(TEXT("依存するステップ '%s' が失敗しました"), *Steps[StepIndex].Name.ToString());
+                CompleteStep(Dependent, EMCPAssetJobStepStatus::Skipped);
+            }
+        }
+    }
+}
+
+void FMCPAssetJobGraph::NotifyIfComplete()
+{
+    if (bCompleteNotified || bPumping || CompletedCount < Steps.Num())
+    {
+        return;
+    }
+
+    bCompleteNotified = true;
+
+    int32 SucceededCount = 0;
+    for (const FMCPAssetJobStepResult& Result : Results)
+    {
+        SucceededCount += Result.Status == EMCPAssetJobStepStatus::Succeeded ? 1 : 0;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("アセットジョブが完了しました: 成功 %d / %d ステップ (%.1f秒、クリティカルパスの見積もり %.1f秒)"),
+           SucceededCount, Steps.Num(), FPlatformTime::Seconds() - StartSeconds, CriticalPathSeconds);
+
+    if (OnComplete)
+    {
+        OnComplete(Results);
+    }
+}
@@ -1,19 +1,72 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPAssetManager.h"
+#include "MCPMeshBuffer.h"
+#include "MCPStats.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorFramework/AssetImportData.h"
 #include "Engine/StaticMeshActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/GameModeBase.h"
 #include "Engine/World.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR
 #include "Editor.h"
-#include "EditorLevelLibrary.h"
+#endif
+
+namespace
+{
+    /** インポート設定の版（インポート方法を変えた場合に上げると既存のキャッシュが無効になる） */
+    const int32 ImportSettingsVersion = 1;
+    
+    /** インポートマニフェストのファイル名 */
+    const TCHAR* ImportManifestFileName = TEXT("mcp_import_manifest.json");
+    
+    /** フォルダのパスを前方一致の比較用に末尾を"/"にする */
+    FString MakeRootPath(const FString& PackagePath)
+    {
+        return PackagePath.EndsWith(TEXT("/")) ? PackagePath : PackagePath + TEXT("/");
+    }
+    
+    /** コマンドの記録を開始するコンソールコマンド */
+    FAutoConsoleCommand StartRecordingCommand(
+        TEXT("MCP.StartRecording"),
+        TEXT("MCPサーバーへのコマンドの記録を開始します（引数: ログファイルのパス、省略可）"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            UMCPAssetManager::Get()->StartCommandRecording(Args.Num() > 0 ? Args[0] : FString());
+        }));
+    
+    /** コマンドの記録を終了するコンソールコマンド */
+    FAutoConsoleCommand StopRecordingCommand(
+        TEXT("MCP.StopRecording"),
+        TEXT("MCPサーバーへのコマンドの記録を終了します"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            UMCPAssetManager::Get()->StopCommandRecording();
+        }));
+}
 
 // シングルトンインスタンスの初期化
 UMCPAssetManager* UMCPAssetManager::Instance = nullptr;
 
 UMCPAssetManager::UMCPAssetManager()
-    : bInitialized(false)
+    : ServerHealth(EServerHealth::Unknown)
+    , ServerHealthCheckTime(0.0)
+    , HealthCheckTTLSeconds(5.0)
+    , bInitialized(false)
+    , bConfigured(false)
 {
     // MCPClientの作成
     MCPClient = MakeShared<FMCPClient>();
@@ -36,78 +89,994 @@ bool UMCPAssetManager::Initialize()
     {
         return true;
     }
+    bInitialized = true;
+    
+    // ファイルの読み込みと解析はワーカースレッドで行い、ゲームスレッドは待たない
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis]()
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::LoadConfig);
+        
+        FLoadedConfig Config = LoadConfig();
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Config = MoveTemp(Config)]() mutable
+        {
+            if (WeakThis.IsValid())
+            {
+                WeakThis->ApplyConfig(MoveTemp(Config));
+            }
+        });
+    });
+    
+    return true;
+}
+
+UMCPAssetManager::FLoadedConfig UMCPAssetManager::LoadConfig()
+{
+    FLoadedConfig Config;
     
     // 設定ファイルからMCPサーバーURLの読み込みを試みる
     FString ConfigFilePath = FPaths::ProjectConfigDir() / TEXT("mcp_settings.json");
-    if (FPaths::FileExists(ConfigFilePath))
+    FString JsonContent;
+    if (FFileHelper::LoadFileToString(JsonContent, *ConfigFilePath))
     {
-        FString JsonContent;
-        if (FFileHelper::LoadFileToString(JsonContent, *ConfigFilePath))
+        TSharedPtr<FJsonObject> JsonObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
+        if (FJsonSerializer::Deserialize(Reader, JsonObject))
         {
-            TSharedPtr<FJsonObject> JsonObject;
-            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
-            if (FJsonSerializer::Deserialize(Reader, JsonObject))
+            const TSharedPtr<FJsonObject>* ServerObj;
+            if (JsonObject->TryGetObjectField(TEXT("server"), ServerObj))
             {
-                const TSharedPtr<FJsonObject>* ServerObj;
-                if (JsonObject->TryGetObjectField(TEXT("server"), ServerObj))
-                {
-                    FString Host = (*ServerObj)->GetStringField(TEXT("host"));
-                    int32 Port = (*ServerObj)->GetIntegerField(TEXT("port"));
-                    FString ServerUrl = FString::Printf(TEXT("http://%s:%d"), *Host, Port);
-                    MCPClient->SetServerURL(ServerUrl);
-                }
+                FString Host = (*ServerObj)->GetStringField(TEXT("host"));
+                int32 Port = (*ServerObj)->GetIntegerField(TEXT("port"));
+                Config.ServerURL = FString::Printf(TEXT("http://%s:%d"), *Host, Port);
+                
+                // 同時接続数とキューの上限（省略時は既定値）
+                (*ServerObj)->TryGetNumberField(TEXT("max_concurrent_requests"), Config.MaxConcurrentRequests);
+                (*ServerObj)->TryGetNumberField(TEXT("max_queued_requests"), Config.MaxQueuedRequests);
+                
+                // サーバーの状態を保持する時間（秒）
+                (*ServerObj)->TryGetNumberField(TEXT("health_check_ttl"), Config.HealthCheckTTLSeconds);
+                
+                // ストリーミング接続（サーバーからのイベント受信）を使用するか
+                (*ServerObj)->TryGetBoolField(TEXT("streaming"), Config.bUseStreaming);
             }
         }
     }
     
-    bInitialized = true;
-    return true;
+    FString ManifestContent;
+    if (FFileHelper::LoadFileToString(ManifestContent, *GetImportManifestPath()))
+    {
+        if (!ParseImportManifest(ManifestContent, Config.ImportCache))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("インポートマニフェストの読み込みに失敗しました: %s"), *GetImportManifestPath());
+        }
+    }
+    
+    return Config;
+}
+
+void UMCPAssetManager::ApplyConfig(FLoadedConfig&& Config)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::ApplyConfig);
+    
+    if (!Config.ServerURL.IsEmpty())
+    {
+        MCPClient->SetServerURL(Config.ServerURL);
+        MCPClient->SetConcurrencyLimits(Config.MaxConcurrentRequests, Config.MaxQueuedRequests);
+        if (Config.HealthCheckTTLSeconds >= 0.0)
+        {
+            HealthCheckTTLSeconds = Config.HealthCheckTTLSeconds;
+        }
+    }
+    
+    ImportCache = MoveTemp(Config.ImportCache);
+    UE_LOG(LogTemp, Log, TEXT("インポートマニフェストを読み込みました: %d 件"), ImportCache.Num());
+    
+    // インポートしたアセットのインデックスは、以降はアセットレジストリのイベントで更新する
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.OnAssetAdded().AddUObject(this, &UMCPAssetManager::HandleRegistryAssetAdded);
+    AssetRegistry.OnAssetRenamed().AddUObject(this, &UMCPAssetManager::HandleRegistryAssetRenamed);
+    AssetRegistry.OnAssetRemoved().AddUObject(this, &UMCPAssetManager::HandleRegistryAssetRemoved);
+    
+    // マニフェストにあるインポート先のフォルダを登録し、見つかったアセットにソースファイルを対応付ける
+    for (const TPair<FString, FImportCacheEntry>& Pair : ImportCache)
+    {
+        AddIndexedRoot(FPackageName::GetLongPackagePath(Pair.Value.AssetPath));
+        
+        const FName PackageName(*Pair.Value.AssetPath);
+        if (const FImportedAsset* ImportedAsset = ImportedAssets.Find(PackageName))
+        {
+            AddImportedAsset(PackageName, ImportedAsset->AssetName, MakeSourceKey(Pair.Value.SourcePath));
+        }
+    }
+    
+    // ストリーミング接続の状態が変わった場合は、問い合わせを待たずにサーバーの状態に反映する
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    MCPClient->GetStreamClient().OnConnectionChanged().AddLambda([WeakThis](bool bConnected)
+    {
+        if (WeakThis.IsValid())
+        {
+            if (bConnected)
+            {
+                WeakThis->UpdateServerHealth(true, TEXT("ストリーミング接続を確立しました"));
+            }
+            else
+            {
+                WeakThis->InvalidateServerHealth();
+            }
+        }
+    });
+    
+    if (!Config.ServerURL.IsEmpty() && Config.bUseStreaming)
+    {
+        MCPClient->ConnectStream();
+    }
+    
+    bConfigured = true;
+    
+    // 読み込み中に呼ばれたコマンドも記録されるように、保留中の処理より先に記録を開始する
+    FString RecordPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("-MCPRecord="), RecordPath))
+    {
+        StartCommandRecording(RecordPath);
+    }
+    
+    // 設定の読み込み中に呼ばれた処理を、呼ばれた順に実行する
+    TArray<TFunction<void()>> Tasks = MoveTemp(PendingConfiguredTasks);
+    for (TFunction<void()>& Task : Tasks)
+    {
+        Task();
+    }
+}
+
+void UMCPAssetManager::RunWhenConfigured(TFunction<void()> Task)
+{
+    if (bConfigured)
+    {
+        Task();
+    }
+    else
+    {
+        PendingConfiguredTasks.Add(MoveTemp(Task));
+    }
+}
+
+void UMCPAssetManager::BeginDestroy()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().RemoveAll(this);
+        AssetRegistry.OnAssetRenamed().RemoveAll(this);
+        AssetRegistry.OnAssetRemoved().RemoveAll(this);
+    }
+    
+    Super::BeginDestroy();
+}
+
+FString UMCPAssetManager::StartCommandRecording(const FString& FilePath)
+{
+    const FString RecordPath = !FilePath.IsEmpty() ? FilePath
+        : FPaths::ProjectSavedDir() / TEXT("MCP/Recordings") / FString::Printf(TEXT("MCPCommands_%s.mcprec"), *FDateTime::Now().ToString());
+    
+    // 記録にはサーバーのURLが必要なため、設定の読み込み後に開始する
+    RunWhenConfigured([this, RecordPath]()
+    {
+        MCPClient->StartRecording(RecordPath);
+    });
+    return RecordPath;
+}
+
+void UMCPAssetManager::StopCommandRecording()
+{
+    RunWhenConfigured([this]()
+    {
+        MCPClient->StopRecording();
+    });
+}
+
+FMCPStreamClient::FOnServerEvent& UMCPAssetManager::OnServerEvent()
+{
+    return MCPClient->GetStreamClient().OnServerEvent();
 }
 
 void UMCPAssetManager::CheckServerConnection(TFunction<void(bool bSuccess, const FString& Message)> OnCompleteCallback)
 {
-    MCPClient->CheckConnection(OnCompleteCallback);
+    // 設定を読み込むまでは接続先が決まらないため、読み込み後に確認する
+    if (!bConfigured)
+    {
+        RunWhenConfigured([this, OnCompleteCallback = MoveTemp(OnCompleteCallback)]() mutable
+        {
+            CheckServerConnection(MoveTemp(OnCompleteCallback));
+        });
+        return;
+    }
+    
+    // 有効期限内であれば前回の結果を返す
+    if (ServerHealth != EServerHealth::Unknown && FPlatformTime::Seconds() - ServerHealthCheckTime < HealthCheckTTLSeconds)
+    {
+        OnCompleteCallback(IsServerHealthy(), ServerHealthMessage);
+        return;
+    }
+    
+    // 確認中の場合は、同じステータスのリクエストの応答を共有する
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    MCPClient->CheckConnection([WeakThis, OnCompleteCallback](bool bSuccess, const FString& Message)
+    {
+        if (WeakThis.IsValid())
+        {
+            WeakThis->UpdateServerHealth(bSuccess, Message);
+        }
+        
+        OnCompleteCallback(bSuccess, Message);
+    });
+}
+
+void UMCPAssetManager::InvalidateServerHealth()
+{
+    ServerHealthCheckTime = 0.0;
+}
+
+void UMCPAssetManager::UpdateServerHealth(bool bHealthy, const FString& Message)
+{
+    const EServerHealth NewHealth = bHealthy ? EServerHealth::Healthy : EServerHealth::Unreachable;
+    const bool bChanged = NewHealth != ServerHealth;
+    
+    ServerHealth = NewHealth;
+    ServerHealthMessage = Message;
+    ServerHealthCheckTime = FPlatformTime::Seconds();
+    
+    // 状態が変わった時だけ通知する（呼び出し元ごとのログは出さない）
+    if (bChanged)
+    {
+        if (bHealthy)
+        {
+            UE_LOG(LogTemp, Log, TEXT("MCPサーバーに接続しました: %s"), *Message);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPサーバーに接続できませんでした: %s"), *Message);
+        }
+        
+        ServerHealthChanged.Broadcast(bHealthy, Message);
+    }
 }
 
 void UMCPAssetManager::ImportBlenderModel(const FString& ModelPath, const FString& DestinationPath,
                                      TFunction<void(const FMCPAssetImportResult& Result)> OnCompleteCallback)
 {
-    MCPClient->ImportAsset(ModelPath, DestinationPath, 
-        [OnCompleteCallback, ModelPath, DestinationPath](bool bSuccess, const FString& AssetName)
+    SCOPE_CYCLE_COUNTER(STAT_MCPImportBlenderModel);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::ImportBlenderModel);
+    
+    // インポートキャッシュと接続先は設定の読み込み後に有効になる
+    if (!bConfigured)
+    {
+        RunWhenConfigured([this, ModelPath, DestinationPath, OnCompleteCallback = MoveTemp(OnCompleteCallback)]() mutable
+        {
+            ImportBlenderModel(ModelPath, DestinationPath, MoveTemp(OnCompleteCallback));
+        });
+        return;
+    }
+    
+    // ソースが変わっていなければサーバーに問い合わせずに前回の結果を返す（ハッシュはワーカースレッドで計算する）
+    ResolveImportCacheKeys({ ModelPath }, DestinationPath,
+        [this, ModelPath, DestinationPath, OnCompleteCallback = MoveTemp(OnCompleteCallback)](TArray<FString>&& CacheKeys)
         {
-            FMCPAssetImportResult Result;
-            Result.bSuccess = bSuccess;
+            const FString& CacheKey = CacheKeys[0];
+            FMCPAssetImportResult CachedResult;
+            if (!CacheKey.IsEmpty() && FindCachedImport(CacheKey, CachedResult))
+            {
+                UE_LOG(LogTemp, Log, TEXT("Blenderモデル '%s' は変更されていないため、インポートを省略しました: %s"), *ModelPath, *CachedResult.AssetPath);
+                OnCompleteCallback(CachedResult);
+                return;
+            }
             
-            if (bSuccess)
+            TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+            MCPClient->ImportAsset(ModelPath, DestinationPath, 
+                [WeakThis, OnCompleteCallback, ModelPath, DestinationPath, CacheKey](bool bSuccess, const FString& AssetName)
+                {
+                    FMCPAssetImportResult Result = MakeImportResult(bSuccess, ModelPath, DestinationPath, AssetName);
+                    if (WeakThis.IsValid())
+                    {
+                        WeakThis->IndexImportResult(ModelPath, DestinationPath, Result);
+                        if (!CacheKey.IsEmpty())
+                        {
+                            WeakThis->RecordImport(CacheKey, ModelPath, Result);
+                        }
+                    }
+                    
+                    OnCompleteCallback(Result);
+                });
+        });
+}
+
+void UMCPAssetManager::ImportBlenderModels(const TArray<FString>& ModelPaths, const FString& DestinationPath, bool bSaveLevel,
+                                      TFunction<void(const TArray<FMCPAssetImportResult>& Results)> OnCompleteCallback)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPImportBlenderModel);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::ImportBlenderModels);
+    
+    if (!bConfigured)
+    {
+        RunWhenConfigured([this, ModelPaths, DestinationPath, bSaveLevel, OnCompleteCallback = MoveTemp(OnCompleteCallback)]() mutable
+        {
+            ImportBlenderModels(ModelPaths, DestinationPath, bSaveLevel, MoveTemp(OnCompleteCallback));
+        });
+        return;
+    }
+    
+    // ソースファイルのハッシュはワーカースレッドで計算し、ゲームスレッドに戻ってからキャッシュを確認する
+    ResolveImportCacheKeys(ModelPaths, DestinationPath,
+        [this, ModelPaths, DestinationPath, bSaveLevel, OnCompleteCallback = MoveTemp(OnCompleteCallback)](TArray<FString>&& CacheKeys)
+        {
+            TArray<FMCPAssetImportResult> Results;
+            Results.SetNum(ModelPaths.Num());
+            
+            // 変更されていないモデルはキャッシュから結果を返し、残りだけを1つのバッチにまとめる
+            TArray<FMCPBatchCommand> Commands;
+            TArray<int32> CommandModelIndices;
+            TArray<FString> CommandCacheKeys;
+            Commands.Reserve(ModelPaths.Num() + 1);
+            for (int32 Index = 0; Index < ModelPaths.Num(); ++Index)
             {
-                Result.AssetName = AssetName;
-                Result.AssetPath = DestinationPath / AssetName;
+                const FString& ModelPath = ModelPaths[Index];
                 
-                // インポートされたアセットを取得するための処理（必要に応じて）
-                FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-                TArray<FAssetData> AssetData;
-                FARFilter Filter;
-                Filter.PackagePaths.Add(*DestinationPath);
-                Filter.bRecursivePaths = true;
-                AssetRegistryModule.Get().GetAssets(Filter, AssetData);
+                const FString& CacheKey = CacheKeys[Index];
+                if (!CacheKey.IsEmpty() && FindCachedImport(CacheKey, Results[Index]))
+                {
+                    UE_LOG(LogTemp, Log, TEXT("Blenderモデル '%s' は変更されていないため、インポートを省略しました: %s"), *ModelPath, *Results[Index].AssetPath);
+                    continue;
+                }
                 
-                // ログ出力
-                UE_LOG(LogTemp, Log, TEXT("Blenderモデル '%s' をインポートしました: %s"), *ModelPath, *Result.AssetPath);
+                TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+                Params->SetStringField(TEXT("path"), ModelPath);
+                Params->SetStringField(TEXT("destination"), DestinationPath);
+                Commands.Emplace(TEXT("import_asset"), Params);
+                CommandModelIndices.Add(Index);
+                CommandCacheKeys.Add(CacheKey);
             }
-            else
+            
+            if (Commands.Num() == 0)
+            {
+                // 全てキャッシュから返せた場合は通信しない（レベルも変更されていない）
+                OnCompleteCallback(Results);
+                return;
+            }
+            
+            if (bSaveLevel)
             {
-                Result.ErrorMessage = FString::Printf(TEXT("アセットのインポートに失敗しました: %s"), *ModelPath);
-                UE_LOG(LogTemp, Error, TEXT("%s"), *Result.ErrorMessage);
+                Commands.Emplace(TEXT("save_level"), MakeShared<FJsonObject>());
             }
             
-            OnCompleteCallback(Result);
+            TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+            MCPClient->ExecuteBatch(Commands, false,
+                [WeakThis, OnCompleteCallback, ModelPaths, DestinationPath, bSaveLevel, Results = MoveTemp(Results),
+                 CommandModelIndices = MoveTemp(CommandModelIndices), CommandCacheKeys = MoveTemp(CommandCacheKeys)]
+                (bool bSuccess, const TArray<FMCPBatchCommandResult>& CommandResults, const FMCPRequestTiming& Timing) mutable
+                {
+                    for (int32 CommandIndex = 0; CommandIndex < CommandModelIndices.Num(); ++CommandIndex)
+                    {
+                        const int32 ModelIndex = CommandModelIndices[CommandIndex];
+                        const FMCPBatchCommandResult& CommandResult = CommandResults[CommandIndex];
+                        Results[ModelIndex] = MakeImportResult(CommandResult.bSuccess, ModelPaths[ModelIndex], DestinationPath,
+                            FMCPClient::GetImportedAssetName(CommandResult.Response));
+                        
+                        if (WeakThis.IsValid())
+                        {
+                            WeakThis->IndexImportResult(ModelPaths[ModelIndex], DestinationPath, Results[ModelIndex]);
+                            if (!CommandCacheKeys[CommandIndex].IsEmpty())
+                            {
+                                WeakThis->RecordImport(CommandCacheKeys[CommandIndex], ModelPaths[ModelIndex], Results[ModelIndex]);
+                            }
+                        }
+                    }
+                    
+                    if (bSaveLevel && !CommandResults.Last().bSuccess)
+                    {
+                        UE_LOG(LogTemp, Error, TEXT("インポート後のレベル保存に失敗しました"));
+                    }
+                    
+                    UE_LOG(LogTemp, Log, TEXT("%d 件のBlenderモデルを1回のリクエストで処理しました (%.1fms)"), CommandModelIndices.Num(), Timing.TotalSeconds * 1000.0);
+                    
+                    OnCompleteCallback(Results);
+                });
+        });
+}
+
+void UMCPAssetManager::ExecuteBlenderCommand(const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                                        TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response)> OnCompleteCallback)
+{
+    RunWhenConfigured([this, Command, Params, OnCompleteCallback = MoveTemp(OnCompleteCallback)]() mutable
+    {
+        MCPClient->ExecuteBlenderCommand(Command, Params, MoveTemp(OnCompleteCallback));
+    });
+}
+
+void UMCPAssetManager::ImportBlenderMeshBuffer(const FString& MeshName, TFunction<void(UStaticMesh* Mesh)> OnCompleteCallback)
+{
+    if (!bConfigured)
+    {
+        RunWhenConfigured([this, MeshName, OnCompleteCallback = MoveTemp(OnCompleteCallback)]() mutable
+        {
+            ImportBlenderMeshBuffer(MeshName, MoveTemp(OnCompleteCallback));
         });
+        return;
+    }
+    
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    MCPClient->FetchMeshBuffer(MeshName,
+        [WeakThis, MeshName, OnCompleteCallback](bool bSuccess, TConstArrayView<uint8> Content, const FMCPRequestTiming& Timing)
+        {
+            if (!bSuccess || !WeakThis.IsValid())
+            {
+                UE_LOG(LogTemp, Error, TEXT("メッシュバッファの取得に失敗しました: %s"), *MeshName);
+                OnCompleteCallback(nullptr);
+                return;
+            }
+            
+            // 受信バッファを直接参照したままメッシュを組み立てる
+            FMCPMeshBufferView View;
+            FString Error;
+            if (!FMCPMeshBufferView::Parse(Content, View, Error))
+            {
+                UE_LOG(LogTemp, Error, TEXT("メッシュバッファ '%s' を読み取れませんでした: %s"), *MeshName, *Error);
+                OnCompleteCallback(nullptr);
+                return;
+            }
+            
+            const FName ObjectName = MakeUniqueObjectName(WeakThis.Get(), UStaticMesh::StaticClass(), FName(*FString::Printf(TEXT("SM_%s"), *MeshName)));
+            UStaticMesh* Mesh = FMCPMeshBufferView::BuildStaticMesh(View, WeakThis.Get(), ObjectName);
+            if (Mesh)
+            {
+                WeakThis->GeneratedMeshes.Add(MeshName, Mesh);
+                UE_LOG(LogTemp, Log, TEXT("メッシュバッファ '%s' を受信しました: %d バイト / %.1fms"), *MeshName, Content.Num(), Timing.TotalSeconds * 1000.0);
+            }
+            
+            OnCompleteCallback(Mesh);
+        });
+}
+
+void UMCPAssetManager::ClearImportCache()
+{
+    ImportCache.Empty();
+    SaveImportManifest();
+    
+    UE_LOG(LogTemp, Log, TEXT("インポートキャッシュを消去しました"));
+}
+
+FString UMCPAssetManager::MakeImportCacheKey(const FString& SourceKey, const FMD5Hash& SourceHash, const FString& DestinationPath)
+{
+    // 同じ内容の別ファイル（複製したFBXなど）はアセット名が異なるため、ソースのパスもキーに含める
+    return FString::Printf(TEXT("%s|%s|%s|v%d"), *SourceKey, *LexToString(SourceHash), *DestinationPath, ImportSettingsVersion);
+}
+
+void UMCPAssetManager::ResolveImportCacheKeys(const TArray<FString>& ModelPaths, const FString& DestinationPath,
+                                              TFunction<void(TArray<FString>&& CacheKeys)> OnResolved)
+{
+    // ワーカースレッドには前回のハッシュの写しを渡し、キャッシュ自体はゲームスレッドでのみ更新する
+    TArray<FString> SourceKeys;
+    TArray<FSourceHashEntry> Entries;
+    SourceKeys.Reserve(ModelPaths.Num());
+    Entries.Reserve(ModelPaths.Num());
+    for (const FString& ModelPath : ModelPaths)
+    {
+        const FString& SourceKey = SourceKeys.Add_GetRef(MakeSourceKey(ModelPath));
+        const FSourceHashEntry* Cached = SourceHashes.Find(SourceKey);
+        Entries.Add(Cached ? *Cached : FSourceHashEntry());
+    }
+    
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [WeakThis, DestinationPath, SourceKeys = MoveTemp(SourceKeys), Entries = MoveTemp(Entries), OnResolved = MoveTemp(OnResolved)]() mutable
+        {
+            TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::HashImportSources);
+            
+            // サイズと更新日時が前回と同じファイルは読み込まずに前回のハッシュを使う
+            for (int32 Index = 0; Index < SourceKeys.Num(); ++Index)
+            {
+                FSourceHashEntry& Entry = Entries[Index];
+                const FFileStatData StatData = IFileManager::Get().GetStatData(*SourceKeys[Index]);
+                if (!StatData.bIsValid || StatData.bIsDirectory)
+                {
+                    Entry = FSourceHashEntry();
+                }
+                else if (!Entry.Hash.IsValid() || Entry.Size != StatData.FileSize || Entry.ModificationTime != StatData.ModificationTime)
+                {
+                    Entry.Size = StatData.FileSize;
+                    Entry.ModificationTime = StatData.ModificationTime;
+                    Entry.Hash = FMD5Hash::HashFile(*SourceKeys[Index]);
+                }
+            }
+            
+            TArray<FString> CacheKeys;
+            CacheKeys.SetNum(SourceKeys.Num());
+            for (int32 Index = 0; Index < SourceKeys.Num(); ++Index)
+            {
+                // ソースファイルを読めない場合はキャッシュを使わない（キーは空）
+                if (Entries[Index].Hash.IsValid())
+                {
+                    CacheKeys[Index] = MakeImportCacheKey(SourceKeys[Index], Entries[Index].Hash, DestinationPath);
+                }
+            }
+            
+            AsyncTask(ENamedThreads::GameThread,
+                [WeakThis, SourceKeys = MoveTemp(SourceKeys), Entries = MoveTemp(Entries), CacheKeys = MoveTemp(CacheKeys), OnResolved = MoveTemp(OnResolved)]() mutable
+                {
+                    if (!WeakThis.IsValid())
+                    {
+                        return;
+                    }
+                    
+                    for (int32 Index = 0; Index < SourceKeys.Num(); ++Index)
+                    {
+                        if (Entries[Index].Hash.IsValid())
+                        {
+                            WeakThis->SourceHashes.Add(SourceKeys[Index], Entries[Index]);
+                        }
+                        else
+                        {
+                            WeakThis->SourceHashes.Remove(SourceKeys[Index]);
+                        }
+                    }
+                    
+                    OnResolved(MoveTemp(CacheKeys));
+                });
+        });
+}
+
+bool UMCPAssetManager::FindCachedImport(const FString& CacheKey, FMCPAssetImportResult& OutResult) const
+{
+    const FImportCacheEntry* Entry = ImportCache.Find(CacheKey);
+    if (!Entry)
+    {
+        return false;
+    }
+    
+    // インポート先のアセットが削除されている場合は再インポートする
+    if (!FPackageName::DoesPackageExist(Entry->AssetPath))
+    {
+        return false;
+    }
+    
+    OutResult.bSuccess = true;
+    OutResult.AssetPath = Entry->AssetPath;
+    OutResult.AssetName = Entry->AssetName;
+    OutResult.ErrorMessage.Empty();
+    return true;
+}
+
+void UMCPAssetManager::RecordImport(const FString& CacheKey, const FString& ModelPath, const FMCPAssetImportResult& Result)
+{
+    if (!Result.bSuccess)
+    {
+        return;
+    }
+    
+    FImportCacheEntry& Entry = ImportCache.FindOrAdd(CacheKey);
+    Entry.SourcePath = ModelPath;
+    Entry.AssetPath = Result.AssetPath;
+    Entry.AssetName = Result.AssetName;
+    
+    ScheduleImportManifestSave();
+}
+
+FString UMCPAssetManager::GetImportManifestPath()
+{
+    // mcp_settings.jsonと同じディレクトリに保存する
+    return FPaths::ProjectConfigDir() / ImportManifestFileName;
+}
+
+bool UMCPAssetManager::ParseImportManifest(const FString& JsonContent, TMap<FString, FImportCacheEntry>& OutEntries)
+{
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonContent);
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        return false;
+    }
+    
+    const TSharedPtr<FJsonObject>* EntriesObj;
+    if (JsonObject->TryGetObjectField(TEXT("entries"), EntriesObj))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*EntriesObj)->Values)
+        {
+            const TSharedPtr<FJsonObject>* EntryObj;
+            if (Pair.Value->TryGetObject(EntryObj))
+            {
+                FImportCacheEntry& Entry = OutEntries.Add(Pair.Key);
+                (*EntryObj)->TryGetStringField(TEXT("source"), Entry.SourcePath);
+                (*EntryObj)->TryGetStringField(TEXT("asset_path"), Entry.AssetPath);
+                (*EntryObj)->TryGetStringField(TEXT("asset_name"), Entry.AssetName);
+            }
+        }
+    }
+    
+    return true;
+}
+
+void UMCPAssetManager::SaveImportManifest()
+{
+    if (ManifestSaveHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ManifestSaveHandle);
+        ManifestSaveHandle.Reset();
+    }
+    
+    TSharedRef<FJsonObject> EntriesObj = MakeShared<FJsonObject>();
+    for (const TPair<FString, FImportCacheEntry>& Pair : ImportCache)
+    {
+        TSharedRef<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+        EntryObj->SetStringField(TEXT("source"), Pair.Value.SourcePath);
+        EntryObj->SetStringField(TEXT("asset_path"), Pair.Value.AssetPath);
+        EntryObj->SetStringField(TEXT("asset_name"), Pair.Value.AssetName);
+        EntriesObj->SetObjectField(Pair.Key, EntryObj);
+    }
+    
+    TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    JsonObject->SetNumberField(TEXT("version"), ImportSettingsVersion);
+    JsonObject->SetObjectField(TEXT("entries"), EntriesObj);
+    
+    FString JsonContent;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonContent);
+    FJsonSerializer::Serialize(JsonObject, Writer);
+    
+    if (!FFileHelper::SaveStringToFile(JsonContent, *GetImportManifestPath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("インポートマニフェストの保存に失敗しました: %s"), *GetImportManifestPath());
+    }
+}
+
+void UMCPAssetManager::ScheduleImportManifestSave()
+{
+    if (ManifestSaveHandle.IsValid())
+    {
+        return;
+    }
+    
+    // 大量のインポートが続けて完了しても、書き込みは少し待ってから1回にまとめる
+    TWeakObjectPtr<UMCPAssetManager> WeakThis(this);
+    ManifestSaveHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakThis](float DeltaTime)
+        {
+            if (WeakThis.IsValid())
+            {
+                WeakThis->ManifestSaveHandle.Reset();
+                WeakThis->SaveImportManifest();
+            }
+            return false;
+        }), 1.0f);
+}
+
+FMCPAssetImportResult UMCPAssetManager::MakeImportResult(bool bSuccess, const FString& ModelPath, const FString& DestinationPath, const FString& AssetName)
+{
+    FMCPAssetImportResult Result;
+    Result.bSuccess = bSuccess;
+    
+    if (bSuccess)
+    {
+        Result.AssetName = AssetName;
+        Result.AssetPath = DestinationPath / AssetName;
+        
+        // ログ出力
+        UE_LOG(LogTemp, Log, TEXT("Blenderモデル '%s' をインポートしました: %s"), *ModelPath, *Result.AssetPath);
+    }
+    else
+    {
+        Result.ErrorMessage = FString::Printf(TEXT("アセットのインポートに失敗しました: %s"), *ModelPath);
+        UE_LOG(LogTemp, Error, TEXT("%s"), *Result.ErrorMessage);
+    }
+    
+    return Result;
+}
+
+void UMCPAssetManager::IndexImportResult(const FString& ModelPath, const FString& DestinationPath, FMCPAssetImportResult& InOutResult)
+{
+    if (!InOutResult.bSuccess)
+    {
+        return;
+    }
+    
+    AddIndexedRoot(DestinationPath);
+    
+    // アセットレジストリが既にインポート先のフォルダで見つけていれば、そのパスを使う
+    const FName AssetName(*InOutResult.AssetName);
+    if (const FName* PackageName = ImportedAssetsByName.Find(AssetName))
+    {
+        const FString PackageString = PackageName->ToString();
+        if (PackageString.StartsWith(MakeRootPath(DestinationPath)))
+        {
+            InOutResult.AssetPath = PackageString;
+        }
+    }
+    
+    AddImportedAsset(FName(*InOutResult.AssetPath), AssetName, MakeSourceKey(ModelPath));
+}
+
+void UMCPAssetManager::AddIndexedRoot(const FString& PackagePath)
+{
+    if (PackagePath.IsEmpty())
+    {
+        return;
+    }
+    
+    const FString RootPath = MakeRootPath(PackagePath);
+    if (IndexedRoots.Contains(RootPath))
+    {
+        return;
+    }
+    IndexedRoots.Add(RootPath);
+    
+    // 初めてのフォルダだけ既存のアセットを走査する（以降はイベントで更新する）
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    TArray<FAssetData> AssetDataList;
+    AssetRegistry.GetAssetsByPath(FName(*RootPath.LeftChop(1)), AssetDataList, true);
+    for (const FAssetData& AssetData : AssetDataList)
+    {
+        AddImportedAsset(AssetData.PackageName, AssetData.AssetName, GetSourceKey(AssetData));
+    }
+    
+    UE_LOG(LogTemp, Verbose, TEXT("インポート先のフォルダ '%s' をインデックスに追加しました: %d 件"), *PackagePath, AssetDataList.Num());
+}
+
+bool UMCPAssetManager::IsUnderIndexedRoot(const FString& PackageName) const
+{
+    // インポート先のフォルダは通常数個のため、前方一致で順に比較する
+    for (const FString& RootPath : IndexedRoots)
+    {
+        if (PackageName.StartsWith(RootPath))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UMCPAssetManager::AddImportedAsset(FName PackageName, FName AssetName, const FString& SourceKey)
+{
+    FImportedAsset& Entry = ImportedAssets.FindOrAdd(PackageName);
+    
+    // ソースファイルが分からない通知（アセットレジストリのイベントなど）では、既知のソースファイルを残す
+    if (!SourceKey.IsEmpty() && SourceKey != Entry.SourceKey)
+    {
+        const FName* OldSourcePackage = ImportedAssetsBySource.Find(Entry.SourceKey);
+        if (OldSourcePackage && *OldSourcePackage == PackageName)
+        {
+            ImportedAssetsBySource.Remove(Entry.SourceKey);
+        }
+        Entry.SourceKey = SourceKey;
+    }
+    Entry.AssetName = AssetName;
+    
+    if (!Entry.SourceKey.IsEmpty())
+    {
+        ImportedAssetsBySource.Add(Entry.SourceKey, PackageName);
+    }
+    ImportedAssetsByName.Add(AssetName, PackageName);
+}
+
+void UMCPAssetManager::RemoveImportedAsset(FName PackageName)
+{
+    FImportedAsset Entry;
+    if (!ImportedAssets.RemoveAndCopyValue(PackageName, Entry))
+    {
+        return;
+    }
+    
+    // 索引が別のパッケージを指している場合（同じ名前のアセットが後から追加された場合）は残す
+    const FName* SourcePackage = ImportedAssetsBySource.Find(Entry.SourceKey);
+    if (SourcePackage && *SourcePackage == PackageName)
+    {
+        ImportedAssetsBySource.Remove(Entry.SourceKey);
+    }
+    
+    const FName* NamedPackage = ImportedAssetsByName.Find(Entry.AssetName);
+    if (NamedPackage && *NamedPackage == PackageName)
+    {
+        ImportedAssetsByName.Remove(Entry.AssetName);
+    }
+}
+
+FString UMCPAssetManager::MakeSourceKey(const FString& ModelPath)
+{
+    // 相対パスはプロジェクトディレクトリからのパスとして扱う
+    FString SourcePath = ModelPath;
+    if (FPaths::IsRelative(SourcePath))
+    {
+        SourcePath = FPaths::Combine(FPaths::ProjectDir(), SourcePath);
+    }
+    
+    SourcePath = FPaths::ConvertRelativePathToFull(SourcePath);
+    FPaths::NormalizeFilename(SourcePath);
+    return SourcePath;
+}
+
+FString UMCPAssetManager::GetSourceKey(const FAssetData& AssetData)
+{
+#if WITH_EDITORONLY_DATA
+    // インポートされたアセットはソースファイルの情報をタグに持っている
+    FString ImportDataJson;
+    if (!AssetData.GetTagValue(UObject::SourceFileTagName(), ImportDataJson))
+    {
+        return FString();
+    }
+    
+    TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+    if (!ImportInfo.IsSet() || ImportInfo->SourceFiles.Num() == 0)
+    {
+        return FString();
+    }
+    
+    // 相対パスはパッケージのファイルからの相対パスとして保存されている
+    FString SourcePath = ImportInfo->SourceFiles[0].RelativeFilename;
+    if (FPaths::IsRelative(SourcePath))
+    {
+        const FString PackageFilename = FPackageName::LongPackageNameToFilename(AssetData.PackageName.ToString());
+        SourcePath = FPaths::Combine(FPaths::GetPath(PackageFilename), SourcePath);
+    }
+    return MakeSourceKey(SourcePath);
+#else
+    return FString();
+#endif
+}
+
+void UMCPAssetManager::HandleRegistryAssetAdded(const FAssetData& AssetData)
+{
+    if (IsUnderIndexedRoot(AssetData.PackageName.ToString()))
+    {
+        AddImportedAsset(AssetData.PackageName, AssetData.AssetName, GetSourceKey(AssetData));
+    }
+}
+
+void UMCPAssetManager::HandleRegistryAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // 名前の変更・移動の前のソースファイルを引き継ぐ
+    const FName OldPackageName(*FPackageName::ObjectPathToPackageName(OldObjectPath));
+    FString SourceKey;
+    if (const FImportedAsset* OldEntry = ImportedAssets.Find(OldPackageName))
+    {
+        SourceKey = OldEntry->SourceKey;
+        RemoveImportedAsset(OldPackageName);
+    }
+    
+    if (IsUnderIndexedRoot(AssetData.PackageName.ToString()))
+    {
+        const FString TaggedSourceKey = GetSourceKey(AssetData);
+        AddImportedAsset(AssetData.PackageName, AssetData.AssetName, TaggedSourceKey.IsEmpty() ? SourceKey : TaggedSourceKey);
+    }
+}
+
+void UMCPAssetManager::HandleRegistryAssetRemoved(const FAssetData& AssetData)
+{
+    RemoveImportedAsset(AssetData.PackageName);
+}
+
+bool UMCPAssetManager::FindImportedAssetBySource(const FString& ModelPath, FMCPAssetImportResult& OutResult) const
+{
+    const FName* PackageName = ImportedAssetsBySource.Find(MakeSourceKey(ModelPath));
+    if (!PackageName)
+    {
+        return false;
+    }
+    
+    OutResult.bSuccess = true;
+    OutResult.AssetPath = PackageName->ToString();
+    OutResult.AssetName = ImportedAssets.FindChecked(*PackageName).AssetName.ToString();
+    OutResult.ErrorMessage.Empty();
+    return true;
+}
+
+bool UMCPAssetManager::FindImportedAssetByName(FName AssetName, FMCPAssetImportResult& OutResult) const
+{
+    const FName* PackageName = ImportedAssetsByName.Find(AssetName);
+    if (!PackageName)
+    {
+        return false;
+    }
+    
+    OutResult.bSuccess = true;
+    OutResult.AssetPath = PackageName->ToString();
+    OutResult.AssetName = AssetName.ToString();
+    OutResult.ErrorMessage.Empty();
+    return true;
+}
+
+void UMCPAssetManager::RequestAsset(const FString& AssetPath, TFunction<void(UObject* Asset)> OnResident)
+{
+    const FSoftObjectPath ObjectPath = MakeAssetObjectPath(AssetPath);
+    if (ObjectPath.IsNull())
+    {
+        UE_LOG(LogTemp, Error, TEXT("アセットパスが無効です: %s"), *AssetPath);
+        OnResident(nullptr);
+        return;
+    }
+    
+    // ロード済みならすぐに返す
+    if (UObject* const* ResidentAsset = ResidentAssets.Find(ObjectPath))
+    {
+        if (IsValid(*ResidentAsset))
+        {
+            OnResident(*ResidentAsset);
+            return;
+        }
+        ResidentAssets.Remove(ObjectPath);
+    }
+    
+    // ロード中なら完了を待つ
+    if (FPendingAssetLoad* PendingLoad = PendingAssetLoads.Find(ObjectPath))
+    {
+        PendingLoad->Callbacks.Add(MoveTemp(OnResident));
+        return;
+    }
+    
+    // 他の経路でメモリ上に存在する場合はロードせずにキャッシュに登録する
+    if (UObject* LoadedAsset = ObjectPath.ResolveObject())
+    {
+        ResidentAssets.Add(ObjectPath, LoadedAsset);
+        OnResident(LoadedAsset);
+        return;
+    }
+    
+    // コールバックが同期的に呼ばれる場合に備え、ロード要求の前に待機状態を登録する
+    PendingAssetLoads.Add(ObjectPath).Callbacks.Add(MoveTemp(OnResident));
+    
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(ObjectPath,
+        FStreamableDelegate::CreateUObject(this, &UMCPAssetManager::HandleAssetLoaded, ObjectPath));
+    
+    if (FPendingAssetLoad* PendingLoad = PendingAssetLoads.Find(ObjectPath))
+    {
+        PendingLoad->Handle = Handle;
+    }
+}
+
+UObject* UMCPAssetManager::FindResidentAsset(const FString& AssetPath) const
+{
+    UObject* const* ResidentAsset = ResidentAssets.Find(MakeAssetObjectPath(AssetPath));
+    return (ResidentAsset && IsValid(*ResidentAsset)) ? *ResidentAsset : nullptr;
+}
+
+FSoftObjectPath UMCPAssetManager::MakeAssetObjectPath(const FString& AssetPath)
+{
+    // "/Game/Path/Asset" の形式の場合は "/Game/Path/Asset.Asset" に補う
+    if (!AssetPath.IsEmpty() && !AssetPath.Contains(TEXT(".")))
+    {
+        return FSoftObjectPath(AssetPath + TEXT(".") + FPackageName::GetShortName(AssetPath));
+    }
+    
+    return FSoftObjectPath(AssetPath);
+}
+
+void UMCPAssetManager::HandleAssetLoaded(FSoftObjectPath ObjectPath)
+{
+    FPendingAssetLoad PendingLoad;
+    if (!PendingAssetLoads.RemoveAndCopyValue(ObjectPath, PendingLoad))
+    {
+        return;
+    }
+    
+    UObject* Asset = ObjectPath.ResolveObject();
+    if (Asset)
+    {
+        ResidentAssets.Add(ObjectPath, Asset);
+        UE_LOG(LogTemp, Verbose, TEXT("アセット '%s' を非同期でロードしました"), *ObjectPath.ToString());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("アセット '%s' のロードに失敗しました。インポートが必要かもしれません。"), *ObjectPath.ToString());
+    }
+    
+    for (TFunction<void(UObject* Asset)>& Callback : PendingLoad.Callbacks)
+    {
+        Callback(Asset);
+    }
 }
 
 bool UMCPAssetManager::PlaceAssetInLevel(const FString& AssetPath, const FVector& Location, 
                                       const FRotator& Rotation, const FVector& Scale,
                                       const FString& ActorName)
 {
+    SCOPE_CYCLE_COUNTER(STAT_MCPPlaceAsset);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::PlaceAssetInLevel);
+    
 #if WITH_EDITOR
     if (!IsInGameThread())
     {
@@ -185,6 +1154,125 @@ bool UMCPAssetManager::PlaceAssetInLevel(const FString& AssetPath, const FVector
     return false;
 }
 
+int32 UMCPAssetManager::PlaceAssetsInLevelBatch(const TArray<FMCPAssetPlacementBatch>& Batches)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPPlaceAsset);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMCPAssetManager::PlaceAssetsInLevelBatch);
+    
+#if WITH_EDITOR
+    if (!IsInGameThread())
+    {
+        // ゲームスレッドでの実行が必要な場合は、ゲームスレッドに処理を移譲
+        AsyncTask(ENamedThreads::GameThread, [this, Batches]() {
+            PlaceAssetsInLevelBatch(Batches);
+        });
+        return 0;
+    }
+    
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("アセットの一括配置に失敗しました: エディタのワールドが無効です"));
+        return 0;
+    }
+    
+    // 同じアセットの配置先をまとめ、アセットごとに1回だけロードする
+    TMap<FString, TArray<FTransform>> TransformsByAsset;
+    TMap<FString, FString> ActorNameByAsset;
+    for (const FMCPAssetPlacementBatch& Batch : Batches)
+    {
+        TransformsByAsset.FindOrAdd(Batch.AssetPath).Append(Batch.Transforms);
+        if (!Batch.ActorName.IsEmpty())
+        {
+            ActorNameByAsset.FindOrAdd(Batch.AssetPath, Batch.ActorName);
+        }
+    }
+    
+    int32 PlacedCount = 0;
+    for (const TPair<FString, TArray<FTransform>>& Pair : TransformsByAsset)
+    {
+        const FString& AssetPath = Pair.Key;
+        const TArray<FTransform>& Transforms = Pair.Value;
+        if (Transforms.Num() == 0)
+        {
+            continue;
+        }
+        
+        // ロード済みであればキャッシュを使い、そうでなければ1回だけロードする
+        UObject* Asset = FindResidentAsset(AssetPath);
+        if (!Asset)
+        {
+            Asset = LoadObject<UObject>(nullptr, *AssetPath);
+            if (Asset)
+            {
+                ResidentAssets.Add(MakeAssetObjectPath(AssetPath), Asset);
+            }
+        }
+        
+        if (!Asset)
+        {
+            UE_LOG(LogTemp, Error, TEXT("アセットを読み込めませんでした: %s"), *AssetPath);
+            continue;
+        }
+        
+        const FString* ActorName = ActorNameByAsset.Find(AssetPath);
+        
+        // スタティックメッシュの場合は1つのアクターにインスタンスとしてまとめる
+        UStaticMesh* StaticMesh = Cast<UStaticMesh>(Asset);
+        if (StaticMesh)
+        {
+            AActor* InstanceActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+            if (!InstanceActor)
+            {
+                continue;
+            }
+            
+            UHierarchicalInstancedStaticMeshComponent* InstanceComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceActor, TEXT("Instances"), RF_Transactional);
+            InstanceComponent->SetMobility(EComponentMobility::Static);
+            InstanceComponent->SetStaticMesh(StaticMesh);
+            InstanceActor->SetRootComponent(InstanceComponent);
+            InstanceActor->AddInstanceComponent(InstanceComponent);
+            InstanceComponent->RegisterComponent();
+            InstanceComponent->AddInstances(Transforms, false, true);
+            
+            InstanceActor->SetActorLabel(ActorName ? *ActorName : FString::Printf(TEXT("%s_Instances"), *StaticMesh->GetName()));
+            
+            PlacedCount += Transforms.Num();
+            UE_LOG(LogTemp, Log, TEXT("アセット '%s' を %d 個のインスタンスとしてレベルに配置しました"), *AssetPath, Transforms.Num());
+            continue;
+        }
+        
+        // ブループリントの場合はインスタンス化できないため、配置先ごとにアクターを生成する
+        UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
+        if (Blueprint && Blueprint->GeneratedClass)
+        {
+            for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+            {
+                AActor* Actor = World->SpawnActor(Blueprint->GeneratedClass, &Transforms[Index]);
+                if (Actor)
+                {
+                    if (ActorName)
+                    {
+                        Actor->SetActorLabel(FString::Printf(TEXT("%s_%d"), **ActorName, Index));
+                    }
+                    PlacedCount++;
+                }
+            }
+            
+            UE_LOG(LogTemp, Log, TEXT("ブループリント '%s' を %d 個レベルに配置しました"), *AssetPath, Transforms.Num());
+            continue;
+        }
+        
+        UE_LOG(LogTemp, Error, TEXT("アセットの配置に失敗しました: %s"), *AssetPath);
+    }
+    
+    return PlacedCount;
+#else
+    UE_LOG(LogTemp, Error, TEXT("アセットの一括配置はエディタでのみ使用できます"));
+    return 0;
+#endif
+}
+
 bool UMCPAssetManager::SetGameMode(TSubclassOf<AGameModeBase> GameModeClass)
 {
     if (!GameModeClass)
@@ -195,15 +1283,18 @@ bool UMCPAssetManager::SetGameMode(TSubclassOf<AGameModeBase> GameModeClass)
     
     FString GameModePath = GameModeClass->GetPathName();
     
-    MCPClient->SetGameMode(GameModePath, [](bool bSuccess) {
-        if (bSuccess)
-        {
-            UE_LOG(LogTemp, Log, TEXT("ゲームモードを設定しました"));
-        }
-        else
-        {
-            UE_LOG(LogTemp, Error, TEXT("ゲームモードの設定に失敗しました"));
-        }
+    RunWhenConfigured([this, GameModePath]()
+    {
+        MCPClient->SetGameMode(GameModePath, [](bool bSuccess) {
+            if (bSuccess)
+            {
+                UE_LOG(LogTemp, Log, TEXT("ゲームモードを設定しました"));
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("ゲームモードの設定に失敗しました"));
+            }
+        });
     });
     
     return true;
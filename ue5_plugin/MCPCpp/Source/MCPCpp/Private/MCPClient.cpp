@@ -1,32 +1,250 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPClient.h"
-#include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "PlatformHttp.h"
+#include "MCPStats.h"
 
 FMCPClient::FMCPClient()
-    : ServerURL(TEXT("http://127.0.0.1:8080"))
+    : Transport(MakeShared<FMCPHttpTransport, ESPMode::ThreadSafe>())
+    , StreamClient(MakeShared<FMCPStreamClient>())
+    , bUseStream(false)
 {
     // HTTPモジュールの初期化を確認
     check(FHttpModule::Get().IsHttpEnabled());
+    
+    SetServerURL(TEXT("http://127.0.0.1:8080"));
 }
 
 FMCPClient::~FMCPClient()
 {
-    // 必要に応じてリソースをクリーンアップ
+    StopRecording();
 }
 
 void FMCPClient::SetServerURL(const FString& InServerURL)
 {
     ServerURL = InServerURL;
+    ServerURL.RemoveFromEnd(TEXT("/"));
+    
+    // エンドポイントのURLはリクエストごとに連結せず、ここで一度だけ作成する
+    StatusURL = ServerURL + TEXT("/status");
+    UnrealCommandURL = ServerURL + TEXT("/api/unreal/command");
+    UnrealBatchURL = ServerURL + TEXT("/api/unreal/batch");
+    BlenderCommandURL = ServerURL + TEXT("/api/blender/command");
+    MeshBufferURL = ServerURL + TEXT("/api/blender/mesh/");
+    
+    StreamURL = ServerURL + TEXT("/ws");
+    if (!StreamURL.ReplaceInline(TEXT("https://"), TEXT("wss://"), ESearchCase::IgnoreCase))
+    {
+        StreamURL.ReplaceInline(TEXT("http://"), TEXT("ws://"), ESearchCase::IgnoreCase);
+    }
+    
     UE_LOG(LogTemp, Log, TEXT("MCPサーバーURLを設定しました: %s"), *ServerURL);
+    
+    // 接続中の場合は新しいURLに接続し直す
+    if (bUseStream)
+    {
+        StreamClient->Connect(StreamURL);
+    }
+}
+
+void FMCPClient::ConnectStream()
+{
+    bUseStream = true;
+    StreamClient->Connect(StreamURL);
+}
+
+void FMCPClient::DisconnectStream()
+{
+    bUseStream = false;
+    StreamClient->Disconnect();
+}
+
+bool FMCPClient::StartRecording(const FString& FilePath)
+{
+    StopRecording();
+    
+    Recorder = FMCPCommandRecorder::Create(FilePath, ServerURL);
+    Transport->SetRecorder(Recorder);
+    return Recorder.IsValid();
+}
+
+void FMCPClient::StopRecording()
+{
+    if (Recorder.IsValid())
+    {
+        Transport->SetRecorder(nullptr);
+        Recorder->Close();
+        Recorder.Reset();
+    }
+}
+
+void FMCPClient::SetConcurrencyLimits(int32 MaxConcurrentRequests, int32 MaxQueuedRequests)
+{
+    Transport->SetMaxConcurrentRequests(MaxConcurrentRequests);
+    Transport->SetMaxQueuedRequests(MaxQueuedRequests);
+}
+
+bool FMCPClient::CanAcceptRequest() const
+{
+    return Transport->CanAcceptRequest();
+}
+
+bool FMCPClient::ExecuteUnrealCommand(const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                                      FMCPHttpTransport::FOnRequestComplete OnCompleteCallback,
+                                      FMCPHttpTransport::FOnDecodeResponse OnDecode)
+{
+    // 記録中はトランスポートで記録できるようにHTTP経由で送信する
+    if (bUseStream && StreamClient->IsConnected() && !IsRecording())
+    {
+        // ストリーミングの応答は受信時に解析済みのため、変換はその場で行う
+        if (OnDecode)
+        {
+            StreamClient->SendCommand(TEXT("unreal"), Command, Params,
+                [OnCompleteCallback = MoveTemp(OnCompleteCallback), OnDecode = MoveTemp(OnDecode)](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
+                {
+                    OnCompleteCallback(bSuccess && Response.IsValid() && OnDecode(Response), Response, Timing);
+                });
+        }
+        else
+        {
+            StreamClient->SendCommand(TEXT("unreal"), Command, Params, MoveTemp(OnCompleteCallback));
+        }
+        return true;
+    }
+    
+    return Transport->EnqueuePost(UnrealCommandURL, BuildCommandPayload(Command, Params), MoveTemp(OnCompleteCallback), MoveTemp(OnDecode));
+}
+
+TSharedPtr<FJsonObject> FMCPClient::FindObjectField(const TSharedPtr<FJsonObject>& Object, const FString& FieldPath)
+{
+    TSharedPtr<FJsonObject> Current = Object;
+    
+    TArray<FString> FieldNames;
+    FieldPath.ParseIntoArray(FieldNames, TEXT("."));
+    for (const FString& FieldName : FieldNames)
+    {
+        const TSharedPtr<FJsonObject>* ChildObj = nullptr;
+        if (!Current.IsValid() || !Current->TryGetObjectField(FieldName, ChildObj))
+        {
+            return nullptr;
+        }
+        Current = *ChildObj;
+    }
+    
+    return Current;
+}
+
+bool FMCPClient::ExecuteBatch(const TArray<FMCPBatchCommand>& Commands, bool bStopOnError,
+                              TFunction<void(bool bSuccess, const TArray<FMCPBatchCommandResult>& Results, const FMCPRequestTiming& Timing)> OnCompleteCallback)
+{
+    // リクエストペイロードの作成
+    TArray<TSharedPtr<FJsonValue>> CommandValues;
+    CommandValues.Reserve(Commands.Num());
+    TArray<FString> CommandNames;
+    CommandNames.Reserve(Commands.Num());
+    for (const FMCPBatchCommand& BatchCommand : Commands)
+    {
+        TSharedRef<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+        CommandObj->SetStringField(TEXT("command"), BatchCommand.Command);
+        CommandObj->SetObjectField(TEXT("params"), BatchCommand.Params.IsValid() ? BatchCommand.Params : MakeShared<FJsonObject>());
+        CommandValues.Add(MakeShared<FJsonValueObject>(CommandObj));
+        CommandNames.Add(BatchCommand.Command);
+    }
+    
+    TSharedRef<FJsonObject> RequestObj = MakeShared<FJsonObject>();
+    RequestObj->SetArrayField(TEXT("commands"), CommandValues);
+    RequestObj->SetBoolField(TEXT("stop_on_error"), bStopOnError);
+    
+    FString JsonPayload;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonPayload);
+    FJsonSerializer::Serialize(RequestObj, Writer);
+    
+    // リクエストの送信
+    return Transport->EnqueuePost(UnrealBatchURL, JsonPayload,
+        [OnCompleteCallback, CommandNames = MoveTemp(CommandNames)](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
+        {
+            TArray<FMCPBatchCommandResult> Results;
+            Results.SetNum(CommandNames.Num());
+            for (int32 Index = 0; Index < CommandNames.Num(); ++Index)
+            {
+                Results[Index].Command = CommandNames[Index];
+            }
+            
+            const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+            if (!bSuccess || !Response.IsValid() || !Response->TryGetArrayField(TEXT("results"), ResultValues))
+            {
+                for (FMCPBatchCommandResult& Result : Results)
+                {
+                    Result.ErrorMessage = TEXT("バッチリクエストが失敗しました");
+                }
+                OnCompleteCallback(false, Results, Timing);
+                return;
+            }
+            
+            // 結果はコマンドと同じ順で返される（stop_on_errorの場合は途中までの場合がある）
+            bool bAllSucceeded = true;
+            for (int32 Index = 0; Index < Results.Num(); ++Index)
+            {
+                FMCPBatchCommandResult& Result = Results[Index];
+                const TSharedPtr<FJsonObject>* ResultObj = nullptr;
+                if (ResultValues->IsValidIndex(Index) && (*ResultValues)[Index]->TryGetObject(ResultObj))
+                {
+                    Result.Response = *ResultObj;
+                    Result.bSuccess = (*ResultObj)->GetStringField(TEXT("status")) == TEXT("success");
+                    if (!Result.bSuccess)
+                    {
+                        (*ResultObj)->TryGetStringField(TEXT("message"), Result.ErrorMessage);
+                    }
+                }
+                else
+                {
+                    Result.ErrorMessage = TEXT("コマンドは実行されませんでした");
+                }
+                
+                bAllSucceeded &= Result.bSuccess;
+            }
+            
+            OnCompleteCallback(bAllSucceeded, Results, Timing);
+        });
+}
+
+FString FMCPClient::GetImportedAssetName(const TSharedPtr<FJsonObject>& Response)
+{
+    FString AssetName;
+    const TSharedPtr<FJsonObject>* ResultObj;
+    if (Response.IsValid() && Response->TryGetObjectField(TEXT("result"), ResultObj))
+    {
+        const TSharedPtr<FJsonObject>* AssetInfoObj;
+        if ((*ResultObj)->TryGetObjectField(TEXT("asset_info"), AssetInfoObj))
+        {
+            AssetName = (*AssetInfoObj)->GetStringField(TEXT("name"));
+        }
+    }
+    return AssetName;
+}
+
+FString FMCPClient::BuildCommandPayload(const FString& Command, const TSharedPtr<FJsonObject>& Params)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMCPClient::BuildCommandPayload);
+    
+    TSharedRef<FJsonObject> RequestObj = MakeShared<FJsonObject>();
+    RequestObj->SetStringField(TEXT("command"), Command);
+    RequestObj->SetObjectField(TEXT("params"), Params.IsValid() ? Params : MakeShared<FJsonObject>());
+    
+    // 送信サイズを抑えるため、改行やインデントを含めずに出力する
+    FString JsonPayload;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonPayload);
+    FJsonSerializer::Serialize(RequestObj, Writer);
+    return JsonPayload;
 }
 
 void FMCPClient::CheckConnection(TFunction<void(bool bSuccess, const FString& Message)> OnCompleteCallback)
 {
-    SendGetRequest(ServerURL + TEXT("/status"), 
+    SendGetRequest(StatusURL, 
         [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response)
         {
-            if (bSuccess)
+            if (bSuccess && Response.IsValid())
             {
                 FString Status = Response->GetStringField(TEXT("status"));
                 if (Status == TEXT("running"))
@@ -49,17 +267,8 @@ void FMCPClient::CheckConnection(TFunction<void(bool bSuccess, const FString& Me
 void FMCPClient::ExecuteBlenderCommand(const FString& Command, const TSharedPtr<FJsonObject>& Params, 
                                      TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response)> OnCompleteCallback)
 {
-    // リクエストペイロードの作成
-    TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-    RequestObj->SetStringField(TEXT("command"), Command);
-    RequestObj->SetObjectField(TEXT("params"), Params);
-    
-    FString JsonPayload;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-    FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-    
     // リクエストの送信
-    SendPostRequest(ServerURL + TEXT("/api/blender/command"), JsonPayload, OnCompleteCallback);
+    SendPostRequest(BlenderCommandURL, BuildCommandPayload(Command, Params), OnCompleteCallback);
 }
 
 void FMCPClient::ImportAsset(const FString& AssetPath, const FString& DestinationPath,
@@ -70,39 +279,19 @@ void FMCPClient::ImportAsset(const FString& AssetPath, const FString& Destinatio
     Params->SetStringField(TEXT("path"), AssetPath);
     Params->SetStringField(TEXT("destination"), DestinationPath);
     
-    // リクエストペイロードの作成
-    TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-    RequestObj->SetStringField(TEXT("command"), TEXT("import_asset"));
-    RequestObj->SetObjectField(TEXT("params"), Params);
-    
-    FString JsonPayload;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-    FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-    
-    // リクエストの送信
-    SendPostRequest(ServerURL + TEXT("/api/unreal/command"), JsonPayload, 
-        [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response)
+    // リクエストの送信（アセット情報への変換は解析と同じワーカースレッドで行う）
+    // 応答にアセット情報がない場合も、通信に成功していればアセット名を空にして成功とする
+    ExecuteUnrealCommandAs<FMCPImportedAssetInfo>(TEXT("import_asset"), Params, TEXT("result.asset_info"),
+        [OnCompleteCallback](bool bSuccess, const FMCPImportedAssetInfo& AssetInfo, const FMCPRequestTiming& Timing)
         {
-            if (bSuccess)
-            {
-                FString AssetName;
-                const TSharedPtr<FJsonObject>* ResultObj;
-                if (Response->TryGetObjectField(TEXT("result"), ResultObj))
-                {
-                    const TSharedPtr<FJsonObject>* AssetInfoObj;
-                    if ((*ResultObj)->TryGetObjectField(TEXT("asset_info"), AssetInfoObj))
-                    {
-                        AssetName = (*AssetInfoObj)->GetStringField(TEXT("name"));
-                    }
-                }
-                
-                OnCompleteCallback(true, AssetName);
-            }
-            else
-            {
-                OnCompleteCallback(false, TEXT(""));
-            }
-        });
+            OnCompleteCallback(bSuccess, bSuccess ? AssetInfo.Name : FString());
+        },
+        false);
+}
+
+bool FMCPClient::FetchMeshBuffer(const FString& MeshName, FMCPHttpTransport::FOnBinaryRequestComplete OnCompleteCallback)
+{
+    return Transport->EnqueueGetBinary(MeshBufferURL + FGenericPlatformHttp::UrlEncode(MeshName), MoveTemp(OnCompleteCallback));
 }
 
 void FMCPClient::SetGameMode(const FString& GameModePath, 
@@ -112,17 +301,8 @@ void FMCPClient::SetGameMode(const FString& GameModePath,
     TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
     Params->SetStringField(TEXT("game_mode"), GameModePath);
     
-    // リクエストペイロードの作成
-    TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-    RequestObj->SetStringField(TEXT("command"), TEXT("set_game_mode"));
-    RequestObj->SetObjectField(TEXT("params"), Params);
-    
-    FString JsonPayload;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-    FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-    
     // リクエストの送信
-    SendPostRequest(ServerURL + TEXT("/api/unreal/command"), JsonPayload, 
+    SendPostRequest(UnrealCommandURL, BuildCommandPayload(TEXT("set_game_mode"), Params), 
         [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response)
         {
             OnCompleteCallback(bSuccess);
@@ -131,17 +311,8 @@ void FMCPClient::SetGameMode(const FString& GameModePath,
 
 void FMCPClient::SaveLevel(TFunction<void(bool bSuccess)> OnCompleteCallback)
 {
-    // リクエストペイロードの作成
-    TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-    RequestObj->SetStringField(TEXT("command"), TEXT("save_level"));
-    RequestObj->SetObjectField(TEXT("params"), MakeShared<FJsonObject>());
-    
-    FString JsonPayload;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-    FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-    
     // リクエストの送信
-    SendPostRequest(ServerURL + TEXT("/api/unreal/command"), JsonPayload, 
+    SendPostRequest(UnrealCommandURL, BuildCommandPayload(TEXT("save_level"), nullptr), 
         [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response)
         {
             OnCompleteCallback(bSuccess);
@@ -151,87 +322,19 @@ void FMCPClient::SaveLevel(TFunction<void(bool bSuccess)> OnCompleteCallback)
 void FMCPClient::SendPostRequest(const FString& URL, const FString& JsonPayload,
                                TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response)> OnCompleteCallback)
 {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetURL(URL);
-    HttpRequest->SetVerb(TEXT("POST"));
-    HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    HttpRequest->SetContentAsString(JsonPayload);
-    
-    HttpRequest->OnProcessRequestComplete().BindLambda(
-        [OnCompleteCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    Transport->EnqueuePost(URL, JsonPayload,
+        [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
         {
-            bool bSuccess = false;
-            TSharedPtr<FJsonObject> JsonResponse;
-            
-            if (bConnectedSuccessfully && Response.IsValid())
-            {
-                if (Response->GetResponseCode() == EHttpResponseCodes::Ok)
-                {
-                    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-                    if (FJsonSerializer::Deserialize(Reader, JsonResponse))
-                    {
-                        bSuccess = true;
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Error, TEXT("JSONのパースに失敗しました: %s"), *Response->GetContentAsString());
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Error, TEXT("HTTPリクエストが失敗しました: %d"), Response->GetResponseCode());
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("HTTPリクエストの接続に失敗しました"));
-            }
-            
-            OnCompleteCallback(bSuccess, JsonResponse);
+            OnCompleteCallback(bSuccess, Response);
         });
-    
-    HttpRequest->ProcessRequest();
 }
 
 void FMCPClient::SendGetRequest(const FString& URL,
                               TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response)> OnCompleteCallback)
 {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetURL(URL);
-    HttpRequest->SetVerb(TEXT("GET"));
-    
-    HttpRequest->OnProcessRequestComplete().BindLambda(
-        [OnCompleteCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    Transport->EnqueueGet(URL,
+        [OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
         {
-            bool bSuccess = false;
-            TSharedPtr<FJsonObject> JsonResponse;
-            
-            if (bConnectedSuccessfully && Response.IsValid())
-            {
-                if (Response->GetResponseCode() == EHttpResponseCodes::Ok)
-                {
-                    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-                    if (FJsonSerializer::Deserialize(Reader, JsonResponse))
-                    {
-                        bSuccess = true;
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Error, TEXT("JSONのパースに失敗しました: %s"), *Response->GetContentAsString());
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Error, TEXT("HTTPリクエストが失敗しました: %d"), Response->GetResponseCode());
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("HTTPリクエストの接続に失敗しました"));
-            }
-            
-            OnCompleteCallback(bSuccess, JsonResponse);
+            OnCompleteCallback(bSuccess, Response);
         });
-    
-    HttpRequest->ProcessRequest();
-} 
+}
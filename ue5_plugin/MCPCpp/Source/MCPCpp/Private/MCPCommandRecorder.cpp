@@ -0,0 +1,164 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPCommandRecorder.h"
+#include "MCPHttpTransport.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    /** 応答の本文を記録する最大のバイト数 */
+    TAutoConsoleVariable<int32> CVarRecordMaxResponseBytes(
+        TEXT("MCP.RecordMaxResponseBytes"),
+        64 * 1024,
+        TEXT("MCPコマンドの記録で、応答の本文を保存する最大のバイト数（0で本文を保存しない）"));
+
+    /** 記録のフラグ */
+    enum ERecordFlags : uint8
+    {
+        RecordFlag_Success = 1 << 0,
+        RecordFlag_Rejected = 1 << 1,
+    };
+}
+
+FArchive& operator<<(FArchive& Ar, FMCPRecordedCommand& Command)
+{
+    uint8 Kind = static_cast<uint8>(Command.Kind);
+    uint8 Flags = (Command.bSuccess ? RecordFlag_Success : 0) | (Command.bRejected ? RecordFlag_Rejected : 0);
+    int16 ResponseCode = static_cast<int16>(Command.ResponseCode);
+
+    Ar << Kind;
+    Ar << Flags;
+    Ar << ResponseCode;
+    Ar << Command.StartSeconds;
+    Ar << Command.QueueMs;
+    Ar << Command.ServerMs;
+    Ar << Command.TotalMs;
+    Ar << Command.Path;
+    Ar << Command.Payload;
+    Ar << Command.ResponseSize;
+    Ar << Command.Response;
+
+    if (Ar.IsLoading())
+    {
+        Command.Kind = static_cast<EMCPRecordedRequestKind>(Kind);
+        Command.bSuccess = (Flags & RecordFlag_Success) != 0;
+        Command.bRejected = (Flags & RecordFlag_Rejected) != 0;
+        Command.ResponseCode = ResponseCode;
+    }
+    return Ar;
+}
+
+TSharedPtr<FMCPCommandRecorder> FMCPCommandRecorder::Create(const FString& FilePath, const FString& BaseURL)
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPコマンドの記録ファイルを作成できませんでした: %s"), *FilePath);
+        return nullptr;
+    }
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+    FString HeaderBaseURL = BaseURL;
+    *Writer << Magic;
+    *Writer << Version;
+    *Writer << HeaderBaseURL;
+
+    UE_LOG(LogTemp, Log, TEXT("MCPコマンドの記録を開始しました: %s"), *FilePath);
+    return TSharedPtr<FMCPCommandRecorder>(new FMCPCommandRecorder(MoveTemp(Writer), FilePath, BaseURL));
+}
+
+bool FMCPCommandRecorder::LoadLog(const FString& FilePath, FString& OutBaseURL, TArray<FMCPRecordedCommand>& OutCommands)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPコマンドの記録ファイルを開けませんでした: %s"), *FilePath);
+        return false;
+    }
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    *Reader << Magic;
+    *Reader << Version;
+    if (Magic != FileMagic || Version != FileVersion)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPコマンドの記録ファイルの形式が異なります: %s (版 %u)"), *FilePath, Version);
+        return false;
+    }
+    *Reader << OutBaseURL;
+
+    OutCommands.Reset();
+    while (!Reader->AtEnd() && !Reader->IsError())
+    {
+        FMCPRecordedCommand& Command = OutCommands.AddDefaulted_GetRef();
+        *Reader << Command;
+    }
+
+    // 書き込み中に終了した場合は最後の1件が途中で切れている
+    if (Reader->IsError())
+    {
+        OutCommands.Pop();
+        UE_LOG(LogTemp, Warning, TEXT("MCPコマンドの記録ファイルの末尾が壊れているため無視しました: %s"), *FilePath);
+    }
+    return true;
+}
+
+FMCPCommandRecorder::FMCPCommandRecorder(TUniquePtr<FArchive>&& InWriter, const FString& InFilePath, const FString& InBaseURL)
+    : Writer(MoveTemp(InWriter))
+    , FilePath(InFilePath)
+    , BaseURL(InBaseURL)
+    , StartTime(FPlatformTime::Seconds())
+    , RecordCount(0)
+{
+}
+
+FMCPCommandRecorder::~FMCPCommandRecorder()
+{
+    Close();
+}
+
+void FMCPCommandRecorder::Record(EMCPRecordedRequestKind Kind, const FString& URL, const FString& Payload, double EnqueueTime,
+                                 const FMCPRequestTiming& Timing, bool bSuccess, TConstArrayView<uint8> Response)
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    FMCPRecordedCommand Command;
+    Command.Kind = Kind;
+    Command.Path = URL.StartsWith(BaseURL) ? URL.RightChop(BaseURL.Len()) : URL;
+    Command.Payload = Payload;
+    Command.StartSeconds = FMath::Max(EnqueueTime - StartTime, 0.0);
+    Command.QueueMs = static_cast<float>(Timing.QueueSeconds * 1000.0);
+    Command.ServerMs = static_cast<float>(Timing.ServerSeconds * 1000.0);
+    Command.TotalMs = static_cast<float>(Timing.TotalSeconds * 1000.0);
+    Command.ResponseCode = Timing.ResponseCode;
+    Command.bSuccess = bSuccess;
+    Command.bRejected = Timing.bRejected;
+    Command.ResponseSize = static_cast<uint32>(Response.Num());
+
+    const int32 MaxResponseBytes = FMath::Max(CVarRecordMaxResponseBytes.GetValueOnGameThread(), 0);
+    Command.Response.Append(Response.GetData(), FMath::Min(Response.Num(), MaxResponseBytes));
+
+    *Writer << Command;
+    RecordCount++;
+
+    // 異常終了しても大部分が残るように、一定件数ごとに書き出す
+    if (RecordCount % 64 == 0)
+    {
+        Writer->Flush();
+    }
+}
+
+void FMCPCommandRecorder::Close()
+{
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+        UE_LOG(LogTemp, Log, TEXT("MCPコマンドの記録を終了しました: %s (%d 件)"), *FilePath, RecordCount);
+    }
+}
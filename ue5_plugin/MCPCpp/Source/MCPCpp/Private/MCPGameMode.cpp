@@ -1,23 +1,28 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPGameMode.h"
+#include "MCPImportPipeline.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManagerGeneric.h"
 
 AMCPGameMode::AMCPGameMode()
-    : bConnectedToServer(false)
+    : MaxParallelImports(8)
+    , AssetManager(nullptr)
+    , bConnectedToServer(false)
 {
     // ゲームモードの初期設定
     PrimaryActorTick.bCanEverTick = true;
     
-    // アセットマネージャーの取得
-    AssetManager = UMCPAssetManager::Get();
+    // アセットマネージャーはCDOの作成時（モジュールの読み込み時）には作らず、プレイ開始時に取得する
 }
 
 void AMCPGameMode::StartPlay()
 {
     Super::StartPlay();
     
+    // アセットマネージャーの取得
+    AssetManager = UMCPAssetManager::Get();
+    
     // MCPサーバーへの接続を確認
     if (AssetManager)
     {
@@ -44,7 +49,12 @@ void AMCPGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
     
-    // 必要に応じてリソースのクリーンアップ
+    // 未送信のインポートを取り消す（インポート中のものは完了を待たずに結果を破棄する）
+    if (DirectoryImportPipeline.IsValid())
+    {
+        DirectoryImportPipeline->Cancel();
+        DirectoryImportPipeline.Reset();
+    }
 }
 
 void AMCPGameMode::ImportBlenderAsset(const FString& AssetPath, const FString& DestinationPath, 
@@ -117,27 +127,44 @@ void AMCPGameMode::ImportAllAssetsInDirectory(const FString& DirectoryPath, cons
         return;
     }
     
-    // 各ファイルをインポート
-    // 注：実際にはもっと洗練された非同期処理が必要
-    bool bAllSucceeded = true;
-    for (const FString& File : Files)
+    if (DirectoryImportPipeline.IsValid() && !DirectoryImportPipeline->IsComplete())
     {
-        FString FullPath = FPaths::Combine(DirectoryPath, File);
-        
-        // ここでは同期的に処理していますが、実際には非同期処理が望ましい
-        AssetManager->ImportBlenderModel(FullPath, DestinationPath, 
-            [&bAllSucceeded](const FMCPAssetImportResult& Result) {
-                if (!Result.bSuccess)
-                {
-                    bAllSucceeded = false;
-                }
-            });
+        UE_LOG(LogTemp, Warning, TEXT("ディレクトリのインポートが既に実行中です"));
+        if (OnComplete.IsBound())
+        {
+            OnComplete.Execute(false);
+        }
+        return;
     }
     
-    if (OnComplete.IsBound())
+    TArray<FString> ModelPaths;
+    ModelPaths.Reserve(Files.Num());
+    for (const FString& File : Files)
     {
-        OnComplete.Execute(bAllSucceeded);
+        ModelPaths.Add(FPaths::Combine(DirectoryPath, File));
     }
+    
+    // 同時実行数を制限しながら非同期でインポートし、全件完了時に結果をまとめて通知する
+    TWeakObjectPtr<AMCPGameMode> WeakThis(this);
+    DirectoryImportPipeline = FMCPImportPipeline::Start(AssetManager, ModelPaths, DestinationPath, MaxParallelImports,
+        [WeakThis](int32 CompletedCount, int32 TotalCount, const FMCPAssetImportResult& Result) {
+            if (WeakThis.IsValid())
+            {
+                WeakThis->OnDirectoryImportProgress.Broadcast(CompletedCount, TotalCount, Result);
+            }
+        },
+        [WeakThis, OnComplete](const TArray<FMCPAssetImportResult>& Results) {
+            bool bAllSucceeded = true;
+            for (const FMCPAssetImportResult& Result : Results)
+            {
+                bAllSucceeded &= Result.bSuccess;
+            }
+            
+            if (WeakThis.IsValid() && OnComplete.IsBound())
+            {
+                OnComplete.Execute(bAllSucceeded);
+            }
+        });
 }
 
 bool AMCPGameMode::CreateCustomLevel(const FString& LevelName, const FString& Template)
@@ -1,61 +1,45 @@
 // Copyright MCP Framework. All Rights Reserved.
 
 #include "MCPGameplayComponent.h"
+#include "MCPSubsystem.h"
+#include "MCPAssetJobGraph.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/World.h"
 
 UMCPGameplayComponent::UMCPGameplayComponent()
+    : bCheckServerOnBeginPlay(false)
 {
-    // コンポーネントをティック有効に設定
-    PrimaryComponentTick.bCanEverTick = true;
-    
-    // 初期設定
-    AssetManager = nullptr;
-}
-
-void UMCPGameplayComponent::InitializeComponent()
-{
-    Super::InitializeComponent();
-    
-    // アセットマネージャーの参照を取得
-    AssetManager = UMCPAssetManager::Get();
-    
-    if (!AssetManager)
-    {
-        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーの取得に失敗しました"));
-    }
+    // 大量にスポーンされるアクターにも付けるため、ティックは行わない
+    PrimaryComponentTick.bCanEverTick = false;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UMCPGameplayComponent::BeginPlay()
 {
     Super::BeginPlay();
     
-    // 初期化確認
-    if (AssetManager)
+    // サーバー接続の確認はサブシステムが1回だけ行うため、明示的に指定した場合のみ確認する
+    if (bCheckServerOnBeginPlay)
     {
-        // サーバー接続を確認
-        AssetManager->CheckServerConnection([](bool bSuccess, const FString& Message) {
-            if (bSuccess)
-            {
-                UE_LOG(LogTemp, Log, TEXT("MCPサーバーに接続しました: %s"), *Message);
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("MCPサーバーに接続できませんでした: %s"), *Message);
-            }
-        });
+        if (UMCPAssetManager* AssetManager = GetAssetManager())
+        {
+            AssetManager->CheckServerConnection([](bool bSuccess, const FString& Message) {
+                UE_LOG(LogTemp, Verbose, TEXT("MCPサーバーの状態: %s (%s)"), bSuccess ? TEXT("接続中") : TEXT("未接続"), *Message);
+            });
+        }
     }
 }
 
-void UMCPGameplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+UMCPAssetManager* UMCPGameplayComponent::GetAssetManager() const
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    // 必要に応じてティック処理を実装
+    // インスタンスごとには保持せず、ゲームインスタンスで共有するサブシステムから取得する
+    UMCPSubsystem* Subsystem = UMCPSubsystem::Get(this);
+    return Subsystem ? Subsystem->GetAssetManager() : nullptr;
 }
 
 void UMCPGameplayComponent::LoadBlenderAsset(const FString& AssetPath, FOnAssetLoaded OnLoaded)
 {
+    UMCPAssetManager* AssetManager = GetAssetManager();
     if (!AssetManager)
     {
         UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
@@ -66,55 +50,95 @@ void UMCPGameplayComponent::LoadBlenderAsset(const FString& AssetPath, FOnAssetL
         return;
     }
     
-    // アセットのロード（すでにインポート済みの場合）
-    UObject* Asset = LoadObject<UObject>(nullptr, *AssetPath);
-    if (Asset)
-    {
-        UE_LOG(LogTemp, Log, TEXT("アセット '%s' はすでにロードされています"), *AssetPath);
+    // アセットのロード（ゲームスレッドをブロックしないように非同期で行う）
+    AssetManager->RequestAsset(AssetPath, [OnLoaded](UObject* Asset) {
         if (OnLoaded.IsBound())
         {
-            OnLoaded.Execute(true);
+            OnLoaded.Execute(Asset != nullptr);
         }
+    });
+}
+
+void UMCPGameplayComponent::RequestBlenderAsset(const FString& AssetPath, TFunction<void(UObject* Asset)> OnResident)
+{
+    UMCPAssetManager* AssetManager = GetAssetManager();
+    if (!AssetManager)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
+        OnResident(nullptr);
         return;
     }
     
-    // アセットのインポート処理が必要な場合
-    // この実装はアセットの場所によって変わるため、ここでは簡略化
-    UE_LOG(LogTemp, Warning, TEXT("アセット '%s' のロードに失敗しました。インポートが必要かもしれません。"), *AssetPath);
-    if (OnLoaded.IsBound())
-    {
-        OnLoaded.Execute(false);
-    }
+    AssetManager->RequestAsset(AssetPath, MoveTemp(OnResident));
 }
 
 AActor* UMCPGameplayComponent::SpawnAssetActor(const FString& AssetPath, FVector Location, FRotator Rotation, FVector Scale)
 {
+    UMCPAssetManager* AssetManager = GetAssetManager();
     if (!AssetManager)
     {
         UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
         return nullptr;
     }
     
-    // アセットのロード
-    UObject* Asset = LoadObject<UObject>(nullptr, *AssetPath);
+    // ロード済みのアセットのみ使用する（同期ロードでゲームスレッドを止めない）
+    UObject* Asset = AssetManager->FindResidentAsset(AssetPath);
     if (!Asset)
     {
-        UE_LOG(LogTemp, Error, TEXT("アセット '%s' をロードできませんでした"), *AssetPath);
+        UE_LOG(LogTemp, Warning, TEXT("アセット '%s' はまだロードされていません。ロードを開始します（SpawnAssetActorAsyncの使用を推奨します）"), *AssetPath);
+        AssetManager->RequestAsset(AssetPath, [](UObject* LoadedAsset) {});
         return nullptr;
     }
     
-    // スタティックメッシュの場合
-    UStaticMesh* StaticMesh = Cast<UStaticMesh>(Asset);
-    if (StaticMesh)
+    return SpawnActorFromAsset(Asset, AssetPath, Location, Rotation, Scale);
+}
+
+void UMCPGameplayComponent::SpawnAssetActorAsync(const FString& AssetPath, FVector Location, FRotator Rotation, FVector Scale, FOnActorSpawned OnSpawned)
+{
+    UMCPAssetManager* AssetManager = GetAssetManager();
+    if (!AssetManager)
     {
-        // ワールドが有効か確認
-        UWorld* World = GetWorld();
-        if (!World)
+        UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
+        if (OnSpawned.IsBound())
         {
-            UE_LOG(LogTemp, Error, TEXT("ワールドが無効です"));
-            return nullptr;
+            OnSpawned.Execute(nullptr);
+        }
+        return;
+    }
+    
+    TWeakObjectPtr<UMCPGameplayComponent> WeakThis(this);
+    AssetManager->RequestAsset(AssetPath, [WeakThis, AssetPath, Location, Rotation, Scale, OnSpawned](UObject* Asset) {
+        AActor* SpawnedActor = nullptr;
+        if (Asset && WeakThis.IsValid())
+        {
+            SpawnedActor = WeakThis->SpawnActorFromAsset(Asset, AssetPath, Location, Rotation, Scale);
+        }
+        else if (!Asset)
+        {
+            UE_LOG(LogTemp, Error, TEXT("アセット '%s' をロードできませんでした"), *AssetPath);
         }
         
+        if (OnSpawned.IsBound())
+        {
+            OnSpawned.Execute(SpawnedActor);
+        }
+    });
+}
+
+AActor* UMCPGameplayComponent::SpawnActorFromAsset(UObject* Asset, const FString& AssetPath, const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+{
+    // ワールドが有効か確認
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ワールドが無効です"));
+        return nullptr;
+    }
+    
+    // スタティックメッシュの場合
+    UStaticMesh* StaticMesh = Cast<UStaticMesh>(Asset);
+    if (StaticMesh)
+    {
         // メッシュアクターの生成
         AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Location, Rotation);
         if (MeshActor)
@@ -133,13 +157,6 @@ AActor* UMCPGameplayComponent::SpawnAssetActor(const FString& AssetPath, FVector
         UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
         if (Blueprint && Blueprint->GeneratedClass)
         {
-            UWorld* World = GetWorld();
-            if (!World)
-            {
-                UE_LOG(LogTemp, Error, TEXT("ワールドが無効です"));
-                return nullptr;
-            }
-            
             // ブループリントアクターの生成
             AActor* Actor = World->SpawnActor(Blueprint->GeneratedClass, &Location, &Rotation);
             if (Actor)
@@ -158,6 +175,7 @@ AActor* UMCPGameplayComponent::SpawnAssetActor(const FString& AssetPath, FVector
 
 void UMCPGameplayComponent::SpawnCustomBlenderAsset(const FString& ModelType, FVector Location, FRotator Rotation, FVector Scale, FOnActorSpawned OnSpawned)
 {
+    UMCPAssetManager* AssetManager = GetAssetManager();
     if (!AssetManager)
     {
         UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーが初期化されていません"));
@@ -168,10 +186,13 @@ void UMCPGameplayComponent::SpawnCustomBlenderAsset(const FString& ModelType, FV
         return;
     }
     
-    // Blenderでのモデル生成とUE5へのインポートプロセス
-    // MCPサーバー経由でBlenderにモデル生成をリクエストする
+    // Blenderでの生成 → エクスポート → UE5へのインポートを順に実行し、インポートしたアセットをスポーンする
+    const FString ObjectName = FString::Printf(TEXT("MCP_%s"), *ModelType);
+    const FString ExportPath = FPaths::ProjectSavedDir() / TEXT("MCP/Generated") / (ObjectName + TEXT(".fbx"));
+    
     TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
     Params->SetStringField(TEXT("model_type"), ModelType);
+    Params->SetStringField(TEXT("name"), ObjectName);
     Params->SetArrayField(TEXT("location"), {
         MakeShared<FJsonValueNumber>(Location.X),
         MakeShared<FJsonValueNumber>(Location.Y),
@@ -183,12 +204,33 @@ void UMCPGameplayComponent::SpawnCustomBlenderAsset(const FString& ModelType, FV
         MakeShared<FJsonValueNumber>(Scale.Z)
     });
     
-    // ToDo: 実際のBlenderコマンド実行と結果の取得処理を実装
-    UE_LOG(LogTemp, Warning, TEXT("カスタムBlenderアセットの生成は現在実装中です"));
     
-    // ダミー実装（実際にはBlenderとの通信処理を実装）
-    if (OnSpawned.IsBound())
-    {
-        OnSpawned.Execute(nullptr);
-    }
-} 
+    TSharedPtr<FJsonObject> ExportParams = MakeShared<FJsonObject>();
+    ExportParams->SetStringField(TEXT("name"), ObjectName);
+    ExportParams->SetStringField(TEXT("format"), TEXT("fbx"));
+    ExportParams->SetStringField(TEXT("path"), ExportPath);
+    
+    TArray<FMCPAssetJobStep> Steps;
+    Steps.Add(FMCPAssetJobStep::MakeBlenderCommand(TEXT("Generate"), TEXT("add_object"), Params));
+    Steps.Add(FMCPAssetJobStep::MakeBlenderCommand(TEXT("Export"), TEXT("export_asset"), ExportParams, { TEXT("Generate") }));
+    Steps.Add(FMCPAssetJobStep::MakeImport(TEXT("Import"), ExportPath, TEXT("/Game/MCP/Generated"), { TEXT("Export") }));
+    Steps.Last().MaxRetries = 1;
+    
+    TWeakObjectPtr<UMCPGameplayComponent> WeakThis(this);
+    FMCPAssetJobGraph::Start(AssetManager, Steps, 1, nullptr,
+        [WeakThis, ModelType, Location, Rotation, Scale, OnSpawned](const TArray<FMCPAssetJobStepResult>& Results)
+        {
+            const FMCPAssetJobStepResult& ImportStep = Results.Last();
+            if (!WeakThis.IsValid() || ImportStep.Status != EMCPAssetJobStepStatus::Succeeded)
+            {
+                UE_LOG(LogTemp, Error, TEXT("カスタムBlenderアセット '%s' の生成に失敗しました: %s"), *ModelType, *ImportStep.ErrorMessage);
+                if (OnSpawned.IsBound())
+                {
+                    OnSpawned.Execute(nullptr);
+                }
+                return;
+            }
+            
+            WeakThis->SpawnAssetActorAsync(ImportStep.ImportResult.AssetPath, Location, Rotation, Scale, OnSpawned);
+        });
+}
@@ -0,0 +1,356 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPHttpTransport.h"
+#include "MCPStats.h"
+#include "MCPCommandRecorder.h"
+#include "HttpModule.h"
+#include "Async/Async.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FMCPHttpTransport::FMCPHttpTransport()
+    : MaxConcurrentRequests(4)
+    , MaxQueuedRequests(256)
+    , RequestTimeoutSeconds(30.0f)
+    , OffThreadDecodeThreshold(16 * 1024)
+    , InFlightCount(0)
+    , PendingHead(0)
+    , CoalescedRequestCount(0)
+{
+}
+
+FMCPHttpTransport::~FMCPHttpTransport()
+{
+    CancelPending();
+}
+
+void FMCPHttpTransport::SetMaxConcurrentRequests(int32 InMaxConcurrentRequests)
+{
+    MaxConcurrentRequests = FMath::Max(InMaxConcurrentRequests, 1);
+    PumpQueue();
+}
+
+void FMCPHttpTransport::SetMaxQueuedRequests(int32 InMaxQueuedRequests)
+{
+    MaxQueuedRequests = FMath::Max(InMaxQueuedRequests, 0);
+}
+
+void FMCPHttpTransport::SetRequestTimeout(float InTimeoutSeconds)
+{
+    RequestTimeoutSeconds = InTimeoutSeconds;
+}
+
+void FMCPHttpTransport::SetOffThreadDecodeThreshold(int32 InThresholdBytes)
+{
+    OffThreadDecodeThreshold = FMath::Max(InThresholdBytes, 0);
+}
+
+bool FMCPHttpTransport::EnqueuePost(const FString& URL, const FString& JsonPayload, FOnRequestComplete OnComplete,
+                                    FOnDecodeResponse OnDecode)
+{
+    FPendingRequest Request;
+    Request.URL = URL;
+    Request.Verb = TEXT("POST");
+    Request.Payload = JsonPayload;
+    Request.OnComplete = MoveTemp(OnComplete);
+    Request.OnDecode = MoveTemp(OnDecode);
+    return Enqueue(MoveTemp(Request));
+}
+
+bool FMCPHttpTransport::EnqueueGet(const FString& URL, FOnRequestComplete OnComplete)
+{
+    // 同じURLへのGETが完了していなければ、その応答を待つ
+    if (TSharedRef<TArray<FOnRequestComplete>>* Waiters = InFlightGets.Find(URL))
+    {
+        (*Waiters)->Add(MoveTemp(OnComplete));
+        CoalescedRequestCount++;
+        return true;
+    }
+
+    TSharedRef<TArray<FOnRequestComplete>> Waiters = MakeShared<TArray<FOnRequestComplete>>();
+    Waiters->Add(MoveTemp(OnComplete));
+    InFlightGets.Add(URL, Waiters);
+
+    FPendingRequest Request;
+    Request.URL = URL;
+    Request.Verb = TEXT("GET");
+
+    // 完了時に、待っている全てのコールバックへ同じ応答を通知する
+    TWeakPtr<FMCPHttpTransport, ESPMode::ThreadSafe> WeakTransport = AsShared();
+    Request.OnComplete = [WeakTransport, URL, Waiters](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
+    {
+        if (TSharedPtr<FMCPHttpTransport, ESPMode::ThreadSafe> Transport = WeakTransport.Pin())
+        {
+            Transport->InFlightGets.Remove(URL);
+        }
+
+        // コールバック内で同じURLが再度要求された場合は新しいリクエストになる
+        const TArray<FOnRequestComplete> Callbacks = MoveTemp(*Waiters);
+        Waiters->Reset();
+        for (const FOnRequestComplete& Callback : Callbacks)
+        {
+            if (Callback)
+            {
+                Callback(bSuccess, Response, Timing);
+            }
+        }
+    };
+    return Enqueue(MoveTemp(Request));
+}
+
+bool FMCPHttpTransport::EnqueueGetBinary(const FString& URL, FOnBinaryRequestComplete OnComplete)
+{
+    FPendingRequest Request;
+    Request.URL = URL;
+    Request.Verb = TEXT("GET");
+    Request.OnBinaryComplete = MoveTemp(OnComplete);
+    return Enqueue(MoveTemp(Request));
+}
+
+void FMCPHttpTransport::FPendingRequest::NotifyFailure(const FMCPRequestTiming& Timing) const
+{
+    if (OnComplete)
+    {
+        OnComplete(false, nullptr, Timing);
+    }
+    if (OnBinaryComplete)
+    {
+        OnBinaryComplete(false, TConstArrayView<uint8>(), Timing);
+    }
+}
+
+bool FMCPHttpTransport::CanAcceptRequest() const
+{
+    return MaxQueuedRequests == 0 || GetQueuedCount() < MaxQueuedRequests;
+}
+
+void FMCPHttpTransport::CancelPending()
+{
+    // コールバック内で新しいリクエストが追加されても影響しないように取り出してから通知する
+    TArray<FPendingRequest> Cancelled = MoveTemp(PendingRequests);
+    const int32 CancelledHead = PendingHead;
+    PendingRequests.Reset();
+    PendingHead = 0;
+
+    const double Now = FPlatformTime::Seconds();
+    for (int32 Index = CancelledHead; Index < Cancelled.Num(); ++Index)
+    {
+        const FPendingRequest& Request = Cancelled[Index];
+        FMCPRequestTiming Timing;
+        Timing.QueueSeconds = Now - Request.EnqueueTime;
+        Timing.TotalSeconds = Timing.QueueSeconds;
+        Request.NotifyFailure(Timing);
+    }
+}
+
+bool FMCPHttpTransport::Enqueue(FPendingRequest&& Request)
+{
+    Request.EnqueueTime = FPlatformTime::Seconds();
+
+    if (!CanAcceptRequest())
+    {
+        // バックプレッシャー：キューが満杯の場合は送信せずに失敗を返す
+        UE_LOG(LogTemp, Warning, TEXT("MCPリクエストキューが満杯のため拒否しました: %s (待機中 %d)"), *Request.URL, GetQueuedCount());
+
+        FMCPRequestTiming Timing;
+        Timing.bRejected = true;
+        RecordRequest(Request, Timing, false, TConstArrayView<uint8>());
+        Request.NotifyFailure(Timing);
+        return false;
+    }
+
+    PendingRequests.Add(MoveTemp(Request));
+    PumpQueue();
+    MCPStats::RecordQueueDepth(InFlightCount, GetQueuedCount());
+    return true;
+}
+
+void FMCPHttpTransport::PumpQueue()
+{
+    while (InFlightCount < MaxConcurrentRequests && PendingHead < PendingRequests.Num())
+    {
+        FPendingRequest Request = MoveTemp(PendingRequests[PendingHead]);
+        PendingHead++;
+
+        // 先頭側の送信済み領域が大きくなったらまとめて詰める
+        if (PendingHead == PendingRequests.Num())
+        {
+            PendingRequests.Reset();
+            PendingHead = 0;
+        }
+        else if (PendingHead >= 64 && PendingHead * 2 >= PendingRequests.Num())
+        {
+            PendingRequests.RemoveAt(0, PendingHead, false);
+            PendingHead = 0;
+        }
+
+        Dispatch(MoveTemp(Request));
+    }
+}
+
+void FMCPHttpTransport::Dispatch(FPendingRequest&& Request)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPRequestSend);
+    TRACE_CPUPROFILER_EVENT_SCOPE(MCP::SendRequest);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+    HttpRequest->SetURL(Request.URL);
+    HttpRequest->SetVerb(Request.Verb);
+
+    // 同じホストへの接続を使い回す（サーバー側もHTTP/1.1で応答します）
+    HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+    HttpRequest->SetHeader(TEXT("Accept"), Request.OnBinaryComplete ? TEXT("application/octet-stream") : TEXT("application/json"));
+
+    if (Request.Verb == TEXT("POST"))
+    {
+        HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        HttpRequest->SetContentAsString(Request.Payload);
+    }
+
+    if (RequestTimeoutSeconds > 0.0f)
+    {
+        HttpRequest->SetTimeout(RequestTimeoutSeconds);
+    }
+
+    const double DispatchTime = FPlatformTime::Seconds();
+    TWeakPtr<FMCPHttpTransport, ESPMode::ThreadSafe> WeakTransport = AsShared();
+
+    HttpRequest->OnProcessRequestComplete().BindLambda(
+        [WeakTransport, DispatchTime, Request = MoveTemp(Request)](FHttpRequestPtr HttpRequest, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            if (TSharedPtr<FMCPHttpTransport, ESPMode::ThreadSafe> Transport = WeakTransport.Pin())
+            {
+                Transport->HandleComplete(Response, bConnectedSuccessfully, DispatchTime, Request);
+            }
+            else
+            {
+                // トランスポートが破棄された後に完了した場合は失敗として通知する
+                FMCPRequestTiming Timing;
+                Timing.QueueSeconds = DispatchTime - Request.EnqueueTime;
+                Timing.TotalSeconds = FPlatformTime::Seconds() - Request.EnqueueTime;
+                Request.NotifyFailure(Timing);
+            }
+        });
+
+    InFlightCount++;
+    HttpRequest->ProcessRequest();
+}
+
+void FMCPHttpTransport::HandleComplete(FHttpResponsePtr Response, bool bConnectedSuccessfully, double DispatchTime, const FPendingRequest& Request)
+{
+    const double CompleteTime = FPlatformTime::Seconds();
+    InFlightCount = FMath::Max(InFlightCount - 1, 0);
+
+    FMCPRequestTiming Timing;
+    Timing.QueueSeconds = DispatchTime - Request.EnqueueTime;
+    Timing.ServerSeconds = CompleteTime - DispatchTime;
+    Timing.TotalSeconds = CompleteTime - Request.EnqueueTime;
+
+    UE_LOG(LogTemp, Verbose, TEXT("MCPリクエスト完了: 待機 %.1fms / サーバー %.1fms"), Timing.QueueSeconds * 1000.0, Timing.ServerSeconds * 1000.0);
+
+    // 空いた枠で次のリクエストを先に送信してから通知する
+    PumpQueue();
+
+    // 送信バイト数はペイロードの文字数で近似する（ペイロードはほぼASCIIのJSON）
+    const int32 BytesSent = Request.Payload.Len();
+    const int32 BytesReceived = Response.IsValid() ? Response->GetContent().Num() : 0;
+    Timing.ResponseCode = (bConnectedSuccessfully && Response.IsValid()) ? Response->GetResponseCode() : 0;
+    MCPStats::RecordRequestComplete(Timing, BytesSent, BytesReceived, InFlightCount, GetQueuedCount());
+
+    const bool bSucceeded = bConnectedSuccessfully && Response.IsValid() && Timing.ResponseCode == EHttpResponseCodes::Ok;
+    RecordRequest(Request, Timing, bSucceeded, Response.IsValid() ? TConstArrayView<uint8>(Response->GetContent()) : TConstArrayView<uint8>());
+
+    if (!bConnectedSuccessfully || !Response.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("HTTPリクエストの接続に失敗しました"));
+        Request.NotifyFailure(Timing);
+        return;
+    }
+
+    if (Timing.ResponseCode != EHttpResponseCodes::Ok)
+    {
+        UE_LOG(LogTemp, Error, TEXT("HTTPリクエストが失敗しました: %d"), Timing.ResponseCode);
+        Request.NotifyFailure(Timing);
+        return;
+    }
+
+    // バイナリの応答はコピーせずに受信バッファをそのまま渡す
+    if (Request.OnBinaryComplete)
+    {
+        Request.OnBinaryComplete(true, TConstArrayView<uint8>(Response->GetContent()), Timing);
+        return;
+    }
+
+    if (!Request.OnComplete)
+    {
+        return;
+    }
+
+    // 小さな応答はその場で解析する
+    if (Response->GetContent().Num() < OffThreadDecodeThreshold)
+    {
+        TSharedPtr<FJsonObject> JsonResponse;
+        const bool bSuccess = DecodeJsonResponse(Response->GetContent(), Request.OnDecode, JsonResponse);
+        Timing.DecodeSeconds = FPlatformTime::Seconds() - CompleteTime;
+        Timing.TotalSeconds += Timing.DecodeSeconds;
+        Request.OnComplete(bSuccess, JsonResponse, Timing);
+        return;
+    }
+
+    // 大きな応答はワーカースレッドで解析し、完了の通知だけをゲームスレッドに戻す
+    const double EnqueueTime = Request.EnqueueTime;
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+        [Response, Timing, EnqueueTime, OnComplete = Request.OnComplete, OnDecode = Request.OnDecode]() mutable
+        {
+            const double DecodeStartTime = FPlatformTime::Seconds();
+            TSharedPtr<FJsonObject> JsonResponse;
+            const bool bSuccess = DecodeJsonResponse(Response->GetContent(), OnDecode, JsonResponse);
+            Timing.DecodeSeconds = FPlatformTime::Seconds() - DecodeStartTime;
+
+            // 解析済みのDOMはこのタスクからゲームスレッドのタスクに移し、同時に参照されないようにする
+            AsyncTask(ENamedThreads::GameThread,
+                [bSuccess, JsonResponse = MoveTemp(JsonResponse), Timing, EnqueueTime, OnComplete = MoveTemp(OnComplete)]() mutable
+                {
+                    Timing.TotalSeconds = FPlatformTime::Seconds() - EnqueueTime;
+                    OnComplete(bSuccess, JsonResponse, Timing);
+                });
+        });
+}
+
+void FMCPHttpTransport::RecordRequest(const FPendingRequest& Request, const FMCPRequestTiming& Timing, bool bSuccess, TConstArrayView<uint8> Content) const
+{
+    if (!Recorder.IsValid())
+    {
+        return;
+    }
+
+    const EMCPRecordedRequestKind Kind = Request.Verb == TEXT("POST") ? EMCPRecordedRequestKind::Post
+        : (Request.OnBinaryComplete ? EMCPRecordedRequestKind::GetBinary : EMCPRecordedRequestKind::Get);
+    Recorder->Record(Kind, Request.URL, Request.Payload, Request.EnqueueTime, Timing, bSuccess, Content);
+}
+
+bool FMCPHttpTransport::DecodeJsonResponse(TConstArrayView<uint8> Content, const FOnDecodeResponse& OnDecode, TSharedPtr<FJsonObject>& OutResponse)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPResponseParse);
+    TRACE_CPUPROFILER_EVENT_SCOPE(MCP::ParseResponse);
+
+    // UTF-8のまま読み取り、TCHARの文字列には変換しない
+    const FUtf8StringView ContentView(reinterpret_cast<const UTF8CHAR*>(Content.GetData()), Content.Num());
+    TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(ContentView);
+    if (!FJsonSerializer::Deserialize(Reader, OutResponse) || !OutResponse.IsValid())
+    {
+        // 失敗した場合のみ、先頭部分を変換してログに出力する
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), FMath::Min(Content.Num(), 1024));
+        UE_LOG(LogTemp, Error, TEXT("JSONのパースに失敗しました: %s"), *FString(Converted.Length(), Converted.Get()));
+        OutResponse.Reset();
+        return false;
+    }
+
+    if (OnDecode && !OnDecode(OutResponse))
+    {
+        UE_LOG(LogTemp, Error, TEXT("応答の変換に失敗しました"));
+        return false;
+    }
+
+    return true;
+}
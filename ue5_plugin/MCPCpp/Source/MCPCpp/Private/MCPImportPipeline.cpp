@@ -0,0 +1,121 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPImportPipeline.h"
+
+TSharedRef<FMCPImportPipeline> FMCPImportPipeline::Start(UMCPAssetManager* AssetManager, const TArray<FString>& ModelPaths,
+                                                         const FString& DestinationPath, int32 Parallelism,
+                                                         FOnProgress OnProgress, FOnComplete OnComplete)
+{
+    TSharedRef<FMCPImportPipeline> Pipeline = MakeShareable(new FMCPImportPipeline(
+        AssetManager, ModelPaths, DestinationPath, Parallelism, MoveTemp(OnProgress), MoveTemp(OnComplete)));
+
+    UE_LOG(LogTemp, Log, TEXT("インポートパイプラインを開始します: %d 件 (同時実行数 %d)"), Pipeline->GetTotalCount(), Pipeline->Parallelism);
+
+    Pipeline->Pump();
+    Pipeline->NotifyIfComplete();
+    return Pipeline;
+}
+
+FMCPImportPipeline::FMCPImportPipeline(UMCPAssetManager* InAssetManager, const TArray<FString>& InModelPaths, const FString& InDestinationPath,
+                                       int32 InParallelism, FOnProgress InOnProgress, FOnComplete InOnComplete)
+    : AssetManager(InAssetManager)
+    , ModelPaths(InModelPaths)
+    , DestinationPath(InDestinationPath)
+    , Parallelism(FMath::Max(InParallelism, 1))
+    , OnProgress(MoveTemp(InOnProgress))
+    , OnComplete(MoveTemp(InOnComplete))
+    , NextIndex(0)
+    , InFlightCount(0)
+    , CompletedCount(0)
+    , bCompleteNotified(false)
+    , bPumping(false)
+{
+    Results.SetNum(ModelPaths.Num());
+}
+
+void FMCPImportPipeline::Cancel()
+{
+    // 未送信のファイルを失敗として集計する（インポート中のファイルは完了を待つ）
+    while (NextIndex < ModelPaths.Num())
+    {
+        const int32 Index = NextIndex++;
+        FMCPAssetImportResult Result;
+        Result.ErrorMessage = FString::Printf(TEXT("インポートは取り消されました: %s"), *ModelPaths[Index]);
+        Results[Index] = Result;
+        CompletedCount++;
+    }
+
+    NotifyIfComplete();
+}
+
+void FMCPImportPipeline::Pump()
+{
+    if (bPumping)
+    {
+        return;
+    }
+
+    TGuardValue<bool> PumpGuard(bPumping, true);
+
+    while (InFlightCount < Parallelism && NextIndex < ModelPaths.Num())
+    {
+        const int32 Index = NextIndex++;
+
+        UMCPAssetManager* Manager = AssetManager.Get();
+        if (!Manager)
+        {
+            FMCPAssetImportResult Result;
+            Result.ErrorMessage = TEXT("MCPアセットマネージャーが破棄されました");
+            HandleImportComplete(Index, Result);
+            continue;
+        }
+
+        InFlightCount++;
+
+        // 完了コールバックがパイプラインを保持するため、全件完了まで破棄されない
+        TSharedRef<FMCPImportPipeline> Self = AsShared();
+        Manager->ImportBlenderModel(ModelPaths[Index], DestinationPath,
+            [Self, Index](const FMCPAssetImportResult& Result)
+            {
+                Self->InFlightCount--;
+                Self->HandleImportComplete(Index, Result);
+            });
+    }
+}
+
+void FMCPImportPipeline::HandleImportComplete(int32 Index, const FMCPAssetImportResult& Result)
+{
+    Results[Index] = Result;
+    CompletedCount++;
+
+    if (OnProgress)
+    {
+        OnProgress(CompletedCount, ModelPaths.Num(), Result);
+    }
+
+    Pump();
+    NotifyIfComplete();
+}
+
+void FMCPImportPipeline::NotifyIfComplete()
+{
+    if (bCompleteNotified || bPumping || CompletedCount < ModelPaths.Num())
+    {
+        return;
+    }
+
+    bCompleteNotified = true;
+
+    int32 SucceededCount = 0;
+    for (const FMCPAssetImportResult& Result : Results)
+    {
+        SucceededCount += Result.bSuccess ? 1 : 0;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("インポートパイプラインが完了しました: 成功 %d / %d 件"), SucceededCount, ModelPaths.Num());
+
+    if (OnComplete)
+    {
+        OnComplete(Results);
+    }
+}
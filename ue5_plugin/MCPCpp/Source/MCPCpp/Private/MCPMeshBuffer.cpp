@@ -0,0 +1,200 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPMeshBuffer.h"
+#include "MCPStats.h"
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshOperations.h"
+
+namespace
+{
+    /** バッファの先頭の識別子 */
+    const uint32 MeshBufferMagic = 'M' | ('C' << 8) | ('P' << 16) | ('M' << 24);
+
+    /** バッファのヘッダー */
+    struct FMeshBufferHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 TotalBytes;
+        uint32 VertexCount;
+        uint32 IndexCount;
+        uint32 Flags;
+    };
+
+    /**
+     * バッファの指定位置から要素の配列のビューを取り出す
+     *
+     * @return 範囲内に収まっていたかどうか
+     */
+    template <typename ElementType>
+    bool ReadSection(TConstArrayView<uint8> Buffer, uint64& Offset, uint32 Count, TConstArrayView<ElementType>& OutSection)
+    {
+        const uint64 SectionBytes = static_cast<uint64>(Count) * sizeof(ElementType);
+        if (Offset + SectionBytes > static_cast<uint64>(Buffer.Num()))
+        {
+            return false;
+        }
+
+        OutSection = TConstArrayView<ElementType>(reinterpret_cast<const ElementType*>(Buffer.GetData() + Offset), Count);
+        Offset += SectionBytes;
+        return true;
+    }
+}
+
+bool FMCPMeshBufferView::Parse(TConstArrayView<uint8> Buffer, FMCPMeshBufferView& OutView, FString& OutError)
+{
+    OutView = FMCPMeshBufferView();
+
+    if (Buffer.Num() < static_cast<int32>(sizeof(FMeshBufferHeader)))
+    {
+        OutError = TEXT("メッシュバッファのサイズが不足しています");
+        return false;
+    }
+
+    // 各セクションをコピーせずに参照するため、先頭が4バイト境界にあることを確認する
+    if (!IsAligned(Buffer.GetData(), alignof(float)))
+    {
+        OutError = TEXT("メッシュバッファの配置が4バイト境界ではありません");
+        return false;
+    }
+
+    const FMeshBufferHeader& Header = *reinterpret_cast<const FMeshBufferHeader*>(Buffer.GetData());
+    if (Header.Magic != MeshBufferMagic)
+    {
+        OutError = TEXT("メッシュバッファの形式が不正です");
+        return false;
+    }
+
+    if (Header.Version != FormatVersion)
+    {
+        OutError = FString::Printf(TEXT("メッシュバッファの版に対応していません: %u"), Header.Version);
+        return false;
+    }
+
+    if (Header.TotalBytes != static_cast<uint32>(Buffer.Num()))
+    {
+        OutError = FString::Printf(TEXT("メッシュバッファのサイズが一致しません: %u / %d"), Header.TotalBytes, Buffer.Num());
+        return false;
+    }
+
+    if (Header.VertexCount == 0 || Header.IndexCount == 0 || Header.IndexCount % 3 != 0)
+    {
+        OutError = FString::Printf(TEXT("メッシュバッファの頂点数またはインデックス数が不正です: %u / %u"), Header.VertexCount, Header.IndexCount);
+        return false;
+    }
+
+    uint64 Offset = sizeof(FMeshBufferHeader);
+    bool bInRange = ReadSection(Buffer, Offset, Header.VertexCount, OutView.Positions);
+    if (bInRange && (Header.Flags & Normals))
+    {
+        bInRange = ReadSection(Buffer, Offset, Header.VertexCount, OutView.Normals);
+    }
+    if (bInRange && (Header.Flags & UVs))
+    {
+        bInRange = ReadSection(Buffer, Offset, Header.VertexCount, OutView.UVs);
+    }
+    bInRange = bInRange && ReadSection(Buffer, Offset, Header.IndexCount, OutView.Indices);
+
+    if (!bInRange)
+    {
+        OutError = TEXT("メッシュバッファのセクションが範囲外です");
+        return false;
+    }
+
+    for (const uint32 Index : OutView.Indices)
+    {
+        if (Index >= Header.VertexCount)
+        {
+            OutError = FString::Printf(TEXT("メッシュバッファのインデックスが範囲外です: %u"), Index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+UStaticMesh* FMCPMeshBufferView::BuildStaticMesh(const FMCPMeshBufferView& View, UObject* Outer, FName MeshName)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMCPMeshBufferView::BuildStaticMesh);
+
+    const int32 VertexCount = View.Positions.Num();
+    const int32 IndexCount = View.Indices.Num();
+    if (VertexCount == 0 || IndexCount == 0)
+    {
+        return nullptr;
+    }
+
+    FMeshDescription MeshDescription;
+    FStaticMeshAttributes Attributes(MeshDescription);
+    Attributes.Register();
+
+    MeshDescription.ReserveNewVertices(VertexCount);
+    MeshDescription.ReserveNewVertexInstances(IndexCount);
+    MeshDescription.ReserveNewTriangles(IndexCount / 3);
+    MeshDescription.ReserveNewPolygonGroups(1);
+
+    const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+    Attributes.GetPolygonGroupMaterialSlotNames()[PolygonGroup] = NAME_None;
+
+    // 頂点の位置はバッファから直接書き込む
+    TVertexAttributesRef<FVector3f> VertexPositions = Attributes.GetVertexPositions();
+    for (int32 VertexIndex = 0; VertexIndex < VertexCount; ++VertexIndex)
+    {
+        const FVertexID VertexID = MeshDescription.CreateVertex();
+        VertexPositions[VertexID] = View.Positions[VertexIndex];
+    }
+
+    // 三角形ごとに頂点インスタンスを作成し、法線とUVを設定する
+    TVertexInstanceAttributesRef<FVector3f> InstanceNormals = Attributes.GetVertexInstanceNormals();
+    TVertexInstanceAttributesRef<FVector2f> InstanceUVs = Attributes.GetVertexInstanceUVs();
+    const bool bHasNormals = View.Normals.Num() == VertexCount;
+    const bool bHasUVs = View.UVs.Num() == VertexCount;
+
+    TArray<FVertexInstanceID, TInlineAllocator<3>> TriangleInstances;
+    for (int32 Corner = 0; Corner < IndexCount; Corner += 3)
+    {
+        TriangleInstances.Reset();
+        for (int32 CornerOffset = 0; CornerOffset < 3; ++CornerOffset)
+        {
+            const uint32 VertexIndex = View.Indices[Corner + CornerOffset];
+            const FVertexInstanceID InstanceID = MeshDescription.CreateVertexInstance(FVertexID(VertexIndex));
+            if (bHasNormals)
+            {
+                InstanceNormals[InstanceID] = View.Normals[VertexIndex];
+            }
+            if (bHasUVs)
+            {
+                InstanceUVs[InstanceID] = View.UVs[VertexIndex];
+            }
+            TriangleInstances.Add(InstanceID);
+        }
+
+        MeshDescription.CreateTriangle(PolygonGroup, TriangleInstances);
+    }
+
+    // 接線は常に計算し、法線はバッファに含まれていない場合のみ計算する
+    FStaticMeshOperations::ComputeTriangleTangentsAndNormals(MeshDescription);
+    FStaticMeshOperations::ComputeTangentsAndNormals(MeshDescription,
+        bHasNormals ? EComputeNTBsFlags::Tangents : (EComputeNTBsFlags::Normals | EComputeNTBsFlags::Tangents));
+
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(Outer ? Outer : GetTransientPackage(), MeshName, RF_Transient);
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial());
+
+    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+    BuildParams.bBuildSimpleCollision = true;
+    BuildParams.bFastBuild = true;
+
+    TArray<const FMeshDescription*> MeshDescriptions;
+    MeshDescriptions.Add(&MeshDescription);
+    if (!StaticMesh->BuildFromMeshDescriptions(MeshDescriptions, BuildParams))
+    {
+        UE_LOG(LogTemp, Error, TEXT("メッシュバッファからスタティックメッシュを作成できませんでした: %s"), *MeshName.ToString());
+        return nullptr;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("メッシュバッファからスタティックメッシュを作成しました: %s (頂点 %d / 三角形 %d)"),
+           *MeshName.ToString(), VertexCount, IndexCount / 3);
+    return StaticMesh;
+}
@@ -0,0 +1,175 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPStats.h"
+#include "MCPHttpTransport.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_MCPRequestSend);
+DEFINE_STAT(STAT_MCPResponseParse);
+DEFINE_STAT(STAT_MCPImportBlenderModel);
+DEFINE_STAT(STAT_MCPPlaceAsset);
+DEFINE_STAT(STAT_MCPRequestsInFlight);
+DEFINE_STAT(STAT_MCPRequestsQueued);
+DEFINE_STAT(STAT_MCPRequestsCompleted);
+DEFINE_STAT(STAT_MCPBytesSent);
+DEFINE_STAT(STAT_MCPBytesReceived);
+
+UE_TRACE_CHANNEL_DEFINE(MCPChannel)
+
+UE_TRACE_EVENT_BEGIN(MCP, RequestComplete)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(float, QueueMs)
+    UE_TRACE_EVENT_FIELD(float, ServerMs)
+    UE_TRACE_EVENT_FIELD(float, TotalMs)
+    UE_TRACE_EVENT_FIELD(uint32, BytesSent)
+    UE_TRACE_EVENT_FIELD(uint32, BytesReceived)
+    UE_TRACE_EVENT_FIELD(uint16, InFlight)
+    UE_TRACE_EVENT_FIELD(uint16, ResponseCode)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_INT_COUNTER(MCPRequestsInFlight, TEXT("MCP/RequestsInFlight"));
+TRACE_DECLARE_INT_COUNTER(MCPRequestsQueued, TEXT("MCP/RequestsQueued"));
+TRACE_DECLARE_INT_COUNTER(MCPBytesSent, TEXT("MCP/BytesSent"));
+TRACE_DECLARE_INT_COUNTER(MCPBytesReceived, TEXT("MCP/BytesReceived"));
+
+namespace
+{
+    /** リクエストの所要時間のヒストグラム（ゲームスレッドからのみ更新する） */
+    FMCPLatencyHistogram LatencyHistogram;
+
+    /** ヒストグラムをログに出力するコンソールコマンド */
+    FAutoConsoleCommand DumpRequestStatsCommand(
+        TEXT("MCP.DumpRequestStats"),
+        TEXT("MCPリクエストの所要時間のヒストグラムをログに出力します"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            const FMCPLatencyHistogram& Histogram = MCPStats::GetLatencyHistogram();
+            if (Histogram.Count == 0)
+            {
+                UE_LOG(LogTemp, Log, TEXT("MCPリクエストはまだ記録されていません"));
+                return;
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("MCPリクエスト: %u 件 / 平均 %.2fms / p50 %.0fms / p95 %.0fms / p99 %.0fms / 最大 %.2fms"),
+                   Histogram.Count, Histogram.TotalSeconds * 1000.0 / Histogram.Count,
+                   Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.95), Histogram.GetPercentileMs(0.99),
+                   Histogram.MaxSeconds * 1000.0);
+
+            for (int32 BucketIndex = 0; BucketIndex < FMCPLatencyHistogram::NumBuckets; ++BucketIndex)
+            {
+                if (Histogram.Buckets[BucketIndex] == 0)
+                {
+                    continue;
+                }
+
+                if (BucketIndex == FMCPLatencyHistogram::NumBuckets - 1)
+                {
+                    UE_LOG(LogTemp, Log, TEXT("  >= %6.0fms : %u"), FMCPLatencyHistogram::GetBucketUpperBoundMs(BucketIndex - 1), Histogram.Buckets[BucketIndex]);
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Log, TEXT("  <  %6.0fms : %u"), FMCPLatencyHistogram::GetBucketUpperBoundMs(BucketIndex), Histogram.Buckets[BucketIndex]);
+                }
+            }
+        }));
+
+    /** ヒストグラムを消去するコンソールコマンド */
+    FAutoConsoleCommand ResetRequestStatsCommand(
+        TEXT("MCP.ResetRequestStats"),
+        TEXT("MCPリクエストの所要時間のヒストグラムを消去します"),
+        FConsoleCommandDelegate::CreateStatic(&MCPStats::ResetLatencyHistogram));
+}
+
+void FMCPLatencyHistogram::Add(double Seconds)
+{
+    const double Milliseconds = Seconds * 1000.0;
+
+    int32 BucketIndex = 0;
+    while (BucketIndex < NumBuckets - 1 && Milliseconds >= GetBucketUpperBoundMs(BucketIndex))
+    {
+        BucketIndex++;
+    }
+
+    Buckets[BucketIndex]++;
+    Count++;
+    TotalSeconds += Seconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FMCPLatencyHistogram::Reset()
+{
+    *this = FMCPLatencyHistogram();
+}
+
+double FMCPLatencyHistogram::GetBucketUpperBoundMs(int32 BucketIndex)
+{
+    return static_cast<double>(1 << FMath::Clamp(BucketIndex, 0, NumBuckets - 2));
+}
+
+double FMCPLatencyHistogram::GetPercentileMs(double Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const uint32 Target = FMath::Max<uint32>(1, FMath::CeilToInt(Percentile * Count));
+    uint32 Accumulated = 0;
+    for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; ++BucketIndex)
+    {
+        Accumulated += Buckets[BucketIndex];
+        if (Accumulated >= Target)
+        {
+            return GetBucketUpperBoundMs(BucketIndex);
+        }
+    }
+
+    // 最後のバケットは上限がないため最大値を返す
+    return MaxSeconds * 1000.0;
+}
+
+namespace MCPStats
+{
+    void RecordRequestComplete(const FMCPRequestTiming& Timing, int32 BytesSent, int32 BytesReceived, int32 InFlightCount, int32 QueuedCount)
+    {
+        LatencyHistogram.Add(Timing.TotalSeconds);
+
+        INC_DWORD_STAT(STAT_MCPRequestsCompleted);
+        INC_DWORD_STAT_BY(STAT_MCPBytesSent, BytesSent);
+        INC_DWORD_STAT_BY(STAT_MCPBytesReceived, BytesReceived);
+        RecordQueueDepth(InFlightCount, QueuedCount);
+
+        TRACE_COUNTER_ADD(MCPBytesSent, BytesSent);
+        TRACE_COUNTER_ADD(MCPBytesReceived, BytesReceived);
+
+        UE_TRACE_LOG(MCP, RequestComplete, MCPChannel)
+            << RequestComplete.Cycle(FPlatformTime::Cycles64())
+            << RequestComplete.QueueMs(static_cast<float>(Timing.QueueSeconds * 1000.0))
+            << RequestComplete.ServerMs(static_cast<float>(Timing.ServerSeconds * 1000.0))
+            << RequestComplete.TotalMs(static_cast<float>(Timing.TotalSeconds * 1000.0))
+            << RequestComplete.BytesSent(static_cast<uint32>(BytesSent))
+            << RequestComplete.BytesReceived(static_cast<uint32>(BytesReceived))
+            << RequestComplete.InFlight(static_cast<uint16>(FMath::Min(InFlightCount, 0xFFFF)))
+            << RequestComplete.ResponseCode(static_cast<uint16>(Timing.ResponseCode));
+    }
+
+    void RecordQueueDepth(int32 InFlightCount, int32 QueuedCount)
+    {
+        SET_DWORD_STAT(STAT_MCPRequestsInFlight, InFlightCount);
+        SET_DWORD_STAT(STAT_MCPRequestsQueued, QueuedCount);
+
+        TRACE_COUNTER_SET(MCPRequestsInFlight, InFlightCount);
+        TRACE_COUNTER_SET(MCPRequestsQueued, QueuedCount);
+    }
+
+    const FMCPLatencyHistogram& GetLatencyHistogram()
+    {
+        return LatencyHistogram;
+    }
+
+    void ResetLatencyHistogram()
+    {
+        LatencyHistogram.Reset();
+    }
+}
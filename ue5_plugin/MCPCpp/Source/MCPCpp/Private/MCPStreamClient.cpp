@@ -0,0 +1,340 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPStreamClient.h"
+#include "MCPStats.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    /** 再接続の待ち時間の初期値（秒） */
+    const float InitialReconnectDelay = 1.0f;
+
+    /** 再接続の待ち時間の上限（秒） */
+    const float MaxReconnectDelay = 10.0f;
+}
+
+FMCPStreamClient::FMCPStreamClient()
+    : NextCorrelationId(1)
+    , bConnected(false)
+    , bShouldReconnect(false)
+    , ReconnectDelay(InitialReconnectDelay)
+{
+}
+
+FMCPStreamClient::~FMCPStreamClient()
+{
+    Disconnect();
+}
+
+void FMCPStreamClient::Connect(const FString& InURL)
+{
+    if (Socket.IsValid() && URL == InURL)
+    {
+        return;
+    }
+
+    CancelReconnect();
+    CloseSocket();
+
+    // 接続先を変える場合、送信済みのコマンドは失敗とし、未送信のものは新しい接続で送信する
+    URL = InURL;
+    bShouldReconnect = true;
+    ReconnectDelay = InitialReconnectDelay;
+    HandleDisconnected(TEXT("接続先を変更しました"));
+
+    OpenSocket();
+}
+
+void FMCPStreamClient::Disconnect()
+{
+    bShouldReconnect = false;
+
+    CancelReconnect();
+    CloseSocket();
+
+    HandleDisconnected(TEXT("切断しました"));
+}
+
+void FMCPStreamClient::CloseSocket()
+{
+    if (Socket.IsValid())
+    {
+        // 自分で閉じる場合は切断イベントを受け取らない
+        TSharedPtr<IWebSocket> ClosingSocket = MoveTemp(Socket);
+        ClosingSocket->OnConnected().Clear();
+        ClosingSocket->OnConnectionError().Clear();
+        ClosingSocket->OnClosed().Clear();
+        ClosingSocket->OnMessage().Clear();
+        ClosingSocket->Close();
+    }
+}
+
+void FMCPStreamClient::CancelReconnect()
+{
+    if (ReconnectHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+        ReconnectHandle.Reset();
+    }
+}
+
+int64 FMCPStreamClient::SendCommand(const FString& Target, const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                                    FMCPHttpTransport::FOnRequestComplete OnComplete)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MCPRequestSend);
+    TRACE_CPUPROFILER_EVENT_SCOPE(FMCPStreamClient::SendCommand);
+
+    const int64 CorrelationId = NextCorrelationId++;
+
+    TSharedRef<FJsonObject> MessageObj = MakeShared<FJsonObject>();
+    MessageObj->SetStringField(TEXT("type"), TEXT("command"));
+    MessageObj->SetNumberField(TEXT("id"), static_cast<double>(CorrelationId));
+    MessageObj->SetStringField(TEXT("target"), Target);
+    MessageObj->SetStringField(TEXT("command"), Command);
+    MessageObj->SetObjectField(TEXT("params"), Params.IsValid() ? Params : MakeShared<FJsonObject>());
+
+    FString Payload;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Payload);
+    FJsonSerializer::Serialize(MessageObj, Writer);
+
+    FPendingCommand& PendingCommand = PendingCommands.Add(CorrelationId);
+    PendingCommand.OnComplete = MoveTemp(OnComplete);
+    PendingCommand.EnqueueTime = FPlatformTime::Seconds();
+    PendingCommand.PayloadBytes = Payload.Len();
+
+    if (bConnected && Socket.IsValid())
+    {
+        PendingCommand.SendTime = PendingCommand.EnqueueTime;
+        Socket->Send(Payload);
+    }
+    else
+    {
+        // 接続が確立したら送信する
+        FOutgoingMessage& Outgoing = OutgoingMessages.AddDefaulted_GetRef();
+        Outgoing.CorrelationId = CorrelationId;
+        Outgoing.Payload = MoveTemp(Payload);
+    }
+
+    return CorrelationId;
+}
+
+void FMCPStreamClient::OpenSocket()
+{
+    FWebSocketsModule& WebSocketsModule = FModuleManager::LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets"));
+    Socket = WebSocketsModule.CreateWebSocket(URL);
+
+    TWeakPtr<FMCPStreamClient> WeakThis = AsShared();
+    Socket->OnConnected().AddLambda([WeakThis]()
+    {
+        if (TSharedPtr<FMCPStreamClient> This = WeakThis.Pin())
+        {
+            This->HandleConnected();
+        }
+    });
+    Socket->OnConnectionError().AddLambda([WeakThis](const FString& Error)
+    {
+        if (TSharedPtr<FMCPStreamClient> This = WeakThis.Pin())
+        {
+            This->HandleConnectionError(Error);
+        }
+    });
+    Socket->OnClosed().AddLambda([WeakThis](int32 StatusCode, const FString& Reason, bool bWasClean)
+    {
+        if (TSharedPtr<FMCPStreamClient> This = WeakThis.Pin())
+        {
+            This->HandleClosed(StatusCode, Reason, bWasClean);
+        }
+    });
+    Socket->OnMessage().AddLambda([WeakThis](const FString& Message)
+    {
+        if (TSharedPtr<FMCPStreamClient> This = WeakThis.Pin())
+        {
+            This->HandleMessage(Message);
+        }
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("MCPストリーミング接続を開始します: %s"), *URL);
+    Socket->Connect();
+}
+
+void FMCPStreamClient::HandleConnected()
+{
+    bConnected = true;
+    ReconnectDelay = InitialReconnectDelay;
+
+    UE_LOG(LogTemp, Log, TEXT("MCPストリーミング接続を確立しました: %s"), *URL);
+
+    FlushOutgoing();
+    ConnectionChanged.Broadcast(true);
+}
+
+void FMCPStreamClient::HandleConnectionError(const FString& Error)
+{
+    UE_LOG(LogTemp, Warning, TEXT("MCPストリーミング接続に失敗しました: %s"), *Error);
+
+    // ソケットはコールバック中に破棄せず、再接続時に作り直す
+    HandleDisconnected(Error);
+    ScheduleReconnect();
+}
+
+void FMCPStreamClient::HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
+{
+    UE_LOG(LogTemp, Log, TEXT("MCPストリーミング接続が閉じられました: %d %s"), StatusCode, *Reason);
+
+    HandleDisconnected(Reason);
+    ScheduleReconnect();
+}
+
+void FMCPStreamClient::HandleMessage(const FString& Message)
+{
+    TSharedPtr<FJsonObject> MessageObj;
+    {
+        SCOPE_CYCLE_COUNTER(STAT_MCPResponseParse);
+        TRACE_CPUPROFILER_EVENT_SCOPE(FMCPStreamClient::ParseMessage);
+
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+        if (!FJsonSerializer::Deserialize(Reader, MessageObj) || !MessageObj.IsValid())
+        {
+            UE_LOG(LogTemp, Error, TEXT("JSONのパースに失敗しました: %s"), *Message);
+            return;
+        }
+    }
+
+    const FString Type = MessageObj->GetStringField(TEXT("type"));
+
+    // サーバーからのイベント
+    if (Type == TEXT("event"))
+    {
+        const FString EventName = MessageObj->GetStringField(TEXT("event"));
+        const TSharedPtr<FJsonObject>* DataObj = nullptr;
+        MessageObj->TryGetObjectField(TEXT("data"), DataObj);
+
+        UE_LOG(LogTemp, Verbose, TEXT("MCPサーバーイベントを受信しました: %s"), *EventName);
+        ServerEvent.Broadcast(EventName, DataObj ? *DataObj : MakeShared<FJsonObject>());
+        return;
+    }
+
+    // コマンドの応答（相関IDで対応付ける）
+    if (Type == TEXT("response"))
+    {
+        int64 CorrelationId = 0;
+        if (!MessageObj->TryGetNumberField(TEXT("id"), CorrelationId))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("相関IDのない応答を受信しました"));
+            return;
+        }
+
+        FPendingCommand PendingCommand;
+        if (!PendingCommands.RemoveAndCopyValue(CorrelationId, PendingCommand))
+        {
+            return;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        FMCPRequestTiming Timing;
+        Timing.QueueSeconds = PendingCommand.SendTime - PendingCommand.EnqueueTime;
+        Timing.ServerSeconds = Now - PendingCommand.SendTime;
+        Timing.TotalSeconds = Now - PendingCommand.EnqueueTime;
+        Timing.ResponseCode = EHttpResponseCodes::Ok;
+        MCPStats::RecordRequestComplete(Timing, PendingCommand.PayloadBytes, Message.Len(), PendingCommands.Num(), OutgoingMessages.Num());
+
+        const bool bSuccess = MessageObj->GetStringField(TEXT("status")) == TEXT("success");
+        if (PendingCommand.OnComplete)
+        {
+            PendingCommand.OnComplete(bSuccess, MessageObj, Timing);
+        }
+    }
+}
+
+void FMCPStreamClient::HandleDisconnected(const FString& Reason)
+{
+    const bool bWasConnected = bConnected;
+    bConnected = false;
+
+    FailAllPending();
+
+    if (bWasConnected)
+    {
+        ConnectionChanged.Broadcast(false);
+    }
+}
+
+void FMCPStreamClient::FlushOutgoing()
+{
+    if (!Socket.IsValid())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (FOutgoingMessage& Outgoing : OutgoingMessages)
+    {
+        if (FPendingCommand* PendingCommand = PendingCommands.Find(Outgoing.CorrelationId))
+        {
+            PendingCommand->SendTime = Now;
+            Socket->Send(Outgoing.Payload);
+        }
+    }
+    OutgoingMessages.Reset();
+}
+
+void FMCPStreamClient::FailAllPending()
+{
+    // 送信済みのコマンドは応答が届かないため失敗とする（未送信のものは再接続後に送信する）
+    TArray<int64> SentIds;
+    for (const TPair<int64, FPendingCommand>& Pair : PendingCommands)
+    {
+        if (Pair.Value.SendTime > 0.0)
+        {
+            SentIds.Add(Pair.Key);
+        }
+    }
+
+    if (!bShouldReconnect)
+    {
+        OutgoingMessages.Reset();
+        PendingCommands.GenerateKeyArray(SentIds);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (int64 CorrelationId : SentIds)
+    {
+        FPendingCommand PendingCommand;
+        if (PendingCommands.RemoveAndCopyValue(CorrelationId, PendingCommand) && PendingCommand.OnComplete)
+        {
+            FMCPRequestTiming Timing;
+            Timing.TotalSeconds = Now - PendingCommand.EnqueueTime;
+            PendingCommand.OnComplete(false, nullptr, Timing);
+        }
+    }
+}
+
+void FMCPStreamClient::ScheduleReconnect()
+{
+    if (!bShouldReconnect || ReconnectHandle.IsValid())
+    {
+        return;
+    }
+
+    const float Delay = ReconnectDelay;
+    ReconnectDelay = FMath::Min(ReconnectDelay * 2.0f, MaxReconnectDelay);
+
+    TWeakPtr<FMCPStreamClient> WeakThis = AsShared();
+    ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakThis](float DeltaTime)
+        {
+            if (TSharedPtr<FMCPStreamClient> This = WeakThis.Pin())
+            {
+                This->ReconnectHandle.Reset();
+                if (This->bShouldReconnect && !This->bConnected)
+                {
+                    This->OpenSocket();
+                }
+            }
+            return false;
+        }), Delay);
+}
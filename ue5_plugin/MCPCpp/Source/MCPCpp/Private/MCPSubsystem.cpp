@@ -0,0 +1,50 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+void UMCPSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    
+    // アセットマネージャーは最初に使われる時に取得する（ゲームの起動時には何もしない）
+    AssetManager = nullptr;
+}
+
+void UMCPSubsystem::Deinitialize()
+{
+    AssetManager = nullptr;
+    
+    Super::Deinitialize();
+}
+
+UMCPAssetManager* UMCPSubsystem::GetAssetManager()
+{
+    if (!AssetManager)
+    {
+        AssetManager = UMCPAssetManager::Get();
+        if (!AssetManager)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MCPアセットマネージャーの取得に失敗しました"));
+            return nullptr;
+        }
+        
+        // サーバー接続の確認はここで1回だけ行う（結果はアセットマネージャーが保持してログに出す）
+        AssetManager->CheckServerConnection([](bool bSuccess, const FString& Message) {});
+    }
+    
+    return AssetManager;
+}
+
+UMCPSubsystem* UMCPSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    return GameInstance ? GameInstance->GetSubsystem<UMCPSubsystem>() : nullptr;
+}
+
+bool UMCPSubsystem::IsServerConnected() const
+{
+    return AssetManager && AssetManager->IsServerHealthy();
+}
@@ -0,0 +1,320 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "MCPAssetManager.h"
+
+/** ジョブの1ステップの種類 */
+enum class EMCPAssetJobStepType : uint8
+{
+    /** MCPサーバー経由でBlenderのコマンドを実行する（生成・エクスポート） */
+    BlenderCommand,
+
+    /** エクスポートされたモデルをUE5にインポートする */
+    ImportModel,
+
+    /** UE側の後処理をワーカースレッドで実行する（UE::Tasks） */
+    PostProcess,
+};
+
+/** ジョブの1ステップの状態 */
+enum class EMCPAssetJobStepStatus : uint8
+{
+    /** 依存するステップの完了を待っている（再試行の待機中を含む） */
+    Pending,
+
+    /** 実行中 */
+    Running,
+
+    /** 成功した */
+    Succeeded,
+
+    /** 再試行しても失敗した */
+    Failed,
+
+    /** ジョブの取り消しにより実行されなかった */
+    Cancelled,
+
+    /** 依存するステップが失敗したため実行されなかった */
+    Skipped,
+};
+
+/**
+ * アセットジョブの1ステップ
+ *
+ * Dependencies に指定した全てのステップが成功してから実行されます。
+ * 例えばマテリアルのインポートをメッシュのインポートの依存に、
+ * メッシュのインポートをブループリントの作成の依存に指定します。
+ */
+struct MCPCPP_API FMCPAssetJobStep
+{
+    /** ステップ名（ジョブ内で一意） */
+    FName Name;
+
+    /** ステップの種類 */
+    EMCPAssetJobStepType Type = EMCPAssetJobStepType::BlenderCommand;
+
+    /** このステップより先に成功している必要があるステップ名 */
+    TArray<FName> Dependencies;
+
+    /** Blenderのコマンド名（BlenderCommand） */
+    FString Command;
+
+    /** Blenderのコマンドのパラメータ（BlenderCommand） */
+    TSharedPtr<FJsonObject> Params;
+
+    /** インポートするモデルのパス（ImportModel） */
+    FString ModelPath;
+
+    /** UE5内の保存先パス（ImportModel） */
+    FString DestinationPath;
+
+    /**
+     * 後処理（PostProcess、ワーカースレッドで呼ばれる）
+     * UObjectの変更はゲームスレッドで行う必要があるため、ステップ完了の通知で行ってください。
+     * 失敗した場合はfalseを返し、OutErrorに理由を設定します。
+     */
+    TFunction<bool(FString& OutError)> PostProcess;
+
+    /** 失敗した場合に再試行する回数 */
+    int32 MaxRetries = 0;
+
+    /** 所要時間の見積もり（秒、クリティカルパス上のステップを優先して開始するために使う） */
+    float EstimatedSeconds = 1.0f;
+
+    /** Blenderのコマンドのステップを作成する */
+    static FMCPAssetJobStep MakeBlenderCommand(FName Name, const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                                               const TArray<FName>& Dependencies = TArray<FName>());
+
+    /** インポートのステップを作成する */
+    static FMCPAssetJobStep MakeImport(FName Name, const FString& ModelPath, const FString& DestinationPath,
+                                       const TArray<FName>& Dependencies = TArray<FName>());
+
+    /** 後処理のステップを作成する */
+    static FMCPAssetJobStep MakePostProcess(FName Name, TFunction<bool(FString& OutError)> PostProcess,
+                                            const TArray<FName>& Dependencies = TArray<FName>());
+};
+
+/**
+ * アセットジョブの1ステップの結果
+ */
+struct MCPCPP_API FMCPAssetJobStepResult
+{
+    /** ステップ名 */
+    FName Name;
+
+    /** 状態 */
+    EMCPAssetJobStepStatus Status = EMCPAssetJobStepStatus::Pending;
+
+    /** 実行した回数 */
+    int32 Attempts = 0;
+
+    /** エラーメッセージ（失敗時） */
+    FString ErrorMessage;
+
+    /** Blenderのコマンドの応答（BlenderCommand） */
+    TSharedPtr<FJsonObject> Response;
+
+    /** インポート結果（ImportModel） */
+    FMCPAssetImportResult ImportResult;
+
+    /** 最後に実行を開始してから完了するまでの時間（秒） */
+    double DurationSeconds = 0.0;
+};
+
+/**
+ * MCPアセットジョブグラフ
+ *
+ * Blenderでの生成・エクスポートとUE5へのインポート、UE側の後処理を
+ * 依存関係のグラフとして受け取り、依存しないステップを並行して実行します。
+ * Blenderのコマンドは MaxBlenderWorkers 件まで同時に送信し、
+ * それぞれに "worker" パラメータでワーカーの番号を付けるため、
+ * サーバーの後ろにある複数のBlenderに振り分けられます。
+ * 後処理は UE::Tasks のワーカースレッドで実行します。
+ * 実行可能なステップが複数ある場合は、完了までの残りの見積もりが長い
+ * （クリティカルパス上の）ステップから開始するため、全体の所要時間は
+ * クリティカルパスの長さに近づきます。
+ * 失敗したステップは MaxRetries 回まで間隔を空けて再試行し、
+ * それでも失敗した場合はそのステップに依存する全てのステップを省略します。
+ */
+class MCPCPP_API FMCPAssetJobGraph : public TSharedFromThis<FMCPAssetJobGraph>
+{
+public:
+    /** ステップ完了のコールバック（完了数、全体数、完了したステップの結果） */
+    typedef TFunction<void(int32 CompletedCount, int32 TotalCount, const FMCPAssetJobStepResult& Result)> FOnStepComplete;
+
+    /** 完了時のコールバック（結果はステップの指定順） */
+    typedef TFunction<void(const TArray<FMCPAssetJobStepResult>& Results)> FOnComplete;
+
+    /**
+     * ジョブグラフを作成して開始する
+     *
+     * ステップ名の重複、存在しない依存、循環する依存がある場合は何も実行せず、
+     * 全てのステップを失敗として完了を通知します。
+     *
+     * @param AssetManager Blenderのコマンドとインポートに使うアセットマネージャー
+     * @param Steps 実行するステップ
+     * @param MaxBlenderWorkers 同時に実行するBlenderのコマンドの最大数
+     * @param OnStepComplete 1ステップ完了するごとに呼ばれるコールバック（省略可）
+     * @param OnComplete 全て完了した時に1回だけ呼ばれるコールバック
+     * @return 開始したジョブグラフ
+     */
+    static TSharedRef<FMCPAssetJobGraph> Start(UMCPAssetManager* AssetManager, const TArray<FMCPAssetJobStep>& Steps,
+                                               int32 MaxBlenderWorkers, FOnStepComplete OnStepComplete, FOnComplete OnComplete);
+
+    /** デストラクタ */
+    ~FMCPAssetJobGraph();
+
+    /** 未実行のステップを取り消す（実行中のステップは完了を待ち、その後のステップは開始しません） */
+    void Cancel();
+
+    /** ステップの状態（存在しないステップの場合はFailed） */
+    EMCPAssetJobStepStatus GetStepStatus(FName StepName) const;
+
+    /** ステップごとの結果（ステップの指定順） */
+    const TArray<FMCPAssetJobStepResult>& GetResults() const { return Results; }
+
+    /** 完了したステップの数 */
+    int32 GetCompletedCount() const { return CompletedCount; }
+
+    /** ステップの総数 */
+    int32 GetTotalCount() const { return Steps.Num(); }
+
+    /** 全て完了したかどうか */
+    bool IsComplete() const { return bCompleteNotified; }
+
+    /** 取り消されたかどうか */
+    bool IsCancelled() const { return bCancelled; }
+
+    /** クリティカルパスの所要時間の見積もり（秒） */
+    double GetCriticalPathSeconds() const { return CriticalPathSeconds; }
+
+    /**
+     * 失敗したステップを再試行するまでの最初の待ち時間を設定する
+     *
+     * @param InRetryDelaySeconds 待ち時間（秒、再試行ごとに2倍になる）
+     */
+    void SetRetryDelay(float InRetryDelaySeconds) { RetryDelaySeconds = FMath::Max(InRetryDelaySeconds, 0.0f); }
+
+private:
+    /** コンストラクタ（Startから作成する） */
+    FMCPAssetJobGraph(UMCPAssetManager* InAssetManager, const TArray<FMCPAssetJobStep>& InSteps, int32 InMaxBlenderWorkers,
+                      FOnStepComplete InOnStepComplete, FOnComplete InOnComplete);
+
+    /**
+     * 依存関係を解決し、各ステップの優先度（クリティカルパスの残り）を求める
+     *
+     * @param OutError 失敗の理由
+     * @return グラフが有効かどうか
+     */
+    bool BuildGraph(FString& OutError);
+
+    /** 実行可能なステップを上限まで開始する */
+    void Pump();
+
+    /** 空いているBlenderのワーカーの番号（全て使用中の場合はINDEX_NONE） */
+    int32 FindFreeBlenderWorker() const;
+
+    /**
+     * ステップを開始する
+     *
+     * @param StepIndex ステップの位置
+     * @param WorkerIndex Blenderのワーカーの番号（BlenderCommand以外ではINDEX_NONE）
+     */
+    void Dispatch(int32 StepIndex, int32 WorkerIndex);
+
+    /** Blenderのコマンドのステップを実行する */
+    void RunBlenderCommand(int32 StepIndex, int32 WorkerIndex);
+
+    /** インポートのステップを実行する */
+    void RunImport(int32 StepIndex);
+
+    /** 後処理のステップを実行する */
+    void RunPostProcess(int32 StepIndex);
+
+    /**
+     * ステップの実行完了時の処理（ゲームスレッド）
+     *
+     * @param StepIndex ステップの位置
+     * @param bSuccess 成功したかどうか
+     * @param ErrorMessage エラーメッセージ（失敗時）
+     */
+    void HandleStepFinished(int32 StepIndex, bool bSuccess, const FString& ErrorMessage);
+
+    /** 失敗したステップの再試行を予約する */
+    void ScheduleRetry(int32 StepIndex);
+
+    /**
+     * ステップを完了にする（成功・失敗・取り消し・省略）
+     *
+     * @param StepIndex ステップの位置
+     * @param Status 完了時の状態
+     */
+    void CompleteStep(int32 StepIndex, EMCPAssetJobStepStatus Status);
+
+    /** 全て完了していれば完了を通知する */
+    void NotifyIfComplete();
+
+    /** Blenderのコマンドとインポートに使うアセットマネージャー */
+    TWeakObjectPtr<UMCPAssetManager> AssetManager;
+
+    /** 実行するステップ */
+    TArray<FMCPAssetJobStep> Steps;
+
+    /** ステップごとの結果 */
+    TArray<FMCPAssetJobStepResult> Results;
+
+    /** ステップごとの、このステップに依存するステップの位置 */
+    TArray<TArray<int32>> Dependents;
+
+    /** ステップごとの、まだ成功していない依存の数 */
+    TArray<int32> RemainingDependencies;
+
+    /** ステップごとの優先度（このステップから最後までの所要時間の見積もり） */
+    TArray<double> Priorities;
+
+    /** ステップごとの実行開始時刻 */
+    TArray<double> StartTimes;
+
+    /** 再試行の待機中のステップの予約 */
+    TMap<int32, FTSTicker::FDelegateHandle> RetryHandles;
+
+    /** 依存が揃って実行を待っているステップの位置 */
+    TArray<int32> ReadySteps;
+
+    /** Blenderのワーカーごとの使用中フラグ */
+    TArray<bool> BlenderWorkersBusy;
+
+    /** 進捗通知のコールバック */
+    FOnStepComplete OnStepComplete;
+
+    /** 完了時のコールバック */
+    FOnComplete OnComplete;
+
+    /** クリティカルパスの所要時間の見積もり（秒） */
+    double CriticalPathSeconds;
+
+    /** 失敗したステップを再試行するまでの最初の待ち時間（秒） */
+    float RetryDelaySeconds;
+
+    /** ジョブの開始時刻 */
+    double StartSeconds;
+
+    /** 実行中のステップの数 */
+    int32 RunningCount;
+
+    /** 完了したステップの数 */
+    int32 CompletedCount;
+
+    /** 取り消されたかどうか */
+    bool bCancelled;
+
+    /** 完了を通知済みかどうか */
+    bool bCompleteNotified;
+
+    /** Pumpの実行中かどうか（同期的に完了した場合の再入を防ぐ） */
+    bool bPumping;
+};
@@ -6,8 +6,14 @@
 #include "UObject/NoExportTypes.h"
 #include "Dom/JsonObject.h"
 #include "MCPClient.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/SecureHash.h"
 #include "MCPAssetManager.generated.h"
 
+class UStaticMesh;
+struct FAssetData;
+
 /**
  * MCPAssetManagerでのアセットインポート結果を表す構造体
  */
@@ -39,6 +45,27 @@ struct FMCPAssetImportResult
     }
 };
 
+/**
+ * 一括配置する1つのアセットとその配置先
+ */
+USTRUCT(BlueprintType)
+struct FMCPAssetPlacementBatch
+{
+    GENERATED_BODY()
+    
+    /** 配置するアセットのパス */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MCP|Asset")
+    FString AssetPath;
+    
+    /** 配置するワールド座標のトランスフォーム */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MCP|Asset")
+    TArray<FTransform> Transforms;
+    
+    /** 生成するアクターのラベル（省略可） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MCP|Asset")
+    FString ActorName;
+};
+
 /**
  * MCPアセットマネージャー
  * 
@@ -54,23 +81,60 @@ public:
     /** コンストラクタ */
     UMCPAssetManager();
     
-    /** シングルトンインスタンスを取得 */
+    /** UObjectの実装 */
+    virtual void BeginDestroy() override;
+    
+    /**
+     * シングルトンインスタンスを取得
+     * 
+     * 最初に呼ばれた時に作成し、設定の読み込みを開始します（モジュールの起動時には作成しません）。
+     */
     static UMCPAssetManager* Get();
     
     /**
      * MCPクライアントを初期化
      * 
-     * @return 初期化に成功したかどうか
+     * mcp_settings.jsonとインポートマニフェストをワーカースレッドで読み込み、
+     * ゲームスレッドで反映します。反映されるまでに呼ばれたサーバーへのリクエストと
+     * インポートは、反映後に呼ばれた順に実行されます。
+     * 
+     * @return 初期化を開始したかどうか
      */
     bool Initialize();
     
+    /** 設定の読み込みが終わり、サーバーへのリクエストを送信できるかどうか */
+    bool IsConfigured() const { return bConfigured; }
+    
+    /** サーバーの状態が変わった時のデリゲート（接続できるかどうか、メッセージ） */
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnServerHealthChanged, bool /*bHealthy*/, const FString& /*Message*/);
+    
     /**
      * サーバー接続を確認
      * 
+     * 前回の確認から一定時間（HealthCheckTTLSeconds）以内であれば、問い合わせずに前回の結果をすぐに返します。
+     * 確認中に再度呼ばれた場合は同じ確認の完了を待つため、多数の呼び出しでもリクエストは1回だけです。
+     * 
      * @param OnCompleteCallback 完了時のコールバック関数
      */
     void CheckServerConnection(TFunction<void(bool bSuccess, const FString& Message)> OnCompleteCallback);
     
+    /** 最後に確認したサーバーの状態（未確認の場合はfalse） */
+    bool IsServerHealthy() const { return ServerHealth == EServerHealth::Healthy; }
+    
+    /** 保持しているサーバーの状態を期限切れにする（次回のCheckServerConnectionで必ず問い合わせる） */
+    void InvalidateServerHealth();
+    
+    /** サーバーの状態が変わった時のデリゲート */
+    FOnServerHealthChanged& OnServerHealthChanged() { return ServerHealthChanged; }
+    
+    /**
+     * サーバーイベントのデリゲートを取得
+     * 
+     * mcp_settings.jsonでストリーミング接続を有効にした場合に、
+     * エクスポート完了やアセットの準備完了などのイベントが通知されます。
+     */
+    FMCPStreamClient::FOnServerEvent& OnServerEvent();
+    
     /**
      * Blenderモデルをインポート
      * 
@@ -81,6 +145,101 @@ public:
     void ImportBlenderModel(const FString& ModelPath, const FString& DestinationPath,
                           TFunction<void(const FMCPAssetImportResult& Result)> OnCompleteCallback);
     
+    /**
+     * 複数のBlenderモデルを1回のリクエストでインポート
+     * 
+     * @param ModelPaths Blenderモデルのパス
+     * @param DestinationPath UE5内の保存先パス
+     * @param bSaveLevel インポート後に同じリクエストでレベルを保存するかどうか
+     * @param OnCompleteCallback 完了時のコールバック関数（結果はModelPathsと同じ順）
+     */
+    void ImportBlenderModels(const TArray<FString>& ModelPaths, const FString& DestinationPath, bool bSaveLevel,
+                           TFunction<void(const TArray<FMCPAssetImportResult>& Results)> OnCompleteCallback);
+    
+    /**
+     * Blenderのコマンドを実行
+     * 
+     * モデルの生成やエクスポートなど、インポート以外のBlender側の処理に使います。
+     * 複数のステップを依存関係に沿って実行する場合はFMCPAssetJobGraphを使用してください。
+     * 
+     * @param Command 実行するコマンド
+     * @param Params コマンドのパラメータ
+     * @param OnCompleteCallback 完了時のコールバック関数
+     */
+    void ExecuteBlenderCommand(const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                             TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response)> OnCompleteCallback);
+    
+    /**
+     * 生成されたメッシュをバッファから直接作成
+     * 
+     * サーバーに登録されたメッシュのバッファを受け取り、ファイルを経由せずにUStaticMeshを作成します。
+     * 作成したメッシュはメッシュ名ごとに保持され、同じ名前で再度要求すると作り直されます。
+     * 
+     * @param MeshName サーバーに登録されたメッシュ名
+     * @param OnCompleteCallback 完了時のコールバック関数（失敗時はnullptr）
+     */
+    void ImportBlenderMeshBuffer(const FString& MeshName, TFunction<void(UStaticMesh* Mesh)> OnCompleteCallback);
+    
+    /**
+     * MCPでインポートしたアセットをソースファイルから検索する
+     * 
+     * インデックスはインポート結果とアセットレジストリのイベントで更新されるため、
+     * アセットレジストリを走査せずに検索できます。
+     * 
+     * @param ModelPath Blenderモデルのパス
+     * @param OutResult 見つかったアセット
+     * @return 見つかったかどうか
+     */
+    bool FindImportedAssetBySource(const FString& ModelPath, FMCPAssetImportResult& OutResult) const;
+    
+    /**
+     * MCPでインポートしたアセットをアセット名から検索する
+     * 
+     * 同じ名前のアセットが複数のフォルダにある場合は、最後に追加されたものを返します。
+     * 
+     * @param AssetName アセット名
+     * @param OutResult 見つかったアセット
+     * @return 見つかったかどうか
+     */
+    bool FindImportedAssetByName(FName AssetName, FMCPAssetImportResult& OutResult) const;
+    
+    /** インデックスに登録されているアセットの数 */
+    int32 GetImportedAssetCount() const { return ImportedAssets.Num(); }
+    
+    /**
+     * インポートキャッシュを消去
+     * 
+     * 次回のインポートでは全てのモデルがサーバー経由で再インポートされます。
+     */
+    void ClearImportCache();
+    
+    /**
+     * アセットを非同期でロードする
+     * 
+     * ロード済みのアセットはパスごとにキャッシュされ、2回目以降はすぐにコールバックが呼ばれます。
+     * 同じアセットのロード中に再度要求された場合は、同じロードの完了を待ちます。
+     * 
+     * @param AssetPath アセットのパス（"/Game/Path/Asset" または "/Game/Path/Asset.Asset"）
+     * @param OnResident アセットがメモリ上に存在する状態になった時に呼ばれるコールバック（失敗時はnullptr）
+     */
+    void RequestAsset(const FString& AssetPath, TFunction<void(UObject* Asset)> OnResident);
+    
+    /**
+     * ロード済みのアセットを取得する（ロードは行わない）
+     * 
+     * @param AssetPath アセットのパス
+     * @return ロード済みのアセット（未ロードの場合はnullptr）
+     */
+    UObject* FindResidentAsset(const FString& AssetPath) const;
+    
+    /**
+     * アセットパスをオブジェクトパスに変換する
+     * 
+     * @param AssetPath アセットのパス（パッケージ名のみの場合はアセット名を補う）
+     * @return オブジェクトパス
+     */
+    static FSoftObjectPath MakeAssetObjectPath(const FString& AssetPath);
+    
     /**
      * アセットをレベルに配置
      * 
@@ -95,6 +254,18 @@ public:
                          const FRotator& Rotation, const FVector& Scale,
                          const FString& ActorName = TEXT(""));
     
+    /**
+     * アセットをまとめてレベルに配置
+     * 
+     * アセットごとに1回だけロードし、スタティックメッシュは1つのアクターに
+     * 階層型インスタンススタティックメッシュとしてまとめて配置します。
+     * ブループリントはインスタンス化できないため、配置先ごとにアクターを生成します。
+     * 
+     * @param Batches アセットごとの配置先
+     * @return 配置したインスタンス（またはアクター）の数
+     */
+    int32 PlaceAssetsInLevelBatch(const TArray<FMCPAssetPlacementBatch>& Batches);
+    
     /**
      * ゲームモードを設定
      * 
@@ -103,13 +274,316 @@ public:
      */
     bool SetGameMode(TSubclassOf<AGameModeBase> GameModeClass);
     
+    /**
+     * MCPサーバーへのコマンドの記録を開始
+     * 
+     * 設定の読み込み前に呼ばれた場合は、読み込み後に開始します。
+     * コマンドラインに "-MCPRecord=<パス>" を指定した場合も、起動時に記録を開始します。
+     * 
+     * @param FilePath ログファイルのパス（空の場合は Saved/MCP/Recordings に日時のファイル名で作成）
+     * @return 書き出すログファイルのパス
+     */
+    FString StartCommandRecording(const FString& FilePath = FString());
+    
+    /** MCPサーバーへのコマンドの記録を終了 */
+    void StopCommandRecording();
+    
 private:
+    /**
+     * インポート結果を作成
+     * 
+     * @param bSuccess インポートが成功したかどうか
+     * @param ModelPath Blenderモデルのパス
+     * @param DestinationPath UE5内の保存先パス
+     * @param AssetName インポートされたアセット名
+     * @return インポート結果
+     */
+    static FMCPAssetImportResult MakeImportResult(bool bSuccess, const FString& ModelPath, const FString& DestinationPath, const FString& AssetName);
+    
+    /**
+     * インポートキャッシュのキーを作成
+     * 
+     * ソースファイルのパスと内容のハッシュ、インポート設定から作成します。
+     * 
+     * @param SourceKey ソースファイルのキー（MakeSourceKeyの結果）
+     * @param SourceHash ソースファイルの内容のハッシュ
+     * @param DestinationPath UE5内の保存先パス
+     * @return 作成したキー
+     */
+    static FString MakeImportCacheKey(const FString& SourceKey, const FMD5Hash& SourceHash, const FString& DestinationPath);
+    
+    /**
+     * インポートキャッシュのキーをまとめて作成する
+     * 
+     * ソースファイルのハッシュはワーカースレッドで計算し、サイズと更新日時が
+     * 前回と同じファイルは読み込まずに前回のハッシュを使います。
+     * 完了の通知はゲームスレッドで呼ばれます。
+     * 
+     * @param ModelPaths Blenderモデルのパス
+     * @param DestinationPath UE5内の保存先パス
+     * @param OnResolved 作成したキー（ModelPathsと同じ順、ソースファイルを読めない場合は空）
+     */
+    void ResolveImportCacheKeys(const TArray<FString>& ModelPaths, const FString& DestinationPath,
+                                TFunction<void(TArray<FString>&& CacheKeys)> OnResolved);
+    
+    /** ソースファイルのハッシュ（サイズと更新日時が変わるまで使い回す） */
+    struct FSourceHashEntry
+    {
+        /** ファイルサイズ */
+        int64 Size = -1;
+        
+        /** 更新日時 */
+        FDateTime ModificationTime;
+        
+        /** 内容のハッシュ */
+        FMD5Hash Hash;
+    };
+    
+    /** ソースファイルごとのハッシュ（キーはMakeSourceKeyの結果） */
+    TMap<FString, FSourceHashEntry> SourceHashes;
+    
+    /**
+     * インポートキャッシュを検索
+     * 
+     * @param CacheKey キャッシュのキー
+     * @param OutResult 見つかったインポート結果
+     * @return キャッシュが有効だったかどうか（インポート先のアセットが存在しない場合はfalse）
+     */
+    bool FindCachedImport(const FString& CacheKey, FMCPAssetImportResult& OutResult) const;
+    
+    /**
+     * インポート結果をキャッシュに記録
+     * 
+     * @param CacheKey キャッシュのキー
+     * @param ModelPath Blenderモデルのパス
+     * @param Result インポート結果
+     */
+    void RecordImport(const FString& CacheKey, const FString& ModelPath, const FMCPAssetImportResult& Result);
+    
+    /** インポートマニフェストのファイルパス */
+    static FString GetImportManifestPath();
+    
+    /** インポートマニフェストを保存する */
+    void SaveImportManifest();
+    
+    /** インポートマニフェストの保存を予約する（連続したインポートをまとめて1回で保存する） */
+    void ScheduleImportManifestSave();
+    
+    /** インポートキャッシュのエントリ */
+    struct FImportCacheEntry
+    {
+        /** ソースファイルのパス */
+        FString SourcePath;
+        
+        /** インポートされたアセットのパス */
+        FString AssetPath;
+        
+        /** アセット名 */
+        FString AssetName;
+    };
+    
+    /** インポートキャッシュ（キーはソースのパスとハッシュ、インポート設定） */
+    TMap<FString, FImportCacheEntry> ImportCache;
+    
+    /**
+     * インポートマニフェストを解析する（ワーカースレッドから呼ばれる）
+     * 
+     * @param JsonContent マニフェストのJSON
+     * @param OutEntries 解析したエントリ
+     * @return 解析に成功したかどうか
+     */
+    static bool ParseImportManifest(const FString& JsonContent, TMap<FString, FImportCacheEntry>& OutEntries);
+    
+    /** インポートマニフェストの保存予約 */
+    FTSTicker::FDelegateHandle ManifestSaveHandle;
+    
+    /**
+     * インポート結果をインデックスに登録する
+     * 
+     * インポート先のフォルダにアセットレジストリが同じ名前のアセットを登録済みであれば、
+     * そのパスをインポート結果のパスにします。
+     * 
+     * @param ModelPath Blenderモデルのパス
+     * @param DestinationPath UE5内の保存先パス
+     * @param InOutResult インポート結果
+     */
+    void IndexImportResult(const FString& ModelPath, const FString& DestinationPath, FMCPAssetImportResult& InOutResult);
+    
+    /**
+     * インデックスの対象にするフォルダを追加する
+     * 
+     * 初めて追加されたフォルダだけ、既存のアセットを1回だけ走査して登録します。
+     * 以降はアセットレジストリのイベントで更新されます。
+     * 
+     * @param PackagePath フォルダのパス
+     */
+    void AddIndexedRoot(const FString& PackagePath);
+    
+    /** パッケージがインデックスの対象のフォルダにあるかどうか */
+    bool IsUnderIndexedRoot(const FString& PackageName) const;
+    
+    /**
+     * アセットをインデックスに登録する
+     * 
+     * @param PackageName パッケージ名
+     * @param AssetName アセット名
+     * @param SourceKey ソースファイルのキー（不明な場合は空）
+     */
+    void AddImportedAsset(FName PackageName, FName AssetName, const FString& SourceKey);
+    
+    /** アセットをインデックスから削除する */
+    void RemoveImportedAsset(FName PackageName);
+    
+    /** ソースファイルのパスをインデックスのキーに変換する */
+    static FString MakeSourceKey(const FString& ModelPath);
+    
+    /** アセットデータからソースファイルのキーを取得する（インポート情報がない場合は空） */
+    static FString GetSourceKey(const FAssetData& AssetData);
+    
+    /** アセットレジストリにアセットが追加された時の処理 */
+    void HandleRegistryAssetAdded(const FAssetData& AssetData);
+    
+    /** アセットレジストリでアセットの名前が変わった時の処理 */
+    void HandleRegistryAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    
+    /** アセットレジストリからアセットが削除された時の処理 */
+    void HandleRegistryAssetRemoved(const FAssetData& AssetData);
+    
+    /** インデックスのエントリ */
+    struct FImportedAsset
+    {
+        /** アセット名 */
+        FName AssetName;
+        
+        /** ソースファイルのキー（不明な場合は空） */
+        FString SourceKey;
+    };
+    
+    /** MCPでインポートしたアセット（キーはパッケージ名） */
+    TMap<FName, FImportedAsset> ImportedAssets;
+    
+    /** ソースファイルのキーからパッケージ名への索引 */
+    TMap<FString, FName> ImportedAssetsBySource;
+    
+    /** アセット名からパッケージ名への索引 */
+    TMap<FName, FName> ImportedAssetsByName;
+    
+    /** インデックスの対象のフォルダ（末尾に"/"を付けたパス） */
+    TArray<FString> IndexedRoots;
+    
+    /**
+     * 非同期ロード完了時の処理
+     * 
+     * @param ObjectPath ロードしたアセットのパス
+     */
+    void HandleAssetLoaded(FSoftObjectPath ObjectPath);
+    
+    /** ロード中のアセット */
+    struct FPendingAssetLoad
+    {
+        /** ロードのハンドル */
+        TSharedPtr<FStreamableHandle> Handle;
+        
+        /** ロード完了を待っているコールバック */
+        TArray<TFunction<void(UObject* Asset)>> Callbacks;
+    };
+    
+    /** 非同期ロードの管理 */
+    FStreamableManager StreamableManager;
+    
+    /** ロード済みのアセット（パスごとのキャッシュ、参照を保持してGCされないようにする） */
+    UPROPERTY()
+    TMap<FSoftObjectPath, UObject*> ResidentAssets;
+    
+    /** ロード中のアセット */
+    TMap<FSoftObjectPath, FPendingAssetLoad> PendingAssetLoads;
+    
+    /** バッファから作成したメッシュ（キーはメッシュ名、参照を保持してGCされないようにする） */
+    UPROPERTY()
+    TMap<FString, UStaticMesh*> GeneratedMeshes;
+    
+    /**
+     * サーバーの状態を更新する
+     * 
+     * @param bHealthy 接続できるかどうか
+     * @param Message 状態のメッセージ
+     */
+    void UpdateServerHealth(bool bHealthy, const FString& Message);
+    
+    /** サーバーの状態 */
+    enum class EServerHealth : uint8
+    {
+        Unknown,
+        Healthy,
+        Unreachable,
+    };
+    
+    /** 最後に確認したサーバーの状態 */
+    EServerHealth ServerHealth;
+    
+    /** 最後に確認したサーバーの状態のメッセージ */
+    FString ServerHealthMessage;
+    
+    /** 最後にサーバーの状態を確認した時刻 */
+    double ServerHealthCheckTime;
+    
+    /** サーバーの状態を保持する時間（秒） */
+    double HealthCheckTTLSeconds;
+    
+    /** サーバーの状態が変わった時のデリゲート */
+    FOnServerHealthChanged ServerHealthChanged;
+    
     /** MCPクライアント */
     TSharedPtr<FMCPClient> MCPClient;
     
-    /** 初期化済みフラグ */
+    /** 読み込んだ設定（ワーカースレッドで解析する） */
+    struct FLoadedConfig
+    {
+        /** サーバーのURL（設定がない場合は空） */
+        FString ServerURL;
+        
+        /** 同時接続数の上限 */
+        int32 MaxConcurrentRequests = 4;
+        
+        /** キューの上限 */
+        int32 MaxQueuedRequests = 256;
+        
+        /** サーバーの状態を保持する時間（秒、設定がない場合は負の値） */
+        double HealthCheckTTLSeconds = -1.0;
+        
+        /** ストリーミング接続を使用するかどうか */
+        bool bUseStreaming = false;
+        
+        /** インポートマニフェストのエントリ */
+        TMap<FString, FImportCacheEntry> ImportCache;
+    };
+    
+    /** 設定ファイルとインポートマニフェストを読み込んで解析する（ワーカースレッドから呼ばれる） */
+    static FLoadedConfig LoadConfig();
+    
+    /**
+     * 読み込んだ設定を反映し、待機中の処理を実行する（ゲームスレッド）
+     * 
+     * @param Config 読み込んだ設定
+     */
+    void ApplyConfig(FLoadedConfig&& Config);
+    
+    /**
+     * 設定の反映後に処理を実行する（反映済みであればすぐに実行する）
+     * 
+     * @param Task 実行する処理
+     */
+    void RunWhenConfigured(TFunction<void()> Task);
+    
+    /** 設定の反映を待っている処理 */
+    TArray<TFunction<void()>> PendingConfiguredTasks;
+    
+    /** 初期化を開始したかどうか */
     bool bInitialized;
     
+    /** 設定を反映したかどうか */
+    bool bConfigured;
+    
     /** シングルトンインスタンス */
     static UMCPAssetManager* Instance;
 }; 
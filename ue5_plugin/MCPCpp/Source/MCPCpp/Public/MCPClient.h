@@ -9,12 +9,58 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+#include "MCPCommandTypes.h"
+#include "MCPHttpTransport.h"
+#include "MCPStreamClient.h"
+#include "MCPCommandRecorder.h"
+
+/**
+ * バッチ実行する1件のコマンド
+ */
+struct MCPCPP_API FMCPBatchCommand
+{
+    /** コマンド名 */
+    FString Command;
+    
+    /** コマンドのパラメータ */
+    TSharedPtr<FJsonObject> Params;
+    
+    /** コンストラクタ */
+    FMCPBatchCommand() = default;
+    FMCPBatchCommand(const FString& InCommand, const TSharedPtr<FJsonObject>& InParams)
+        : Command(InCommand)
+        , Params(InParams)
+    {
+    }
+};
+
+/**
+ * バッチ実行した1件のコマンドの結果
+ */
+struct MCPCPP_API FMCPBatchCommandResult
+{
+    /** コマンドが成功したかどうか */
+    bool bSuccess = false;
+    
+    /** コマンド名 */
+    FString Command;
+    
+    /** コマンドの応答（単体実行時の応答と同じ形式） */
+    TSharedPtr<FJsonObject> Response;
+    
+    /** エラーメッセージ（失敗時） */
+    FString ErrorMessage;
+};
 
 /**
  * MCPクライアント
  * 
  * このクラスはMCPサーバーとの通信を担当します。
  * RESTful APIを通じてサーバーにコマンドを送信し、結果を受け取ります。
+ * 通信はFMCPHttpTransportを経由し、同時接続数の制限とKeep-Aliveによる接続の再利用を行います。
+ * ストリーミング接続を開始すると、UE5コマンドはWebSocket経由で送信され、
+ * サーバーからのイベントも受け取れるようになります。
  */
 class MCPCPP_API FMCPClient
 {
@@ -39,6 +85,127 @@ public:
      */
     void CheckConnection(TFunction<void(bool bSuccess, const FString& Message)> OnCompleteCallback);
     
+    /**
+     * 同時に処理するリクエスト数の上限を設定
+     * 
+     * @param MaxConcurrentRequests 上限（1以上）
+     * @param MaxQueuedRequests キューに保持するリクエスト数の上限（0で無制限）
+     */
+    void SetConcurrencyLimits(int32 MaxConcurrentRequests, int32 MaxQueuedRequests);
+    
+    /** 新しいリクエストを受け付けられるかどうか（キューが満杯でないか） */
+    bool CanAcceptRequest() const;
+    
+    /**
+     * ストリーミング接続を開始
+     * 
+     * 接続中はExecuteUnrealCommandがWebSocket経由で送信されます。
+     */
+    void ConnectStream();
+    
+    /** ストリーミング接続を終了 */
+    void DisconnectStream();
+    
+    /** ストリーミングクライアント（サーバーイベントの購読に使用） */
+    FMCPStreamClient& GetStreamClient() const { return *StreamClient; }
+    
+    /**
+     * コマンドの記録を開始
+     * 
+     * 以降に完了したリクエストのペイロード・所要時間・応答をログファイルに書き出します。
+     * 全てのリクエストを記録するため、記録中はUE5コマンドもHTTP経由で送信します。
+     * ログは MCPReplay コマンドレットで再生できます。
+     * 
+     * @param FilePath ログファイルのパス（記録中の場合は前の記録を終了します）
+     * @return 記録を開始できたかどうか
+     */
+    bool StartRecording(const FString& FilePath);
+    
+    /** コマンドの記録を終了 */
+    void StopRecording();
+    
+    /** コマンドを記録中かどうか */
+    bool IsRecording() const { return Recorder.IsValid(); }
+    
+    /**
+     * UE5コマンドを実行
+     * 
+     * コールバックにはキュー待ちとサーバー処理の所要時間が渡されます。
+     * ストリーミング接続中はWebSocket経由、それ以外はHTTP経由で送信します。
+     * 
+     * @param Command 実行するコマンド
+     * @param Params コマンドのパラメータ
+     * @param OnCompleteCallback 完了時のコールバック関数
+     * @param OnDecode 応答の解析後に続けて行う変換（HTTP経由の場合はワーカースレッドで呼ばれます、省略可）
+     * @return キューに追加できたかどうか
+     */
+    bool ExecuteUnrealCommand(const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                              FMCPHttpTransport::FOnRequestComplete OnCompleteCallback,
+                              FMCPHttpTransport::FOnDecodeResponse OnDecode = FMCPHttpTransport::FOnDecodeResponse());
+    
+    /**
+     * UE5コマンドを実行し、応答の一部を構造体に変換して受け取る
+     * 
+     * JSONの解析と構造体への変換はワーカースレッドで行い、コールバックだけをゲームスレッドで呼びます。
+     * 構造体にはUObjectへの参照を含めないでください。
+     * 
+     * @param Command 実行するコマンド
+     * @param Params コマンドのパラメータ
+     * @param ResultFieldPath 変換する応答のフィールド（"result.asset_info" のように "." で区切る）
+     * @param OnCompleteCallback 完了時のコールバック関数
+     * @param bRequireResult フィールドがない・変換できない場合に失敗とするかどうか（falseの場合は既定値の構造体で成功とします）
+     * @return キューに追加できたかどうか
+     */
+    template <typename StructType>
+    bool ExecuteUnrealCommandAs(const FString& Command, const TSharedPtr<FJsonObject>& Params, const FString& ResultFieldPath,
+                                TFunction<void(bool bSuccess, const StructType& Result, const FMCPRequestTiming& Timing)> OnCompleteCallback,
+                                bool bRequireResult = true)
+    {
+        TSharedRef<StructType, ESPMode::ThreadSafe> Result = MakeShared<StructType, ESPMode::ThreadSafe>();
+        return ExecuteUnrealCommand(Command, Params,
+            [Result, OnCompleteCallback](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
+            {
+                OnCompleteCallback(bSuccess, *Result, Timing);
+            },
+            [Result, ResultFieldPath, bRequireResult](const TSharedPtr<FJsonObject>& Response)
+            {
+                const TSharedPtr<FJsonObject> ResultObj = FindObjectField(Response, ResultFieldPath);
+                const bool bConverted = ResultObj.IsValid() && FJsonObjectConverter::JsonObjectToUStruct(ResultObj.ToSharedRef(), &Result.Get());
+                return bConverted || !bRequireResult;
+            });
+    }
+    
+    /**
+     * "." で区切ったパスでJSONのオブジェクトフィールドを検索
+     * 
+     * @param Object 検索するオブジェクト
+     * @param FieldPath フィールドのパス
+     * @return 見つかったオブジェクト（見つからない場合はnullptr）
+     */
+    static TSharedPtr<FJsonObject> FindObjectField(const TSharedPtr<FJsonObject>& Object, const FString& FieldPath);
+    
+    /**
+     * 複数のUE5コマンドを1回のリクエストで実行
+     * 
+     * コマンドは指定した順にサーバーで実行され、結果も同じ順で返されます。
+     * 通信に失敗した場合は全てのコマンドが失敗として返されます。
+     * 
+     * @param Commands 実行するコマンド
+     * @param bStopOnError 失敗したコマンド以降を実行しないかどうか
+     * @param OnCompleteCallback 完了時のコールバック関数
+     * @return キューに追加できたかどうか
+     */
+    bool ExecuteBatch(const TArray<FMCPBatchCommand>& Commands, bool bStopOnError,
+                      TFunction<void(bool bSuccess, const TArray<FMCPBatchCommandResult>& Results, const FMCPRequestTiming& Timing)> OnCompleteCallback);
+    
+    /**
+     * import_assetコマンドの応答からアセット名を取得
+     * 
+     * @param Response コマンドの応答
+     * @return アセット名（取得できない場合は空文字列）
+     */
+    static FString GetImportedAssetName(const TSharedPtr<FJsonObject>& Response);
+    
     /**
      * Blenderコマンドを実行
      * 
@@ -59,6 +226,18 @@ public:
     void ImportAsset(const FString& AssetPath, const FString& DestinationPath,
                     TFunction<void(bool bSuccess, const FString& AssetName)> OnCompleteCallback);
     
+    /**
+     * 生成されたメッシュのバッファを取得
+     * 
+     * サーバーに登録されたメッシュをバイナリのまま受け取ります（形式はFMCPMeshBufferViewを参照）。
+     * ファイルへの書き出しとFBXの解析を経由しないため、プロシージャルに生成したメッシュの転送に使います。
+     * 
+     * @param MeshName サーバーに登録されたメッシュ名
+     * @param OnCompleteCallback 完了時のコールバック関数（バッファはコールバック中のみ有効）
+     * @return キューに追加できたかどうか
+     */
+    bool FetchMeshBuffer(const FString& MeshName, FMCPHttpTransport::FOnBinaryRequestComplete OnCompleteCallback);
+    
     /**
      * ゲームモードを設定
      * 
@@ -79,6 +258,45 @@ private:
     /** サーバーURL */
     FString ServerURL;
     
+    /** ステータス確認のURL（ServerURLから生成） */
+    FString StatusURL;
+    
+    /** UE5コマンドのURL（ServerURLから生成） */
+    FString UnrealCommandURL;
+    
+    /** UE5バッチコマンドのURL（ServerURLから生成） */
+    FString UnrealBatchURL;
+    
+    /** BlenderコマンドのURL（ServerURLから生成） */
+    FString BlenderCommandURL;
+    
+    /** メッシュバッファのURLの接頭辞（ServerURLから生成） */
+    FString MeshBufferURL;
+    
+    /** ストリーミング接続のURL（ServerURLから生成） */
+    FString StreamURL;
+    
+    /** HTTPトランスポート */
+    TSharedPtr<FMCPHttpTransport, ESPMode::ThreadSafe> Transport;
+    
+    /** ストリーミングクライアント */
+    TSharedRef<FMCPStreamClient> StreamClient;
+    
+    /** ストリーミング接続を使用するかどうか */
+    bool bUseStream;
+    
+    /** コマンドの記録（記録中のみ有効） */
+    TSharedPtr<FMCPCommandRecorder> Recorder;
+    
+    /**
+     * コマンドのJSONペイロードを作成
+     * 
+     * @param Command コマンド名
+     * @param Params コマンドのパラメータ（nullptrの場合は空のオブジェクト）
+     * @return JSON文字列
+     */
+    static FString BuildCommandPayload(const FString& Command, const TSharedPtr<FJsonObject>& Params);
+    
     /**
      * HTTP POSTリクエストを送信
      * 
@@ -0,0 +1,150 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMCPRequestTiming;
+
+/** 記録したリクエストの種類 */
+enum class EMCPRecordedRequestKind : uint8
+{
+    /** JSONのPOST（コマンド・バッチ） */
+    Post,
+
+    /** JSONのGET（状態の確認） */
+    Get,
+
+    /** バイナリのGET（メッシュバッファ） */
+    GetBinary,
+};
+
+/**
+ * 記録した1件のリクエスト
+ *
+ * URLはサーバーのURLからの相対パスで保存するため、別のサーバーに対しても再生できます。
+ */
+struct MCPCPP_API FMCPRecordedCommand
+{
+    /** リクエストの種類 */
+    EMCPRecordedRequestKind Kind = EMCPRecordedRequestKind::Post;
+
+    /** サーバーのURLからの相対パス（"/api/unreal/command" など） */
+    FString Path;
+
+    /** 送信したペイロード（GETの場合は空） */
+    FString Payload;
+
+    /** 記録を開始してからキューに入るまでの時間（秒） */
+    double StartSeconds = 0.0;
+
+    /** キュー待ちの時間（ミリ秒） */
+    float QueueMs = 0.0f;
+
+    /** 送信してから応答を受け取るまでの時間（ミリ秒） */
+    float ServerMs = 0.0f;
+
+    /** キューに入ってから応答を受け取るまでの時間（ミリ秒） */
+    float TotalMs = 0.0f;
+
+    /** HTTPレスポンスコード（接続できなかった場合は0） */
+    int32 ResponseCode = 0;
+
+    /** 成功したかどうか（接続でき、200が返った） */
+    bool bSuccess = false;
+
+    /** キューが満杯で送信されなかったかどうか */
+    bool bRejected = false;
+
+    /** 応答のバイト数（Responseが切り詰められている場合も元の大きさ） */
+    uint32 ResponseSize = 0;
+
+    /** 応答の本文（MCP.RecordMaxResponseBytes を超える部分は保存しない） */
+    TArray<uint8> Response;
+
+    /** シリアライズ */
+    friend FArchive& operator<<(FArchive& Ar, FMCPRecordedCommand& Command);
+};
+
+/**
+ * MCPコマンドの記録
+ *
+ * FMCPHttpTransport が送信したリクエストのペイロード・所要時間・応答を、
+ * 完了した順にバイナリのログファイルへ書き出します。
+ * ログは MCPReplay コマンドレットで同じ間隔・N倍速・最大速度で再生でき、
+ * MCPサーバーのスループットと遅延の測定に使えます。
+ * ゲームスレッドからのみ使用してください。
+ */
+class MCPCPP_API FMCPCommandRecorder
+{
+public:
+    /** ログファイルの先頭の識別子（"MCPR"） */
+    static constexpr uint32 FileMagic = 0x5250434D;
+
+    /** ログファイルの形式の版 */
+    static constexpr uint32 FileVersion = 1;
+
+    /**
+     * 記録を開始する
+     *
+     * @param FilePath 書き出すログファイルのパス（既存のファイルは上書きされます）
+     * @param BaseURL サーバーのURL（記録するURLからこの部分を取り除く）
+     * @return 作成した記録（ファイルを開けなかった場合はnullptr）
+     */
+    static TSharedPtr<FMCPCommandRecorder> Create(const FString& FilePath, const FString& BaseURL);
+
+    /**
+     * ログファイルを読み込む
+     *
+     * @param FilePath ログファイルのパス
+     * @param OutBaseURL 記録時のサーバーのURL
+     * @param OutCommands 記録したリクエスト（完了した順）
+     * @return 読み込めたかどうか
+     */
+    static bool LoadLog(const FString& FilePath, FString& OutBaseURL, TArray<FMCPRecordedCommand>& OutCommands);
+
+    /** デストラクタ（ファイルを閉じます） */
+    ~FMCPCommandRecorder();
+
+    /**
+     * 完了したリクエストを記録する
+     *
+     * @param Kind リクエストの種類
+     * @param URL リクエスト先のURL
+     * @param Payload 送信したペイロード
+     * @param EnqueueTime キューに入った時刻（FPlatformTime::Seconds）
+     * @param Timing リクエストの所要時間
+     * @param bSuccess 成功したかどうか
+     * @param Response 受信した応答の本文
+     */
+    void Record(EMCPRecordedRequestKind Kind, const FString& URL, const FString& Payload, double EnqueueTime,
+                const FMCPRequestTiming& Timing, bool bSuccess, TConstArrayView<uint8> Response);
+
+    /** ファイルを閉じる（以降の記録は無視されます） */
+    void Close();
+
+    /** 書き出すログファイルのパス */
+    const FString& GetFilePath() const { return FilePath; }
+
+    /** 記録したリクエスト数 */
+    int32 GetRecordCount() const { return RecordCount; }
+
+private:
+    /** コンストラクタ（Createから作成する） */
+    FMCPCommandRecorder(TUniquePtr<FArchive>&& InWriter, const FString& InFilePath, const FString& InBaseURL);
+
+    /** ログファイルの書き込み先 */
+    TUniquePtr<FArchive> Writer;
+
+    /** 書き出すログファイルのパス */
+    FString FilePath;
+
+    /** サーバーのURL */
+    FString BaseURL;
+
+    /** 記録を開始した時刻 */
+    double StartTime;
+
+    /** 記録したリクエスト数 */
+    int32 RecordCount;
+};
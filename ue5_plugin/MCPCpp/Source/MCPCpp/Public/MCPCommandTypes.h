@@ -0,0 +1,25 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPCommandTypes.generated.h"
+
+/**
+ * import_assetコマンドの応答に含まれるアセット情報
+ *
+ * FMCPClient::ExecuteUnrealCommandAsで応答の "result.asset_info" から変換されます。
+ */
+USTRUCT(BlueprintType)
+struct FMCPImportedAssetInfo
+{
+    GENERATED_BODY()
+    
+    /** アセット名 */
+    UPROPERTY(BlueprintReadOnly, Category = "MCP|Asset")
+    FString Name;
+    
+    /** インポート先のパス */
+    UPROPERTY(BlueprintReadOnly, Category = "MCP|Asset")
+    FString Path;
+};
@@ -10,6 +10,8 @@
  * 
  * このモジュールはMCPサーバーとUE5を連携させるための機能を提供します。
  * Blenderで作成したアセットをUE5に取り込み、ゲーム開発を支援します。
+ * パッケージしたゲームでも読み込まれるランタイムモジュールのため、エディタのモジュールには依存しません。
+ * エディタのメニューなどは MCPCppEditor モジュールが担当します。
  */
 class FMCPCppModule : public IModuleInterface
 {
@@ -27,10 +29,4 @@ private:
     { 
         return FModuleManager::GetModuleChecked<FMCPCppModule>("MCPCpp"); 
     }
-
-    /** メニュー拡張を登録 */
-    void RegisterMenuExtensions();
-    
-    /** メニュー拡張を解除 */
-    void UnregisterMenuExtensions();
 }; 
@@ -7,6 +7,11 @@
 #include "MCPAssetManager.h"
 #include "MCPGameMode.generated.h"
 
+class FMCPImportPipeline;
+
+/** ディレクトリ一括インポートの進捗デリゲート */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FMCPImportProgressDelegate, int32, CompletedCount, int32, TotalCount, const FMCPAssetImportResult&, Result);
+
 /**
  * MCPゲームモード
  * 
@@ -42,6 +47,9 @@ public:
     /**
      * アセットディレクトリ内のすべてのアセットをインポート
      * 
+     * MaxParallelImports件ずつ非同期でインポートし、全て完了した時点でOnCompleteを1回呼びます。
+     * 進捗はOnDirectoryImportProgressで通知されます。
+     * 
      * @param DirectoryPath インポートするディレクトリパス
      * @param DestinationPath UE5内の保存先パス
      * @param OnComplete 完了時に呼ばれるコールバック
@@ -78,7 +86,18 @@ public:
     /** レベルセットアップ完了デリゲート */
     DECLARE_DYNAMIC_DELEGATE_TwoParams(FSetupLevelCompleteDelegate, bool, bSuccess, const FString&, LevelPath);
     
+    /** ディレクトリ一括インポートで1件完了するごとに呼ばれる */
+    UPROPERTY(BlueprintAssignable, Category = "MCP|Game")
+    FMCPImportProgressDelegate OnDirectoryImportProgress;
+    
 protected:
+    /** ディレクトリ一括インポートで同時にインポートする最大数 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MCP|Game", meta = (ClampMin = "1"))
+    int32 MaxParallelImports;
+    
+    /** 実行中のディレクトリ一括インポート */
+    TSharedPtr<FMCPImportPipeline> DirectoryImportPipeline;
+    
     /** MCPアセットマネージャーへの参照 */
     UMCPAssetManager* AssetManager;
     
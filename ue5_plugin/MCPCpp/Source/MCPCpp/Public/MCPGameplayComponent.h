@@ -13,6 +13,9 @@
  * このコンポーネントは、BlenderからUE5に取り込んだアセットを使って
  * ゲームプレイの実装を行うための機能を提供します。
  * ゲームアクターにアタッチして使用します。
+ * 
+ * 敵や弾のように大量にスポーンされるアクターにも付けられるよう、ティックは行わず、
+ * インスタンスごとの状態も持ちません。MCPとのやり取りはすべてUMCPSubsystemを経由します。
  */
 UCLASS(ClassGroup=(MCP), meta=(BlueprintSpawnableComponent))
 class MCPCPP_API UMCPGameplayComponent : public UActorComponent
@@ -23,24 +26,32 @@ public:
     /** コンストラクタ */
     UMCPGameplayComponent();
 
-    /** コンポーネントの初期化処理 */
-    virtual void InitializeComponent() override;
-    
-    /** ティック関数 */
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     /**
      * Blenderアセットをロードして使用可能にする
      * 
+     * ロードは非同期で行われ、アセットがメモリ上に存在する状態になった時点でデリゲートが呼ばれます。
+     * 
      * @param AssetPath アセットのパス
      * @param OnLoaded アセットがロードされた時に呼ばれるデリゲート
      */
     UFUNCTION(BlueprintCallable, Category = "MCP|Gameplay")
     void LoadBlenderAsset(const FString& AssetPath, FOnAssetLoaded OnLoaded);
     
+    /**
+     * Blenderアセットを非同期でロードする（C++用）
+     * 
+     * @param AssetPath アセットのパス
+     * @param OnResident アセットがロードされた時に呼ばれるコールバック（失敗時はnullptr）
+     */
+    void RequestBlenderAsset(const FString& AssetPath, TFunction<void(UObject* Asset)> OnResident);
+    
     /**
      * アセットをスポーンする
      * 
+     * ロード済みのアセットのみすぐにスポーンします。未ロードの場合はロードを開始して
+     * nullptrを返すため、確実にスポーンしたい場合はSpawnAssetActorAsyncを使用してください。
+     * 
      * @param AssetPath アセットのパス
      * @param Location スポーン位置
      * @param Rotation スポーン時の回転
@@ -50,9 +61,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "MCP|Gameplay")
     AActor* SpawnAssetActor(const FString& AssetPath, FVector Location, FRotator Rotation, FVector Scale = FVector(1.0f));
     
+    /**
+     * アセットを非同期でロードしてからスポーンする
+     * 
+     * @param AssetPath アセットのパス
+     * @param Location スポーン位置
+     * @param Rotation スポーン時の回転
+     * @param Scale スケール
+     * @param OnSpawned スポーン完了時に呼ばれるデリゲート（失敗時はnullptr）
+     */
+    UFUNCTION(BlueprintCallable, Category = "MCP|Gameplay")
+    void SpawnAssetActorAsync(const FString& AssetPath, FVector Location, FRotator Rotation, FVector Scale, FOnActorSpawned OnSpawned);
+    
     /**
      * カスタムBlenderアセットをスポーンする
      * 
+     * Blenderでのモデル生成・エクスポート・UE5へのインポートをアセットジョブとして順に実行し、
+     * インポートしたアセットを非同期でロードしてスポーンします。
+     * 
      * @param ModelType モデルタイプ
      * @param Location スポーン位置
      * @param Rotation スポーン時の回転
@@ -69,11 +95,27 @@ public:
     /** アクタースポーン時デリゲート */
     DECLARE_DYNAMIC_DELEGATE_OneParam(FOnActorSpawned, AActor*, SpawnedActor);
     
+    /** BeginPlayでMCPサーバーへの接続を確認するかどうか（通常はサブシステムの確認結果を共有するため不要） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MCP|Gameplay")
+    bool bCheckServerOnBeginPlay;
+    
 protected:
     /** コンポーネントの初期化処理 */
     virtual void BeginPlay() override;
     
 private:
-    /** MCPアセットマネージャーへの参照 */
-    UMCPAssetManager* AssetManager;
+    /**
+     * ロード済みのアセットからアクターを生成する
+     * 
+     * @param Asset スタティックメッシュまたはブループリント
+     * @param AssetPath アセットのパス（ログ用）
+     * @param Location スポーン位置
+     * @param Rotation スポーン時の回転
+     * @param Scale スケール
+     * @return スポーンされたアクター
+     */
+    AActor* SpawnActorFromAsset(UObject* Asset, const FString& AssetPath, const FVector& Location, const FRotator& Rotation, const FVector& Scale);
+    
+    /** 共有のアセットマネージャーを取得 */
+    UMCPAssetManager* GetAssetManager() const;
 }; 
@@ -0,0 +1,228 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Dom/JsonObject.h"
+
+class FMCPCommandRecorder;
+
+/**
+ * リクエストごとの所要時間
+ *
+ * キュー待ちの時間とサーバー処理（送信から応答まで）の時間を分けて記録します。
+ */
+struct MCPCPP_API FMCPRequestTiming
+{
+    /** キューに入ってから送信されるまでの時間（秒） */
+    double QueueSeconds = 0.0;
+
+    /** 送信してから応答を受け取るまでの時間（秒） */
+    double ServerSeconds = 0.0;
+
+    /** 応答の解析にかかった時間（秒） */
+    double DecodeSeconds = 0.0;
+
+    /** キューに入ってから完了するまでの時間（秒） */
+    double TotalSeconds = 0.0;
+
+    /** HTTPレスポンスコード（接続できなかった場合は0） */
+    int32 ResponseCode = 0;
+
+    /** キューが満杯で送信されなかったかどうか */
+    bool bRejected = false;
+};
+
+/**
+ * MCPサーバーとのHTTPトランスポート
+ *
+ * リクエストをキューに入れ、同時に処理するリクエスト数を制限しながら送信します。
+ * 接続はKeep-Aliveで維持し、一括でコマンドを送る場合でも接続確立のコストを抑えます。
+ * キューが上限に達した場合は新しいリクエストを拒否し、呼び出し側に知らせます。
+ * 大きなJSONの応答は、文字列に変換せずに受信したUTF-8のバッファからワーカースレッドで解析します。
+ * コールバックはゲームスレッドで呼ばれます。
+ */
+class MCPCPP_API FMCPHttpTransport : public TSharedFromThis<FMCPHttpTransport, ESPMode::ThreadSafe>
+{
+public:
+    /** 完了時のコールバック */
+    typedef TFunction<void(bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)> FOnRequestComplete;
+
+    /** バイナリ応答の完了時のコールバック（Contentは応答のバッファを直接参照し、コールバック中のみ有効） */
+    typedef TFunction<void(bool bSuccess, TConstArrayView<uint8> Content, const FMCPRequestTiming& Timing)> FOnBinaryRequestComplete;
+
+    /**
+     * 解析済みの応答に対する追加の変換（解析と同じスレッドで呼ばれ、変換に成功したかどうかを返す）
+     *
+     * ワーカースレッドで呼ばれる場合があるため、UObjectやゲームの状態には触れないでください。
+     */
+    typedef TFunction<bool(const TSharedPtr<FJsonObject>& Response)> FOnDecodeResponse;
+
+    /** コンストラクタ */
+    FMCPHttpTransport();
+
+    /** デストラクタ（未送信のリクエストは失敗として通知されます） */
+    ~FMCPHttpTransport();
+
+    /**
+     * 同時に処理するリクエスト数の上限を設定
+     *
+     * @param InMaxConcurrentRequests 上限（1以上）
+     */
+    void SetMaxConcurrentRequests(int32 InMaxConcurrentRequests);
+
+    /**
+     * キューに保持するリクエスト数の上限を設定
+     *
+     * @param InMaxQueuedRequests 上限（0で無制限）
+     */
+    void SetMaxQueuedRequests(int32 InMaxQueuedRequests);
+
+    /**
+     * リクエストのタイムアウトを設定
+     *
+     * @param InTimeoutSeconds タイムアウト（秒、0以下でエンジンの既定値）
+     */
+    void SetRequestTimeout(float InTimeoutSeconds);
+
+    /**
+     * ワーカースレッドで解析する応答のサイズの下限を設定
+     *
+     * これより小さい応答は、スレッドを切り替えずにその場で解析します。
+     *
+     * @param InThresholdBytes 下限（バイト、0で全ての応答をワーカースレッドで解析）
+     */
+    void SetOffThreadDecodeThreshold(int32 InThresholdBytes);
+
+    /**
+     * POSTリクエストをキューに追加
+     *
+     * @param URL リクエスト先のURL
+     * @param JsonPayload JSONペイロード
+     * @param OnComplete 完了時のコールバック関数
+     * @param OnDecode 解析後に続けて行う変換（省略可）
+     * @return キューに追加できたかどうか（falseの場合はコールバックが即座に呼ばれます）
+     */
+    bool EnqueuePost(const FString& URL, const FString& JsonPayload, FOnRequestComplete OnComplete,
+                     FOnDecodeResponse OnDecode = FOnDecodeResponse());
+
+    /**
+     * GETリクエストをキューに追加
+     *
+     * 同じURLへのGETが送信待ちまたは処理中の場合は新しいリクエストを送らず、
+     * その応答を共有します（コールバックは追加した順に呼ばれます）。
+     *
+     * @param URL リクエスト先のURL
+     * @param OnComplete 完了時のコールバック関数
+     * @return キューに追加できたかどうか（falseの場合はコールバックが即座に呼ばれます）
+     */
+    bool EnqueueGet(const FString& URL, FOnRequestComplete OnComplete);
+
+    /**
+     * バイナリの応答を受け取るGETリクエストをキューに追加
+     *
+     * 応答はJSONとして解析せず、受信したバッファをそのまま渡します。
+     *
+     * @param URL リクエスト先のURL
+     * @param OnComplete 完了時のコールバック関数
+     * @return キューに追加できたかどうか（falseの場合はコールバックが即座に呼ばれます）
+     */
+    bool EnqueueGetBinary(const FString& URL, FOnBinaryRequestComplete OnComplete);
+
+    /** 新しいリクエストを受け付けられるかどうか */
+    bool CanAcceptRequest() const;
+
+    /** 送信待ちのリクエスト数 */
+    int32 GetQueuedCount() const { return PendingRequests.Num() - PendingHead; }
+
+    /** 処理中のリクエスト数 */
+    int32 GetInFlightCount() const { return InFlightCount; }
+
+    /** 送信待ちのリクエストをすべて破棄する（失敗として通知されます） */
+    void CancelPending();
+
+    /** 応答を共有したGETリクエスト（まとめられたリクエスト）の累計数 */
+    int32 GetCoalescedRequestCount() const { return CoalescedRequestCount; }
+
+    /**
+     * 完了したリクエストを記録する先を設定
+     *
+     * 応答を共有したGETリクエストは、実際に送信した1件だけが記録されます。
+     *
+     * @param InRecorder 記録先（nullptrで記録しない）
+     */
+    void SetRecorder(const TSharedPtr<FMCPCommandRecorder>& InRecorder) { Recorder = InRecorder; }
+
+private:
+    /** 送信待ちのリクエスト */
+    struct FPendingRequest
+    {
+        FString URL;
+        FString Verb;
+        FString Payload;
+        FOnRequestComplete OnComplete;
+        FOnBinaryRequestComplete OnBinaryComplete;
+        FOnDecodeResponse OnDecode;
+        double EnqueueTime = 0.0;
+
+        /** 失敗を通知する */
+        void NotifyFailure(const FMCPRequestTiming& Timing) const;
+    };
+
+    /** リクエストをキューに追加する */
+    bool Enqueue(FPendingRequest&& Request);
+
+    /** 上限に達するまでキューのリクエストを送信する */
+    void PumpQueue();
+
+    /** リクエストを送信する */
+    void Dispatch(FPendingRequest&& Request);
+
+    /** リクエスト完了時の処理 */
+    void HandleComplete(FHttpResponsePtr Response, bool bConnectedSuccessfully, double DispatchTime, const FPendingRequest& Request);
+
+    /** 記録先が設定されていれば、完了または拒否したリクエストを記録する */
+    void RecordRequest(const FPendingRequest& Request, const FMCPRequestTiming& Timing, bool bSuccess, TConstArrayView<uint8> Content) const;
+
+    /**
+     * 受信したバッファからJSONを解析する（文字列への変換は行わない）
+     *
+     * @param Content 受信したUTF-8のバッファ
+     * @param OnDecode 解析後に続けて行う変換
+     * @param OutResponse 解析したJSON
+     * @return 解析と変換に成功したかどうか
+     */
+    static bool DecodeJsonResponse(TConstArrayView<uint8> Content, const FOnDecodeResponse& OnDecode, TSharedPtr<FJsonObject>& OutResponse);
+
+    /** 同時に処理するリクエスト数の上限 */
+    int32 MaxConcurrentRequests;
+
+    /** キューに保持するリクエスト数の上限 */
+    int32 MaxQueuedRequests;
+
+    /** リクエストのタイムアウト（秒） */
+    float RequestTimeoutSeconds;
+
+    /** ワーカースレッドで解析する応答のサイズの下限（バイト） */
+    int32 OffThreadDecodeThreshold;
+
+    /** 処理中のリクエスト数 */
+    int32 InFlightCount;
+
+    /** 送信待ちのリクエスト（PendingHead以降が有効） */
+    TArray<FPendingRequest> PendingRequests;
+
+    /** 次に送信するリクエストの位置 */
+    int32 PendingHead;
+
+    /** 送信待ちまたは処理中のGETリクエストと、その応答を待っているコールバック（キーはURL） */
+    TMap<FString, TSharedRef<TArray<FOnRequestComplete>>> InFlightGets;
+
+    /** 応答を共有したGETリクエストの累計数 */
+    int32 CoalescedRequestCount;
+
+    /** 完了したリクエストの記録先 */
+    TSharedPtr<FMCPCommandRecorder> Recorder;
+};
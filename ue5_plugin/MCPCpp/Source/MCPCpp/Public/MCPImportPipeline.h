@@ -0,0 +1,102 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPAssetManager.h"
+
+/**
+ * MCPインポートパイプライン
+ *
+ * 複数のBlenderモデルを、同時に処理する数を制限しながら非同期でインポートします。
+ * 1件完了するごとに次のファイルを送信し、全て完了した時点で
+ * ファイルごとの結果をまとめて1回だけ通知します。
+ * 大量のファイルを扱う場合でも、サーバーとBlenderのエクスポート処理に
+ * 一度に送るリクエストはParallelism件までに抑えられます。
+ */
+class MCPCPP_API FMCPImportPipeline : public TSharedFromThis<FMCPImportPipeline>
+{
+public:
+    /** 進捗通知のコールバック（完了数、全体数、完了したファイルの結果） */
+    typedef TFunction<void(int32 CompletedCount, int32 TotalCount, const FMCPAssetImportResult& Result)> FOnProgress;
+
+    /** 完了時のコールバック（結果はファイルの指定順） */
+    typedef TFunction<void(const TArray<FMCPAssetImportResult>& Results)> FOnComplete;
+
+    /**
+     * パイプラインを作成して開始する
+     *
+     * @param AssetManager インポートに使うアセットマネージャー
+     * @param ModelPaths インポートするBlenderモデルのパス
+     * @param DestinationPath UE5内の保存先パス
+     * @param Parallelism 同時にインポートする最大数
+     * @param OnProgress 1件完了するごとに呼ばれるコールバック（省略可）
+     * @param OnComplete 全て完了した時に1回だけ呼ばれるコールバック
+     * @return 開始したパイプライン
+     */
+    static TSharedRef<FMCPImportPipeline> Start(UMCPAssetManager* AssetManager, const TArray<FString>& ModelPaths,
+                                                const FString& DestinationPath, int32 Parallelism,
+                                                FOnProgress OnProgress, FOnComplete OnComplete);
+
+    /** 未送信のファイルを取り消す（取り消したファイルは失敗として集計されます） */
+    void Cancel();
+
+    /** 完了したファイルの数 */
+    int32 GetCompletedCount() const { return CompletedCount; }
+
+    /** ファイルの総数 */
+    int32 GetTotalCount() const { return ModelPaths.Num(); }
+
+    /** 全て完了したかどうか */
+    bool IsComplete() const { return bCompleteNotified; }
+
+private:
+    /** コンストラクタ（Startから作成する） */
+    FMCPImportPipeline(UMCPAssetManager* InAssetManager, const TArray<FString>& InModelPaths, const FString& InDestinationPath,
+                       int32 InParallelism, FOnProgress InOnProgress, FOnComplete InOnComplete);
+
+    /** 上限に達するまで次のファイルのインポートを開始する */
+    void Pump();
+
+    /** 1件のインポート完了時の処理 */
+    void HandleImportComplete(int32 Index, const FMCPAssetImportResult& Result);
+
+    /** 全て完了していれば完了を通知する */
+    void NotifyIfComplete();
+
+    /** インポートに使うアセットマネージャー */
+    TWeakObjectPtr<UMCPAssetManager> AssetManager;
+
+    /** インポートするBlenderモデルのパス */
+    TArray<FString> ModelPaths;
+
+    /** UE5内の保存先パス */
+    FString DestinationPath;
+
+    /** 同時にインポートする最大数 */
+    int32 Parallelism;
+
+    /** 進捗通知のコールバック */
+    FOnProgress OnProgress;
+
+    /** 完了時のコールバック */
+    FOnComplete OnComplete;
+
+    /** ファイルごとの結果 */
+    TArray<FMCPAssetImportResult> Results;
+
+    /** 次にインポートするファイルの位置 */
+    int32 NextIndex;
+
+    /** インポート中のファイルの数 */
+    int32 InFlightCount;
+
+    /** 完了したファイルの数 */
+    int32 CompletedCount;
+
+    /** 完了を通知済みかどうか */
+    bool bCompleteNotified;
+
+    /** Pumpの実行中かどうか（同期的に完了した場合の再入を防ぐ） */
+    bool bPumping;
+};
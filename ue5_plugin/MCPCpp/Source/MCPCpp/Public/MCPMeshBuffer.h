@@ -0,0 +1,71 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * MCPメッシュバッファ
+ *
+ * MCPサーバーから受け取るバイナリ形式のメッシュデータを読み取ります。
+ * FBXファイルを経由せず、頂点・インデックス・UVのバッファから直接UStaticMeshを作成するために使います。
+ *
+ * 形式（リトルエンディアン、各セクションは4バイト境界）:
+ *   ヘッダー   : "MCPM"、版、全体のバイト数、頂点数、インデックス数、フラグ（各uint32）
+ *   位置       : float32 x 3 x 頂点数
+ *   法線       : float32 x 3 x 頂点数（フラグにNormalsがある場合）
+ *   UV         : float32 x 2 x 頂点数（フラグにUVsがある場合）
+ *   インデックス: uint32 x インデックス数（3つで1つの三角形）
+ * 座標はUE5の座標系（センチメートル、Z軸が上）に変換済みであることを前提とします。
+ */
+struct MCPCPP_API FMCPMeshBufferView
+{
+    /** バッファの形式の版 */
+    static constexpr uint32 FormatVersion = 1;
+
+    /** フラグ */
+    enum EFlags : uint32
+    {
+        Normals = 1 << 0,
+        UVs = 1 << 1,
+    };
+
+    /** 頂点の位置 */
+    TConstArrayView<FVector3f> Positions;
+
+    /** 頂点の法線（ない場合は空） */
+    TConstArrayView<FVector3f> Normals;
+
+    /** 頂点のUV（ない場合は空） */
+    TConstArrayView<FVector2f> UVs;
+
+    /** 三角形のインデックス */
+    TConstArrayView<uint32> Indices;
+
+    /**
+     * バッファを読み取る
+     *
+     * データはコピーせず、各ビューは元のバッファを直接参照します。
+     * 元のバッファはビューを使い終わるまで保持する必要があります。
+     *
+     * @param Buffer 受信したバッファ
+     * @param OutView 読み取ったビュー
+     * @param OutError エラーメッセージ（失敗時）
+     * @return 読み取りに成功したかどうか
+     */
+    static bool Parse(TConstArrayView<uint8> Buffer, FMCPMeshBufferView& OutView, FString& OutError);
+
+    /**
+     * バッファからスタティックメッシュを作成する
+     *
+     * FMeshDescriptionをバッファから直接組み立て、中間のファイルやコピーを作らずにビルドします。
+     *
+     * @param View 読み取ったバッファ
+     * @param Outer 作成するメッシュのOuter
+     * @param MeshName 作成するメッシュの名前
+     * @return 作成したメッシュ（失敗時はnullptr）
+     */
+    static UStaticMesh* BuildStaticMesh(const FMCPMeshBufferView& View, UObject* Outer, FName MeshName);
+};
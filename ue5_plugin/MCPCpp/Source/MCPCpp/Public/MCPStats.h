@@ -0,0 +1,101 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+struct FMCPRequestTiming;
+
+/**
+ * MCPの統計
+ *
+ * "stat MCP" でプラグインとゲーム側の処理時間、リクエスト数、送受信バイト数を表示します。
+ * Unreal Insightsでは "-trace=cpu,counters,mcp" を指定すると、リクエストごとの所要時間が
+ * MCPチャンネルのイベントとして記録されます。
+ */
+DECLARE_STATS_GROUP(TEXT("MCP"), STATGROUP_MCP, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Request Send"), STAT_MCPRequestSend, STATGROUP_MCP, MCPCPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Response Parse"), STAT_MCPResponseParse, STATGROUP_MCP, MCPCPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Import Blender Model"), STAT_MCPImportBlenderModel, STATGROUP_MCP, MCPCPP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Place Asset"), STAT_MCPPlaceAsset, STATGROUP_MCP, MCPCPP_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests In Flight"), STAT_MCPRequestsInFlight, STATGROUP_MCP, MCPCPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Queued"), STAT_MCPRequestsQueued, STATGROUP_MCP, MCPCPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests Completed"), STAT_MCPRequestsCompleted, STATGROUP_MCP, MCPCPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Sent"), STAT_MCPBytesSent, STATGROUP_MCP, MCPCPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Received"), STAT_MCPBytesReceived, STATGROUP_MCP, MCPCPP_API);
+
+/** MCPのトレースチャンネル */
+UE_TRACE_CHANNEL_EXTERN(MCPChannel, MCPCPP_API);
+
+/**
+ * リクエストの所要時間のヒストグラム
+ *
+ * バケットは1ms未満、2ms未満、4ms未満…と2倍ずつ広がり、最後のバケットはそれ以上の全てを含みます。
+ */
+struct MCPCPP_API FMCPLatencyHistogram
+{
+    /** バケットの数 */
+    static constexpr int32 NumBuckets = 14;
+
+    /** バケットごとの件数 */
+    uint32 Buckets[NumBuckets] = {};
+
+    /** 記録した件数 */
+    uint32 Count = 0;
+
+    /** 所要時間の合計（秒） */
+    double TotalSeconds = 0.0;
+
+    /** 所要時間の最大値（秒） */
+    double MaxSeconds = 0.0;
+
+    /** 所要時間を記録する */
+    void Add(double Seconds);
+
+    /** 記録を消去する */
+    void Reset();
+
+    /** バケットの上限（ミリ秒、最後のバケットは上限なし） */
+    static double GetBucketUpperBoundMs(int32 BucketIndex);
+
+    /**
+     * パーセンタイルの推定値を取得する（バケットの上限で近似）
+     *
+     * @param Percentile パーセンタイル（0〜1）
+     * @return 所要時間（ミリ秒）
+     */
+    double GetPercentileMs(double Percentile) const;
+};
+
+namespace MCPStats
+{
+    /**
+     * リクエストの完了を記録する（統計・Insightsのイベント・ヒストグラム）
+     *
+     * @param Timing リクエストの所要時間
+     * @param BytesSent 送信したバイト数
+     * @param BytesReceived 受信したバイト数
+     * @param InFlightCount 完了後に処理中のリクエスト数
+     * @param QueuedCount 完了後に送信待ちのリクエスト数
+     */
+    MCPCPP_API void RecordRequestComplete(const FMCPRequestTiming& Timing, int32 BytesSent, int32 BytesReceived, int32 InFlightCount, int32 QueuedCount);
+
+    /**
+     * 処理中と送信待ちのリクエスト数を記録する
+     *
+     * @param InFlightCount 処理中のリクエスト数
+     * @param QueuedCount 送信待ちのリクエスト数
+     */
+    MCPCPP_API void RecordQueueDepth(int32 InFlightCount, int32 QueuedCount);
+
+    /** リクエストの所要時間（キューに入ってから応答を受け取るまで）のヒストグラム */
+    MCPCPP_API const FMCPLatencyHistogram& GetLatencyHistogram();
+
+    /** ヒストグラムを消去する */
+    MCPCPP_API void ResetLatencyHistogram();
+}
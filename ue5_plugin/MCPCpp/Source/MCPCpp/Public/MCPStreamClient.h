@@ -0,0 +1,155 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "MCPHttpTransport.h"
+
+class IWebSocket;
+
+/**
+ * MCPストリーミングクライアント
+ *
+ * MCPサーバーとのWebSocket接続を維持し、1本の接続で複数のコマンドを同時に処理します。
+ * 各コマンドには相関IDを付けて送信し、応答は送信順に関係なくIDで対応付けます。
+ * また、エクスポート完了やアセットの準備完了などのサーバーからのイベントを受け取るため、
+ * 完了を確認するためにリクエストを繰り返す必要がありません。
+ * 接続が切れた場合は処理中のコマンドを失敗として通知し、自動で再接続します。
+ * コールバックとイベントはゲームスレッドで呼ばれます。
+ */
+class MCPCPP_API FMCPStreamClient : public TSharedFromThis<FMCPStreamClient>
+{
+public:
+    /** サーバーイベントのデリゲート（イベント名、イベントのデータ） */
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnServerEvent, const FString& /*EventName*/, const TSharedPtr<FJsonObject>& /*Data*/);
+
+    /** 接続状態が変わった時のデリゲート */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnConnectionChanged, bool /*bConnected*/);
+
+    /** コンストラクタ */
+    FMCPStreamClient();
+
+    /** デストラクタ */
+    ~FMCPStreamClient();
+
+    /**
+     * サーバーに接続する
+     *
+     * @param InURL WebSocketのURL（ws://host:port/ws）
+     */
+    void Connect(const FString& InURL);
+
+    /** 接続を閉じる（自動再接続も停止します） */
+    void Disconnect();
+
+    /** 接続中かどうか */
+    bool IsConnected() const { return bConnected; }
+
+    /**
+     * コマンドを送信する
+     *
+     * 接続が確立する前に送信したコマンドは、接続後にまとめて送信されます。
+     *
+     * @param Target コマンドの送信先（"unreal" または "blender"）
+     * @param Command コマンド名
+     * @param Params コマンドのパラメータ
+     * @param OnComplete 完了時のコールバック関数
+     * @return コマンドの相関ID
+     */
+    int64 SendCommand(const FString& Target, const FString& Command, const TSharedPtr<FJsonObject>& Params,
+                      FMCPHttpTransport::FOnRequestComplete OnComplete);
+
+    /** 応答を待っているコマンドの数 */
+    int32 GetPendingCount() const { return PendingCommands.Num(); }
+
+    /** サーバーイベントのデリゲート */
+    FOnServerEvent& OnServerEvent() { return ServerEvent; }
+
+    /** 接続状態が変わった時のデリゲート */
+    FOnConnectionChanged& OnConnectionChanged() { return ConnectionChanged; }
+
+private:
+    /** 応答を待っているコマンド */
+    struct FPendingCommand
+    {
+        FMCPHttpTransport::FOnRequestComplete OnComplete;
+        double EnqueueTime = 0.0;
+        double SendTime = 0.0;
+        int32 PayloadBytes = 0;
+    };
+
+    /** 送信待ちのメッセージ */
+    struct FOutgoingMessage
+    {
+        int64 CorrelationId = 0;
+        FString Payload;
+    };
+
+    /** ソケットを作成して接続を開始する */
+    void OpenSocket();
+
+    /** ソケットを閉じる（切断イベントは発生しません） */
+    void CloseSocket();
+
+    /** 再接続の予約を取り消す */
+    void CancelReconnect();
+
+    /** 接続確立時の処理 */
+    void HandleConnected();
+
+    /** 接続失敗時の処理 */
+    void HandleConnectionError(const FString& Error);
+
+    /** 接続終了時の処理 */
+    void HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
+
+    /** メッセージ受信時の処理 */
+    void HandleMessage(const FString& Message);
+
+    /** 接続が切れた時の共通処理 */
+    void HandleDisconnected(const FString& Reason);
+
+    /** 送信待ちのメッセージを送信する */
+    void FlushOutgoing();
+
+    /** 応答を待っているコマンドを全て失敗として通知する */
+    void FailAllPending();
+
+    /** 再接続を予約する */
+    void ScheduleReconnect();
+
+    /** 接続先のURL */
+    FString URL;
+
+    /** WebSocket */
+    TSharedPtr<IWebSocket> Socket;
+
+    /** 応答を待っているコマンド（キーは相関ID） */
+    TMap<int64, FPendingCommand> PendingCommands;
+
+    /** 接続前に送信されたメッセージ */
+    TArray<FOutgoingMessage> OutgoingMessages;
+
+    /** 次に割り当てる相関ID */
+    int64 NextCorrelationId;
+
+    /** 接続中かどうか */
+    bool bConnected;
+
+    /** 切断後に再接続するかどうか */
+    bool bShouldReconnect;
+
+    /** 次の再接続までの待ち時間（秒） */
+    float ReconnectDelay;
+
+    /** 再接続の予約 */
+    FTSTicker::FDelegateHandle ReconnectHandle;
+
+    /** サーバーイベントのデリゲート */
+    FOnServerEvent ServerEvent;
+
+    /** 接続状態が変わった時のデリゲート */
+    FOnConnectionChanged ConnectionChanged;
+};
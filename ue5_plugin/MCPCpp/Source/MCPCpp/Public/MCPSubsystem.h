@@ -0,0 +1,49 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "MCPAssetManager.h"
+#include "MCPSubsystem.generated.h"
+
+/**
+ * MCPサブシステム
+ * 
+ * ゲームインスタンスごとに1つだけ作成され、ゲーム中のMCPとのやり取りをまとめて担当します。
+ * アセットマネージャーは最初に使われた時に取得し、サーバー接続の確認もその時に1回だけ行います。
+ * ゲームインスタンスの開始時にはMCPの処理は何も行いません。
+ * 各アクターのコンポーネントはこのサブシステムを経由してアセットマネージャーを使用します。
+ */
+UCLASS()
+class MCPCPP_API UMCPSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+    
+public:
+    /** サブシステムの初期化 */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    
+    /** サブシステムの終了 */
+    virtual void Deinitialize() override;
+    
+    /**
+     * ワールドコンテキストからサブシステムを取得
+     * 
+     * @param WorldContextObject ワールドに属するオブジェクト
+     * @return サブシステム（ゲームインスタンスがない場合はnullptr）
+     */
+    static UMCPSubsystem* Get(const UObject* WorldContextObject);
+    
+    /** アセットマネージャーを取得（最初の呼び出しで作成し、サーバー接続を確認する） */
+    UMCPAssetManager* GetAssetManager();
+    
+    /** MCPサーバーに接続できるかどうか（最後に確認した状態、アセットマネージャーを使う前はfalse） */
+    UFUNCTION(BlueprintPure, Category = "MCP")
+    bool IsServerConnected() const;
+    
+private:
+    /** アセットマネージャー */
+    UPROPERTY()
+    UMCPAssetManager* AssetManager;
+};
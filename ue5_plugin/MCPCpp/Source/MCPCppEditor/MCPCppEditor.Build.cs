@@ -0,0 +1,32 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class MCPCppEditor : ModuleRules
+{
+	public MCPCppEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"MCPCpp",
+			}
+			);
+			
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Slate",
+				"SlateCore",
+				"EditorStyle",
+				"UnrealEd",
+				"LevelEditor",
+			}
+			);
+	}
+}
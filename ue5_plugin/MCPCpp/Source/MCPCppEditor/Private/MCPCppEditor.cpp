@@ -0,0 +1,38 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPCppEditor.h"
+#include "LevelEditor.h"
+#include "Framework/Commands/Commands.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "EditorStyleSet.h"
+
+#define LOCTEXT_NAMESPACE "FMCPCppEditorModule"
+
+void FMCPCppEditorModule::StartupModule()
+{
+    // メニューを登録
+    RegisterMenuExtensions();
+}
+
+void FMCPCppEditorModule::ShutdownModule()
+{
+    // メニューの登録を解除
+    UnregisterMenuExtensions();
+}
+
+void FMCPCppEditorModule::RegisterMenuExtensions()
+{
+    // メニュー拡張の実装
+    FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>("LevelEditor");
+    
+    // ここにメニュー拡張コードを追加
+}
+
+void FMCPCppEditorModule::UnregisterMenuExtensions()
+{
+    // メニュー拡張の解除
+}
+
+#undef LOCTEXT_NAMESPACE
+    
+IMPLEMENT_MODULE(FMCPCppEditorModule, MCPCppEditor)
@@ -0,0 +1,222 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#include "MCPReplayCommandlet.h"
+#include "MCPCommandRecorder.h"
+#include "MCPHttpTransport.h"
+#include "MCPStats.h"
+#include "Containers/Ticker.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    /** 再生結果の集計 */
+    struct FReplayReport
+    {
+        /** キューに入ってから完了するまでの時間 */
+        FMCPLatencyHistogram TotalLatency;
+
+        /** 送信してから応答を受け取るまでの時間 */
+        FMCPLatencyHistogram ServerLatency;
+
+        /** 記録時のキューに入ってから完了するまでの時間 */
+        FMCPLatencyHistogram RecordedLatency;
+
+        /** 完了したリクエスト数 */
+        int32 CompletedCount = 0;
+
+        /** 失敗したリクエスト数 */
+        int32 FailedCount = 0;
+
+        /** 記録時には成功し、再生では失敗したリクエスト数 */
+        int32 RegressedCount = 0;
+
+        /** 再生にかかった時間（秒） */
+        double WallSeconds = 0.0;
+
+        /** 記録の長さ（秒） */
+        double RecordedSeconds = 0.0;
+    };
+
+    /**
+     * 記録したリクエストを1回分送信し、全て完了するまで待つ
+     *
+     * @param Commands 送信するリクエスト（記録を開始してからの時間の順）
+     * @param ServerURL 送信先のサーバーのURL
+     * @param Speed 再生の倍率（0以下で間隔を空けない）
+     * @param Concurrency 同時に処理するリクエスト数の上限
+     * @param Report 結果の集計（追加される）
+     */
+    void RunReplay(const TArray<FMCPRecordedCommand>& Commands, const FString& ServerURL, double Speed, int32 Concurrency, FReplayReport& Report)
+    {
+        // 再生の負荷をそのままサーバーに掛けるため、キューの上限は設けない
+        TSharedRef<FMCPHttpTransport, ESPMode::ThreadSafe> Transport = MakeShared<FMCPHttpTransport, ESPMode::ThreadSafe>();
+        Transport->SetMaxConcurrentRequests(Concurrency);
+        Transport->SetMaxQueuedRequests(0);
+
+        const bool bMaxSpeed = Speed <= 0.0;
+        const double StartTime = FPlatformTime::Seconds();
+        double LastTickTime = StartTime;
+        int32 NextIndex = 0;
+        int32 CompletedCount = 0;
+
+        auto HandleComplete = [&Report, &CompletedCount](const FMCPRecordedCommand& Command, bool bSuccess, const FMCPRequestTiming& Timing)
+        {
+            CompletedCount++;
+            Report.CompletedCount++;
+            Report.TotalLatency.Add(Timing.TotalSeconds);
+            Report.RecordedLatency.Add(Command.TotalMs / 1000.0);
+            if (bSuccess)
+            {
+                Report.ServerLatency.Add(Timing.ServerSeconds);
+            }
+            else
+            {
+                Report.FailedCount++;
+                Report.RegressedCount += Command.bSuccess ? 1 : 0;
+            }
+        };
+
+        while (CompletedCount < Commands.Num())
+        {
+            const double Now = FPlatformTime::Seconds();
+            const double Elapsed = Now - StartTime;
+
+            // 予定の時刻になったリクエストをキューに入れる（送信数の制限はトランスポートが行う）
+            while (NextIndex < Commands.Num() && (bMaxSpeed || Commands[NextIndex].StartSeconds / Speed <= Elapsed))
+            {
+                const FMCPRecordedCommand& Command = Commands[NextIndex++];
+                const FString URL = ServerURL + Command.Path;
+                if (Command.Kind == EMCPRecordedRequestKind::Post)
+                {
+                    Transport->EnqueuePost(URL, Command.Payload,
+                        [&HandleComplete, &Command](bool bSuccess, const TSharedPtr<FJsonObject>& Response, const FMCPRequestTiming& Timing)
+                        {
+                            HandleComplete(Command, bSuccess, Timing);
+                        });
+                }
+                else
+                {
+                    // 状態確認のGETも応答を共有せずに毎回送信するため、バイナリとして受け取る
+                    Transport->EnqueueGetBinary(URL,
+                        [&HandleComplete, &Command](bool bSuccess, TConstArrayView<uint8> Content, const FMCPRequestTiming& Timing)
+                        {
+                            HandleComplete(Command, bSuccess, Timing);
+                        });
+                }
+            }
+
+            // HTTPの完了とゲームスレッドに戻された応答の通知を処理する
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+            FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+            LastTickTime = Now;
+
+            FPlatformProcess::Sleep(0.0005f);
+        }
+
+        Report.WallSeconds += FPlatformTime::Seconds() - StartTime;
+        Report.RecordedSeconds += Commands.Num() > 0 ? Commands.Last().StartSeconds + Commands.Last().TotalMs / 1000.0 : 0.0;
+    }
+
+    /** ヒストグラムの要約をログに出力する */
+    void LogLatency(const TCHAR* Label, const FMCPLatencyHistogram& Histogram)
+    {
+        if (Histogram.Count == 0)
+        {
+            UE_LOG(LogTemp, Display, TEXT("  %s: 記録なし"), Label);
+            return;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("  %s: 平均 %.2fms / p50 %.0fms / p95 %.0fms / p99 %.0fms / 最大 %.2fms"),
+               Label, Histogram.TotalSeconds * 1000.0 / Histogram.Count,
+               Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.95), Histogram.GetPercentileMs(0.99),
+               Histogram.MaxSeconds * 1000.0);
+    }
+}
+
+UMCPReplayCommandlet::UMCPReplayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UMCPReplayCommandlet::Main(const FString& Params)
+{
+    FString LogPath;
+    if (!FParse::Value(*Params, TEXT("Log="), LogPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("再生する記録ファイルを -Log=<パス> で指定してください"));
+        return 1;
+    }
+
+    FString RecordedServerURL;
+    TArray<FMCPRecordedCommand> Commands;
+    if (!FMCPCommandRecorder::LoadLog(LogPath, RecordedServerURL, Commands))
+    {
+        return 1;
+    }
+    if (Commands.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("記録ファイルにリクエストがありません: %s"), *LogPath);
+        return 0;
+    }
+
+    // 記録は完了した順のため、キューに入った順に並べ直す
+    Commands.StableSort([](const FMCPRecordedCommand& A, const FMCPRecordedCommand& B)
+    {
+        return A.StartSeconds < B.StartSeconds;
+    });
+
+    double Speed = 1.0;
+    FString SpeedValue;
+    if (FParse::Value(*Params, TEXT("Speed="), SpeedValue))
+    {
+        Speed = SpeedValue.Equals(TEXT("max"), ESearchCase::IgnoreCase) ? 0.0 : FCString::Atod(*SpeedValue);
+    }
+
+    int32 Concurrency = 4;
+    FParse::Value(*Params, TEXT("Concurrency="), Concurrency);
+    Concurrency = FMath::Max(Concurrency, 1);
+
+    int32 Loops = 1;
+    FParse::Value(*Params, TEXT("Loops="), Loops);
+    Loops = FMath::Max(Loops, 1);
+
+    FString ServerURL = RecordedServerURL;
+    FParse::Value(*Params, TEXT("Server="), ServerURL);
+    ServerURL.RemoveFromEnd(TEXT("/"));
+
+    UE_LOG(LogTemp, Display, TEXT("MCPコマンドを再生します: %s (%d 件 x %d 回) -> %s / 速度 %s / 同時 %d 件"),
+           *LogPath, Commands.Num(), Loops, *ServerURL,
+           Speed > 0.0 ? *FString::Printf(TEXT("%.2fx"), Speed) : TEXT("最大"), Concurrency);
+
+    FReplayReport Report;
+    for (int32 Loop = 0; Loop < Loops; ++Loop)
+    {
+        RunReplay(Commands, ServerURL, Speed, Concurrency, Report);
+    }
+
+    const double ErrorRate = Report.CompletedCount > 0 ? static_cast<double>(Report.FailedCount) / Report.CompletedCount : 0.0;
+    UE_LOG(LogTemp, Display, TEXT("再生結果: %d 件 / %.2f 秒 / %.1f 件/秒（記録時 %.1f 件/秒）"),
+           Report.CompletedCount, Report.WallSeconds,
+           Report.WallSeconds > 0.0 ? Report.CompletedCount / Report.WallSeconds : 0.0,
+           Report.RecordedSeconds > 0.0 ? Report.CompletedCount / Report.RecordedSeconds : 0.0);
+
+    // キュー待ちを含む所要時間がサーバーの応答時間より大きく伸びる場合は、同時リクエスト数の上限で詰まっている
+    LogLatency(TEXT("所要時間（キュー待ちを含む）"), Report.TotalLatency);
+    LogLatency(TEXT("サーバーの応答時間（成功のみ）"), Report.ServerLatency);
+    LogLatency(TEXT("記録時の所要時間"), Report.RecordedLatency);
+    UE_LOG(LogTemp, Display, TEXT("  エラー: %d 件 (%.2f%%) / うち記録時は成功 %d 件"),
+           Report.FailedCount, ErrorRate * 100.0, Report.RegressedCount);
+
+    double MaxErrorRate = 1.0;
+    if (FParse::Value(*Params, TEXT("MaxErrorRate="), MaxErrorRate) && ErrorRate > MaxErrorRate)
+    {
+        UE_LOG(LogTemp, Error, TEXT("エラー率が上限を超えました: %.2f%% > %.2f%%"), ErrorRate * 100.0, MaxErrorRate * 100.0);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,27 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * MCPエディタモジュール
+ * 
+ * エディタでのみ読み込まれ、レベルエディタのメニューなどのエディタ機能を提供します。
+ * エディタのモジュールへの依存はこのモジュールにまとめ、ランタイムの MCPCpp モジュールには持たせません。
+ */
+class FMCPCppEditorModule : public IModuleInterface
+{
+public:
+    /** IModuleInterface の実装 */
+    virtual void StartupModule() override;
+    virtual void ShutdownModule() override;
+
+private:
+    /** メニュー拡張を登録 */
+    void RegisterMenuExtensions();
+    
+    /** メニュー拡張を解除 */
+    void UnregisterMenuExtensions();
+};
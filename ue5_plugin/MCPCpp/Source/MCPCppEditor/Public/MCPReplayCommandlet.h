@@ -0,0 +1,33 @@
+// Copyright MCP Framework. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MCPReplayCommandlet.generated.h"
+
+/**
+ * MCPコマンドの再生コマンドレット
+ *
+ * FMCPClient::StartRecording（または "-MCPRecord="）で記録したログを、
+ * ゲームやエディタを動かさずにMCPサーバーへ送り直し、スループット・遅延・エラー率を出力します。
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=MCPReplay -Log=<ログファイル>
+ *     [-Speed=<倍率|max>] [-Concurrency=<同時リクエスト数>] [-Server=<URL>] [-Loops=<回数>] [-MaxErrorRate=<0〜1>]
+ *
+ * -Speed=1 は記録時と同じ間隔、-Speed=4 は4倍の頻度、-Speed=max は間隔を空けずに全て送信します。
+ * -Server を省略した場合は記録時のサーバーに送信します。
+ * -MaxErrorRate を指定すると、エラー率がそれを超えた場合に終了コード1を返します。
+ */
+UCLASS()
+class UMCPReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    /** コンストラクタ */
+    UMCPReplayCommandlet();
+
+    /** UCommandletの実装 */
+    virtual int32 Main(const FString& Params) override;
+};